@@ -24,3 +24,4 @@
 
 #import "HKDispatchQueue.h"
 #import "HKDispatchSemaphore.h"
+#import "HKModel+Async.h"
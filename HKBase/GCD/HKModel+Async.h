@@ -0,0 +1,97 @@
+//
+//  HKModel+Async.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModel.h"
+#import "HKArray.h"
+#import "HKDispatchQueue.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ completion of asynchronous decoding
+
+ @param model decoded model (nil if failed or cancelled)
+ @param error error (NSUserCancelledError in NSCocoaErrorDomain if cancelled, nil if serialized object is not matched)
+ */
+typedef void (^HKModelDecodeCompletion)(id _Nullable model, NSError * _Nullable error);
+
+/**
+ decode model on dispatch queue
+ returned progress is token of decoding, cancel progress to stop decoding (completion is called with cancelled error)
+ HKModelDecodeContext of caller is used on queue
+ */
+@interface HKModel (Async)
+
+/**
+ decode serialized object asynchronously
+
+ @param serializedObject serialized object (ex. JSON object)
+ @param queue queue for decoding
+ @param completionQueue queue for completion (nil is main queue)
+ @param completion completion
+ @return progress of decoding
+ */
++ (NSProgress *)decodeAsync:(id)serializedObject onQueue:(HKDispatchQueue *)queue completionQueue:(nullable HKDispatchQueue *)completionQueue completion:(HKModelDecodeCompletion)completion;
+/**
+ decode JSON data asynchronously (progress is updated by read bytes)
+
+ @param data JSON data (UTF-8)
+ @param queue queue for decoding
+ @param completionQueue queue for completion (nil is main queue)
+ @param completion completion (error is in HKJSONErrorDomain if JSON is invalid)
+ @return progress of decoding
+ */
++ (NSProgress *)decodeJSONDataAsync:(NSData *)data onQueue:(HKDispatchQueue *)queue completionQueue:(nullable HKDispatchQueue *)completionQueue completion:(HKModelDecodeCompletion)completion;
+
+@end
+
+/**
+ decode model array on dispatch queue
+ */
+@interface HKArray<ObjectType> (Async)
+
+/**
+ decode serialized array asynchronously (progress is updated by decoded elements)
+
+ @param serializedObject serialized array (ex. JSON array)
+ @param queue queue for decoding
+ @param completionQueue queue for completion (nil is main queue)
+ @param completion completion
+ @return progress of decoding
+ */
++ (NSProgress *)decodeAsync:(id)serializedObject onQueue:(HKDispatchQueue *)queue completionQueue:(nullable HKDispatchQueue *)completionQueue completion:(HKModelDecodeCompletion)completion;
+/**
+ decode JSON data asynchronously (progress is updated by read bytes)
+
+ @param data JSON data (UTF-8)
+ @param queue queue for decoding
+ @param completionQueue queue for completion (nil is main queue)
+ @param completion completion (error is in HKJSONErrorDomain if JSON is invalid)
+ @return progress of decoding
+ */
++ (NSProgress *)decodeJSONDataAsync:(NSData *)data onQueue:(HKDispatchQueue *)queue completionQueue:(nullable HKDispatchQueue *)completionQueue completion:(HKModelDecodeCompletion)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
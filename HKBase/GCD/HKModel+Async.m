@@ -0,0 +1,123 @@
+//
+//  HKModel+Async.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModel+Async.h"
+#import "HKModel+JSON.h"
+#import "HKModelDecodeContext.h"
+
+static const NSUInteger kHKModelDecodeChunkCount = 1024;    // minimum elements decoded between cancellation checks
+
+/**
+ perform decode on queue and call completion on completion queue
+ decode is not performed if progress is cancelled before it starts
+ */
+static NSProgress *HKModelDecodeAsync(int64_t totalUnitCount, HKDispatchQueue *queue, HKDispatchQueue *completionQueue, id (^decode)(NSProgress *progress, NSError **error), HKModelDecodeCompletion completion) {
+    NSProgress *progress = [NSProgress discreteProgressWithTotalUnitCount:totalUnitCount];
+    HKModelDecodeContext *context = HKModelDecodeContext.currentContext;
+    completionQueue = completionQueue ?: HKDispatchQueue.mainQueue;
+    
+    [queue performAsync:^{
+        __block id result = nil;
+        __block NSError *error = nil;
+        if (!progress.isCancelled) {
+            @autoreleasepool {
+                void (^block)(void) = ^{
+                    NSError *decodeError = nil;
+                    result = decode(progress, &decodeError);
+                    error = decodeError;
+                };
+                context ? [context performBlock:block] : block();
+            }
+        }
+        if (progress.isCancelled) {
+            result = nil;
+            error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSUserCancelledError userInfo:nil];
+        } else if (result) {
+            progress.completedUnitCount = totalUnitCount;
+        }
+        [completionQueue performAsync:^{
+            completion(result, error);
+        }];
+    }];
+    
+    return progress;
+}
+
+static NSProgress *HKModelDecodeJSONDataAsync(Class class, NSData *data, HKDispatchQueue *queue, HKDispatchQueue *completionQueue, HKModelDecodeCompletion completion) {
+    int64_t length = (int64_t)data.length;
+    return HKModelDecodeAsync(length, queue, completionQueue, ^id(NSProgress *progress, NSError **error) {
+        // JSON reader reports to current progress
+        [progress becomeCurrentWithPendingUnitCount:length];
+        id result = [class modelWithJSONData:data error:error];
+        [progress resignCurrent];
+        return result;
+    }, completion);
+}
+
+@implementation HKModel (Async)
+
++ (NSProgress *)decodeAsync:(id)serializedObject onQueue:(HKDispatchQueue *)queue completionQueue:(HKDispatchQueue *)completionQueue completion:(HKModelDecodeCompletion)completion {
+    return HKModelDecodeAsync(1, queue, completionQueue, ^id(NSProgress *progress, NSError **error) {
+        return [self modelWithSerializedObject:serializedObject];
+    }, completion);
+}
+
++ (NSProgress *)decodeJSONDataAsync:(NSData *)data onQueue:(HKDispatchQueue *)queue completionQueue:(HKDispatchQueue *)completionQueue completion:(HKModelDecodeCompletion)completion {
+    return HKModelDecodeJSONDataAsync(self, data, queue, completionQueue, completion);
+}
+
+@end
+
+@implementation HKArray (Async)
+
++ (NSProgress *)decodeAsync:(id)serializedObject onQueue:(HKDispatchQueue *)queue completionQueue:(HKDispatchQueue *)completionQueue completion:(HKModelDecodeCompletion)completion {
+    NSArray *objects = [serializedObject isKindOfClass:NSArray.class] ? serializedObject : nil;
+    NSUInteger count = objects.count;
+    return HKModelDecodeAsync((int64_t)count, queue, completionQueue, ^id(NSProgress *progress, NSError **error) {
+        if (!objects) {
+            return nil;
+        }
+        
+        // decode in chunks (concurrently if chunk is large) and check cancellation between chunks
+        NSUInteger chunkCount = MAX(self.concurrentThreshold, kHKModelDecodeChunkCount);
+        NSMutableArray *result = [self arrayWithCapacity:count];
+        for (NSUInteger location = 0; location < count; location += chunkCount) {
+            if (progress.isCancelled) {
+                return nil;
+            }
+            NSRange range = NSMakeRange(location, MIN(chunkCount, count - location));
+            @autoreleasepool {
+                NSArray *chunk = [self modelWithSerializedObject:[objects subarrayWithRange:range]];
+                chunk ? [result addObjectsFromArray:chunk] : nil;
+            }
+            progress.completedUnitCount = (int64_t)NSMaxRange(range);
+        }
+        return result;
+    }, completion);
+}
+
++ (NSProgress *)decodeJSONDataAsync:(NSData *)data onQueue:(HKDispatchQueue *)queue completionQueue:(HKDispatchQueue *)completionQueue completion:(HKModelDecodeCompletion)completion {
+    return HKModelDecodeJSONDataAsync(self, data, queue, completionQueue, completion);
+}
+
+@end
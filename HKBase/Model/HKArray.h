@@ -38,6 +38,12 @@ NS_ASSUME_NONNULL_BEGIN
  Class of ObjectType
  */
 @property (class, nonatomic, unsafe_unretained, readonly) Class objectClass;
+/**
+ element count to decode and encode concurrently (default : 0, disabled)
+ elements are split into chunks across cores, order is preserved and nil is dropped
+ modelWithSerializedObject: and serializedObject of elements (including overrides) are called on other threads, so they should be thread safe
+ */
+@property (class, nonatomic, assign) NSUInteger concurrentThreshold;
 
 @end
 
@@ -23,6 +23,9 @@
 
 #import "HKArray.h"
 #import "HKModel.h"
+#import "HKModelPlan.h"
+
+static NSUInteger HKArrayConcurrentThreshold = 0;
 
 @implementation HKArray
 
@@ -31,6 +34,15 @@
     return NSObject.class;
 }
 
+@dynamic concurrentThreshold;
++ (NSUInteger)concurrentThreshold {
+    return HKArrayConcurrentThreshold;
+}
+
++ (void)setConcurrentThreshold:(NSUInteger)concurrentThreshold {
+    HKArrayConcurrentThreshold = concurrentThreshold;
+}
+
 + (instancetype)allocWithZone:(struct _NSZone *)zone {
     return (HKArray *)[NSMutableArray allocWithZone:zone];
 }
@@ -42,9 +54,16 @@
         result = [self arrayWithCapacity:((NSArray *)serializedObject).count];
         Class objectClass = self.objectClass;
         BOOL isModel = [objectClass conformsToProtocol:@protocol(HKModel)];
-        for (id value in serializedObject) {
-            id object = isModel ? [objectClass modelWithSerializedObject:value] : value;
-            object ? [result addObject:object] : nil;
+        NSUInteger threshold = self.concurrentThreshold;
+        if (isModel && threshold && ((NSArray *)serializedObject).count >= threshold) {
+            HKModelTransformObjectsConcurrently(serializedObject, result, ^id(id value) {
+                return [objectClass modelWithSerializedObject:value];
+            });
+        } else {
+            for (id value in serializedObject) {
+                id object = isModel ? [objectClass modelWithSerializedObject:value] : value;
+                object ? [result addObject:object] : nil;
+            }
         }
     }
     
@@ -23,6 +23,7 @@
 
 #import <Foundation/Foundation.h>
 #import "HKModel.h"
+#import "HKMacro.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -55,11 +56,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  Enum Object Storage
- Do not use it immediacy
+ Do not use it directly
  */
 @property (class, nonatomic, readonly) __kindof HKEnumStorage *currentStorage;
 /**
  All Enum Objects
+ canonical enums are materialized once in registration, copy returns same object and equal enums are same object
  */
 @property (class, nonatomic, readonly) NSArray<__kindof HKEnum *> *allEnums;
 /**
@@ -92,6 +94,10 @@ NS_ASSUME_NONNULL_BEGIN
  string value of Enum
  */
 @property (nonatomic, readonly) NSString *stringValue;
+/**
+ index of Enum in allEnums (order of declaration)
+ */
+@property (nonatomic, readonly) NSUInteger ordinal;
 
 /**
  compare other Enum
@@ -121,6 +127,8 @@ NS_ASSUME_NONNULL_BEGIN
     ^id { return UIColor.redColor; },
     nil];
 
+ switch executed repeatedly (ex. per record) should use HKEnumSwitch
+ 
  @param defaultHandler block for excution at default: in switch(...) { ... }
  @return result of current switch block;
  */
@@ -132,16 +140,27 @@ NS_ASSUME_NONNULL_BEGIN
  @required
  Enum Values Declare using category
  before using this func. declare "@interface classname : HKEnum @end" first
+ C enum of ordinals is declared too (classNameCase), switch of enumCase warns missing cases at build time (-Wswitch)
+ usage example>
+ switch (brand.enumCase) {
+     case HKBrandCaseVisa: ...
+     case HKBrandCaseMaster: ...
+ }
 
  @param className Enum class name
  @param ... Enum Value Names
  */
 #define HKEnumDeclare(className, ...) \
 \
+HK_MACRO_ASSERT_COUNT(__VA_ARGS__) \
 @class className; \
 typedef className *className ## Ptr; \
+typedef NS_ENUM(NSUInteger, className ## Case) { \
+    HK_MACRO_FOR_EACH(HKEnumCaseConstant, className, __VA_ARGS__) \
+}; \
 @interface className (className ## Property) \
 @property (class, nonatomic, nonnull, readonly) className ## Ptr __VA_ARGS__; \
+@property (nonatomic, readonly) className ## Case enumCase; \
 @end
 
 /**
@@ -158,9 +177,14 @@ typedef className *className ## Ptr; \
 @end \
 \
 @implementation className (className ## Property) \
-@dynamic __VA_ARGS__; \
-+ (void)load { \
-    [self.currentStorage registerEnumArguments:@#__VA_ARGS__]; \
+HK_MACRO_FOR_EACH(HKEnumAccessorImplementation, className, __VA_ARGS__) \
+- (className ## Case)enumCase { \
+    return (className ## Case)self.ordinal; \
+} \
++ (const char *const *)HK_enumNamesWithCount:(NSUInteger *)count { \
+    static const char *const names[] = { HK_MACRO_FOR_EACH(HKEnumNameString, className, __VA_ARGS__) }; \
+    *count = sizeof(names) / sizeof(names[0]); \
+    return names; \
 } \
 + (__kindof HKEnumStorage *)currentStorage { \
     static className ## EnumStorage *currentStorage = nil; \
@@ -190,14 +214,9 @@ typedef className *className ## Ptr; \
 #define HKEnumRegisterValues(className, ...) \
 \
 @implementation className (className ## Values) \
-+ (void)load { \
-    const NSInteger arguments[] = { __VA_ARGS__ }; \
-    const NSInteger numberOfArguments = sizeof(arguments) / sizeof(arguments[0]); \
-    NSMutableArray<NSNumber *> *values = [NSMutableArray arrayWithCapacity:numberOfArguments]; \
-    for (NSInteger index = 0; index < numberOfArguments; index++) { \
-        [values addObject:@(arguments[index])]; \
-    } \
-    [self.currentStorage registerValues:values]; \
++ (void)HK_enumValuesUsingBlock:(void (NS_NOESCAPE ^)(const NSInteger *values, NSUInteger count))block { \
+    const NSInteger values[] = { __VA_ARGS__ }; \
+    block(values, sizeof(values) / sizeof(values[0])); \
 } \
 @end
 
@@ -213,8 +232,8 @@ typedef className *className ## Ptr; \
 #define HKEnumRegisterStringValues(className, ...) \
 \
 @implementation className (className ## StringValues) \
-+ (void)load { \
-    [self.currentStorage registerStringValues:@[__VA_ARGS__]]; \
++ (NSArray<NSString *> *)HK_enumStringValues { \
+    return @[__VA_ARGS__]; \
 } \
 @end
 
@@ -230,11 +249,46 @@ typedef className *className ## Ptr; \
 #define HKEnumRegisterProperties(className, property, ...) \
 \
 @implementation className (className ## property ## Properties) \
-+ (void)load { \
-    [self.currentStorage registerObject:@[__VA_ARGS__] propertyName:@#property]; \
++ (NSArray *)HK_enumObjectsOfProperty_ ## property { \
+    return @[__VA_ARGS__]; \
 } \
 @end
 
+/**
+ class property of Enum in HKEnumImplementation(...)
+ Do not use it directly
+ */
+#define HKEnumAccessorImplementation(className, index, name) \
++ (className *)name { \
+    return [self.currentStorage enumAtIndex:index]; \
+}
+
+/**
+ constant of C enum in HKEnumDeclare(...)
+ Do not use it directly
+ */
+#define HKEnumCaseConstant(className, index, name) className ## Case ## name = index,
+
+/**
+ name of Enum in HKEnumImplementation(...)
+ Do not use it directly
+ */
+#define HKEnumNameString(className, index, name) #name,
+
+/**
+ static tables of Enum class generated by HKEnumImplementation(...) and HKEnumRegister...(...)
+ storage reads them on first use (no +load)
+ Do not use it directly
+ */
+@protocol HKEnumStaticTable
+
+@optional
++ (const char *_Nonnull const *_Nonnull)HK_enumNamesWithCount:(NSUInteger *)count;
++ (void)HK_enumValuesUsingBlock:(void (NS_NOESCAPE ^)(const NSInteger *values, NSUInteger count))block;
++ (NSArray<NSString *> *)HK_enumStringValues;
+
+@end
+
 @interface HKEnum (Unavailable)
 
 - (instancetype)init NS_UNAVAILABLE;
@@ -243,7 +297,7 @@ typedef className *className ## Ptr; \
 
 /**
  Enum Storage
- Do not use it immediacy
+ Do not use it directly
  */
 @interface HKEnumStorage : NSObject
 
@@ -257,6 +311,7 @@ typedef className *className ## Ptr; \
 - (void)registerStringValues:(NSArray<NSString *> *)stringValues;
 - (void)registerObject:(NSArray<id> *)objects propertyName:(NSString *)propertyName;
 
+- (__kindof HKEnum *)enumAtIndex:(NSUInteger)index;
 - (nullable __kindof HKEnum *)enumForKey:(NSString *)key;
 - (nullable __kindof HKEnum *)enumForValue:(NSInteger)value;
 - (nullable __kindof HKEnum *)enumForStringValue:(NSString *)stringValue;
@@ -26,28 +26,65 @@
 #import "HKProperty.h"
 #import "HKMethod.h"
 
+#import <objc/runtime.h>
+
+static const NSUInteger kHKEnumHashMultiplier = (NSUInteger)0x9E3779B97F4A7C15ULL;
+static NSString *const kHKEnumPropertyObjectsPrefix = @"HK_enumObjectsOfProperty_";     // + HK_enumObjectsOfProperty_<name> of HKEnumRegisterProperties(...)
+
 @interface HKEnum () {
     @package
     NSInteger _value;
     NSString *_stringValue;
+    NSUInteger _hash;       // class seed ^ value (precomputed in registration)
+    NSUInteger _ordinal;
 }
 
-+ (void)HK_initializeClassPropertyWithName:(NSString *)name;
-- (void)HK_initializeByBase:(__kindof HKEnum *)base;
++ (void)HK_initializeClassPropertyWithName:(NSString *)name enum:(__kindof HKEnum *)enumObject;
 - (id(^)(void))HK_findSwitchAction:(va_list)args;
 
 @end
 
+/**
+ index of enum by value
+ dense table indexed by (value - minimum) if values are compact, open addressing (linear probing) otherwise
+ */
+typedef struct _HKEnumValueTable {
+    NSInteger *indexes;         // dense: by value - minimum, sparse: by slot (NSNotFound if empty)
+    NSInteger *values;          // sparse: value by slot (NULL if dense)
+    NSInteger minimum;
+    NSUInteger length;          // dense: range of values, sparse: number of slots (power of 2)
+} HKEnumValueTable;
+
+/**
+ index of enum by string value
+ perfect hash (displacement seed by bucket) compares one string, linear probing if hashes are not separable
+ */
+typedef struct _HKEnumStringTable {
+    __unsafe_unretained NSString **strings;     // by slot (nil if empty), owned by storage
+    NSInteger *indexes;                         // by slot
+    uint32_t *seeds;                            // by bucket (NULL if linear probing)
+    NSUInteger slotMask;
+    NSUInteger bucketMask;
+} HKEnumStringTable;
+
 @interface HKEnumStorage () {
-    NSMutableDictionary<NSString *, __kindof HKEnum *> *_allEnums;
+    NSArray<__kindof HKEnum *> *_allEnums;             // canonical enums by index (immutable after registration)
+    NSUInteger _classSeed;                              // hash of class name
+    NSDictionary<NSString *, NSNumber *> *_indexes;     // index by key
     
     NSArray<NSString *> *_allKeys;
     NSArray<NSNumber *> *_allValues;
     NSArray<NSString *> *_allStringValues;
     NSMutableDictionary<NSString *, NSArray<id> *> *_allProperties;
+    
+    HKEnumValueTable _valueTable;
+    HKEnumStringTable _stringTable;
 }
 
-- (__kindof HKEnum *)HK_makeEnumForKey:(NSString *)key;
+- (void)HK_registerStaticTables;
+- (void)HK_materializeEnums;
+- (void)HK_updateEnums;
+- (void)HK_buildLookupTables;
 
 @end
 
@@ -90,24 +127,21 @@
     return [self.currentStorage enumForStringValue:stringValue];
 }
 
-+ (void)HK_initializeClassPropertyWithName:(NSString *)name {
+// class property returns canonical enum without lookup
++ (void)HK_initializeClassPropertyWithName:(NSString *)name enum:(__kindof HKEnum *)enumObject {
     SEL selector = NSSelectorFromString(name);
     HKMethod *method = [HKMethod methodWithSelector:selector block:^id(Class self) {
-        return [self.currentStorage enumForKey:name];
+        return enumObject;
     }];
     [self replaceClassMethod:method];
 }
 
 #pragma mark - NSSecureCoding
 
+// decoded enum is replaced with canonical enum
 - (instancetype)initWithCoder:(NSCoder *)decoder {
-    self = [super init];
-    if (self) {
-        NSInteger value = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(value))];
-        __kindof HKEnum *base = [self.class.currentStorage enumForValue:value];
-        [self HK_initializeByBase:base];
-    }
-    return self;
+    NSInteger value = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(value))];
+    return [self.class.currentStorage enumForValue:value];
 }
 
 - (void)encodeWithCoder:(NSCoder *)coder {
@@ -121,28 +155,26 @@
 
 #pragma mark - NSCopying
 
+// enum is canonical and immutable
 - (instancetype)copyWithZone:(NSZone *)zone {
-    HKEnum *result = [[self.class alloc] init];
-    result->_value = _value;
-    result->_stringValue = _stringValue;
-    [result HK_initializeByBase:self];
-    return result;
+    return self;
 }
 
 #pragma mark - properties
 
 - (NSUInteger)hash {
-    return NSStringFromClass(self.class).hash + _value;
+    return _hash;
 }
 
 - (BOOL)isEqual:(__kindof HKEnum *)object {
-    return self.hash == object.hash;
+    return self == object;
 }
 
 #pragma mark - public methods
 
 - (NSComparisonResult)compare:(__kindof HKEnum *)other {
-    return [@(_value) compare:@(other.value)];
+    NSInteger otherValue = other ? ((HKEnum *)other)->_value : 0;
+    return _value < otherValue ? NSOrderedAscending : (_value > otherValue ? NSOrderedDescending : NSOrderedSame);
 }
 
 - (nullable id)switchWithDefaultHandler:(id (^)(void))defaultHandler, ... {
@@ -159,17 +191,6 @@
 
 #pragma mark - private methods
 
-- (void)HK_initializeByBase:(__kindof HKEnum *)base {
-    Class class = self.class;
-    do {
-        for (HKProperty *property in class.properties) {
-            if (!property.dynamic && !property.readOnly) {
-                [self setObject:[self objectForProperty:property] forProperty:property];
-            }
-        }
-    } while ([(class = class.superclass) isSubclassOfClass:HKEnum.class]);
-}
-
 - (id(^)(void))HK_findSwitchAction:(va_list)args {
     id result = nil;
     
@@ -208,23 +229,280 @@ static NSArray<NSString *> *HKGetComponents(NSString *string) {
     return result;
 }
 
+#pragma mark - lookup tables
+static const NSUInteger kHKEnumDenseValueMargin = 64;      // unused entries allowed in dense table (+ 1 per value)
+static const uint32_t kHKEnumMaximumSeed = 1024;
+
+static inline uint64_t HKEnumMix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+static void HKEnumValueTableFree(HKEnumValueTable *table) {
+    free(table->indexes);
+    free(table->values);
+    memset(table, 0, sizeof(HKEnumValueTable));
+}
+
+static void HKEnumValueTableBuild(HKEnumValueTable *table, const NSInteger *values, NSUInteger count) {
+    HKEnumValueTableFree(table);
+    if (count == 0) {
+        return;
+    }
+    
+    NSInteger minimum = values[0];
+    NSInteger maximum = values[0];
+    for (NSUInteger index = 1; index < count; index++) {
+        minimum = MIN(minimum, values[index]);
+        maximum = MAX(maximum, values[index]);
+    }
+    
+    // first index wins for duplicated value (same as indexOfObject:)
+    NSUInteger range = (NSUInteger)maximum - (NSUInteger)minimum;
+    if (range < count * 2 + kHKEnumDenseValueMargin) {
+        table->length = range + 1;
+        table->minimum = minimum;
+        table->indexes = malloc(table->length * sizeof(NSInteger));
+        for (NSUInteger offset = 0; offset < table->length; offset++) {
+            table->indexes[offset] = NSNotFound;
+        }
+        for (NSUInteger index = count; index > 0; index--) {
+            table->indexes[(NSUInteger)values[index - 1] - (NSUInteger)minimum] = (NSInteger)(index - 1);
+        }
+        return;
+    }
+    
+    table->length = 8;
+    while (table->length < count * 2) {
+        table->length <<= 1;
+    }
+    table->indexes = malloc(table->length * sizeof(NSInteger));
+    table->values = malloc(table->length * sizeof(NSInteger));
+    for (NSUInteger slot = 0; slot < table->length; slot++) {
+        table->indexes[slot] = NSNotFound;
+    }
+    for (NSUInteger index = 0; index < count; index++) {
+        NSUInteger slot = (NSUInteger)HKEnumMix((uint64_t)values[index]) & (table->length - 1);
+        while (table->indexes[slot] != NSNotFound && table->values[slot] != values[index]) {
+            slot = (slot + 1) & (table->length - 1);
+        }
+        if (table->indexes[slot] == NSNotFound) {
+            table->indexes[slot] = (NSInteger)index;
+            table->values[slot] = values[index];
+        }
+    }
+}
+
+static inline NSInteger HKEnumValueTableIndex(const HKEnumValueTable *table, NSInteger value) {
+    if (!table->values) {
+        NSUInteger offset = (NSUInteger)value - (NSUInteger)table->minimum;
+        return offset < table->length ? table->indexes[offset] : NSNotFound;
+    }
+    
+    NSUInteger mask = table->length - 1;
+    for (NSUInteger slot = (NSUInteger)HKEnumMix((uint64_t)value) & mask; table->indexes[slot] != NSNotFound; slot = (slot + 1) & mask) {
+        if (table->values[slot] == value) {
+            return table->indexes[slot];
+        }
+    }
+    return NSNotFound;
+}
+
+static inline NSUInteger HKEnumStringBucket(uint64_t hash, NSUInteger mask) {
+    return (NSUInteger)(HKEnumMix(hash) >> 32) & mask;
+}
+
+static inline NSUInteger HKEnumStringSlot(uint64_t hash, uint32_t seed, NSUInteger mask) {
+    return (NSUInteger)HKEnumMix(hash ^ ((uint64_t)seed * 0x9E3779B97F4A7C15ULL)) & mask;
+}
+
+static void HKEnumStringTableFree(HKEnumStringTable *table) {
+    free(table->strings);
+    free(table->indexes);
+    free(table->seeds);
+    memset(table, 0, sizeof(HKEnumStringTable));
+}
+
+/**
+ place keys of each bucket (larger bucket first) by first seed giving free and distinct slots
+ */
+static BOOL HKEnumStringTablePlace(HKEnumStringTable *table, NSArray<NSString *> *strings, const NSInteger *indexes, const uint64_t *hashes, NSUInteger count) {
+    NSUInteger numberOfBuckets = table->bucketMask + 1;
+    NSUInteger *bucketStarts = calloc(numberOfBuckets + 1, sizeof(NSUInteger));
+    NSUInteger *order = malloc(MAX(count, 1) * sizeof(NSUInteger));     // keys sorted by bucket
+    NSUInteger *slots = malloc(MAX(count, 1) * sizeof(NSUInteger));
+    NSUInteger maximumSize = 0;
+    
+    for (NSUInteger key = 0; key < count; key++) {
+        bucketStarts[HKEnumStringBucket(hashes[key], table->bucketMask) + 1]++;
+    }
+    for (NSUInteger bucket = 0; bucket < numberOfBuckets; bucket++) {
+        maximumSize = MAX(maximumSize, bucketStarts[bucket + 1]);
+        bucketStarts[bucket + 1] += bucketStarts[bucket];
+    }
+    NSUInteger *cursors = malloc(numberOfBuckets * sizeof(NSUInteger));
+    memcpy(cursors, bucketStarts, numberOfBuckets * sizeof(NSUInteger));
+    for (NSUInteger key = 0; key < count; key++) {
+        order[cursors[HKEnumStringBucket(hashes[key], table->bucketMask)]++] = key;
+    }
+    free(cursors);
+    
+    BOOL result = YES;
+    for (NSUInteger size = maximumSize; size > 0 && result; size--) {
+        for (NSUInteger bucket = 0; bucket < numberOfBuckets && result; bucket++) {
+            NSUInteger start = bucketStarts[bucket];
+            if (bucketStarts[bucket + 1] - start != size) {
+                continue;
+            }
+            
+            uint32_t seed = 0;
+            for (; seed < kHKEnumMaximumSeed; seed++) {
+                BOOL isPlaced = YES;
+                for (NSUInteger offset = 0; offset < size && isPlaced; offset++) {
+                    slots[offset] = HKEnumStringSlot(hashes[order[start + offset]], seed, table->slotMask);
+                    isPlaced = table->strings[slots[offset]] == nil;
+                    for (NSUInteger other = 0; other < offset && isPlaced; other++) {
+                        isPlaced = slots[other] != slots[offset];
+                    }
+                }
+                if (isPlaced) {
+                    break;
+                }
+            }
+            if (seed == kHKEnumMaximumSeed) {
+                result = NO;
+                break;
+            }
+            
+            table->seeds[bucket] = seed;
+            for (NSUInteger offset = 0; offset < size; offset++) {
+                NSUInteger key = order[start + offset];
+                table->strings[slots[offset]] = strings[(NSUInteger)indexes[key]];
+                table->indexes[slots[offset]] = indexes[key];
+            }
+        }
+    }
+    
+    free(bucketStarts);
+    free(order);
+    free(slots);
+    return result;
+}
+
+static void HKEnumStringTableBuild(HKEnumStringTable *table, NSArray<NSString *> *strings, NSUInteger count) {
+    HKEnumStringTableFree(table);
+    
+    // first index wins for duplicated string (same as indexOfObject:)
+    NSMutableSet<NSString *> *uniqueStrings = [NSMutableSet setWithCapacity:count];
+    NSInteger *indexes = malloc(MAX(count, 1) * sizeof(NSInteger));
+    uint64_t *hashes = malloc(MAX(count, 1) * sizeof(uint64_t));
+    NSUInteger numberOfKeys = 0;
+    for (NSUInteger index = 0; index < count; index++) {
+        NSString *string = strings[index];
+        if (![uniqueStrings containsObject:string]) {
+            [uniqueStrings addObject:string];
+            indexes[numberOfKeys] = (NSInteger)index;
+            hashes[numberOfKeys] = (uint64_t)string.hash;
+            numberOfKeys++;
+        }
+    }
+    
+    NSUInteger numberOfSlots = 8;
+    while (numberOfSlots < numberOfKeys * 2) {
+        numberOfSlots <<= 1;
+    }
+    NSUInteger numberOfBuckets = 1;
+    while (numberOfBuckets * 4 < numberOfKeys) {
+        numberOfBuckets <<= 1;
+    }
+    table->strings = (__unsafe_unretained NSString **)calloc(numberOfSlots, sizeof(NSString *));
+    table->indexes = calloc(numberOfSlots, sizeof(NSInteger));
+    table->seeds = calloc(numberOfBuckets, sizeof(uint32_t));
+    table->slotMask = numberOfSlots - 1;
+    table->bucketMask = numberOfBuckets - 1;
+    
+    if (!HKEnumStringTablePlace(table, strings, indexes, hashes, numberOfKeys)) {
+        // same hashes of different strings (ex. long strings) can not be separated by seed
+        free(table->seeds);
+        table->seeds = NULL;
+        memset(table->strings, 0, numberOfSlots * sizeof(NSString *));
+        for (NSUInteger key = 0; key < numberOfKeys; key++) {
+            NSUInteger slot = (NSUInteger)HKEnumMix(hashes[key]) & table->slotMask;
+            while (table->strings[slot]) {
+                slot = (slot + 1) & table->slotMask;
+            }
+            table->strings[slot] = strings[(NSUInteger)indexes[key]];
+            table->indexes[slot] = indexes[key];
+        }
+    }
+    
+    free(indexes);
+    free(hashes);
+}
+
+static inline NSInteger HKEnumStringTableIndex(const HKEnumStringTable *table, NSString *string) {
+    if (!table->strings || !string) {
+        return NSNotFound;
+    }
+    
+    uint64_t hash = (uint64_t)string.hash;
+    if (table->seeds) {
+        NSUInteger slot = HKEnumStringSlot(hash, table->seeds[HKEnumStringBucket(hash, table->bucketMask)], table->slotMask);
+        return [table->strings[slot] isEqualToString:string] ? table->indexes[slot] : NSNotFound;
+    }
+    
+    for (NSUInteger slot = (NSUInteger)HKEnumMix(hash) & table->slotMask; table->strings[slot]; slot = (slot + 1) & table->slotMask) {
+        if ([table->strings[slot] isEqualToString:string]) {
+            return table->indexes[slot];
+        }
+    }
+    return NSNotFound;
+}
+
 @implementation HKEnumStorage : NSObject
 
 @dynamic sharedStorage;
 
+// static tables of HKEnumImplementation(...) are registered once by currentStorage (first use of enum class)
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        [self HK_registerStaticTables];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    HKEnumValueTableFree(&_valueTable);
+    HKEnumStringTableFree(&_stringTable);
+}
+
+// enums are materialized and changed only in registration, then read without lock
 - (void)registerEnumArguments:(NSString *)arguments {
     _allKeys = [HKGetComponents(arguments) copy];
-    for (NSString *key in _allKeys) {
-        [self.enumClass HK_initializeClassPropertyWithName:key];
+    [self HK_materializeEnums];
+    for (HKEnum *result in _allEnums) {
+        [self.enumClass HK_initializeClassPropertyWithName:_allKeys[result->_ordinal] enum:result];
     }
+    
+    [self HK_updateEnums];
+    [self HK_buildLookupTables];
 }
 
 - (void)registerValues:(NSArray<NSNumber *> *)values {
     _allValues = [values copy];
+    [self HK_updateEnums];
+    [self HK_buildLookupTables];
 }
 
 - (void)registerStringValues:(NSArray<NSString *> *)stringValues {
     _allStringValues = [stringValues copy];
+    [self HK_updateEnums];
+    [self HK_buildLookupTables];
 }
 
 - (void)registerObject:(NSArray<id> *)objects propertyName:(NSString *)propertyName {
@@ -232,34 +510,26 @@ static NSArray<NSString *> *HKGetComponents(NSString *string) {
         _allProperties = [NSMutableDictionary dictionary];
     }
     _allProperties[propertyName] = [objects copy];
+    [self HK_updateEnums];
+}
+
+- (__kindof HKEnum *)enumAtIndex:(NSUInteger)index {
+    return _allEnums[index];
 }
 
 - (nullable __kindof HKEnum *)enumForKey:(NSString *)key {
-    if (!_allEnums) {
-        _allEnums = [NSMutableDictionary dictionaryWithCapacity:_allKeys.count];
-    }
-    __kindof HKEnum *result = _allEnums[key];
-    if (!result) {
-        result = [self HK_makeEnumForKey:key];
-        _allEnums[key] = result;
-    }
-    return result;
+    NSNumber *index = _indexes[key];
+    return index ? _allEnums[index.unsignedIntegerValue] : nil;
 }
 
 - (nullable __kindof HKEnum *)enumForValue:(NSInteger)value {
-    NSInteger index = _allValues ? [_allValues indexOfObject:@(value)] : value;
-    
-    @try {
-        return index != NSNotFound ? [self enumForKey:_allKeys[index]] : nil;
-    } @catch (__unused NSException *exception) {
-        return nil;
-    }
+    NSInteger index = HKEnumValueTableIndex(&_valueTable, value);
+    return index != NSNotFound ? _allEnums[(NSUInteger)index] : nil;
 }
 
 - (nullable __kindof HKEnum *)enumForStringValue:(NSString *)stringValue {
-    NSInteger index = [_allStringValues ?: _allKeys indexOfObject:stringValue];
-    
-    return index != NSNotFound ? [self enumForKey:_allKeys[index]] : nil;
+    NSInteger index = HKEnumStringTableIndex(&_stringTable, stringValue);
+    return index != NSNotFound ? _allEnums[(NSUInteger)index] : nil;
 }
 
 #pragma mark - properties
@@ -271,27 +541,105 @@ static NSArray<NSString *> *HKGetComponents(NSString *string) {
 }
 
 - (NSArray<__kindof HKEnum *> *)allEnums {
-    NSMutableArray<__kindof HKEnum *> *result = [NSMutableArray arrayWithCapacity:_allKeys.count];
-    for (NSString *key in _allKeys) {
-        [result addObject:[self enumForKey:key]];
-    }
-    return result;
+    return _allEnums ?: @[];
 }
 
 #pragma mark - private methods
 
-- (nullable __kindof HKEnum *)HK_makeEnumForKey:(NSString *)key {
-    NSInteger index = [_allKeys indexOfObject:key];
+- (void)HK_registerStaticTables {
+    Class enumClass = self.enumClass;
+    NSUInteger count = 0;
+    if (![enumClass respondsToSelector:@selector(HK_enumNamesWithCount:)]) {
+        return;
+    }
     
-    __kindof HKEnum *result = [[self.enumClass alloc] init];
-    result->_value = _allValues ? _allValues[index].integerValue : index;
-    result->_stringValue = _allStringValues ? [_allStringValues[index] copy] : [key copy];
-    for (NSString *propertyName in _allProperties) {
-        NSArray<id> *properyValues = _allProperties[propertyName];
-        HKProperty *property = [HKProperty propertyWithClass:self.enumClass name:propertyName];
-        [result setObject:properyValues[index] forProperty:property];
+    const char *const *names = [(Class<HKEnumStaticTable>)enumClass HK_enumNamesWithCount:&count];
+    NSMutableArray<NSString *> *keys = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [keys addObject:@(names[index])];
+    }
+    _allKeys = [keys copy];
+    
+    if ([enumClass respondsToSelector:@selector(HK_enumValuesUsingBlock:)]) {
+        __block NSArray<NSNumber *> *allValues = nil;
+        [(Class<HKEnumStaticTable>)enumClass HK_enumValuesUsingBlock:^(const NSInteger *values, NSUInteger numberOfValues) {
+            NSMutableArray<NSNumber *> *numbers = [NSMutableArray arrayWithCapacity:numberOfValues];
+            for (NSUInteger index = 0; index < numberOfValues; index++) {
+                [numbers addObject:@(values[index])];
+            }
+            allValues = [numbers copy];
+        }];
+        _allValues = allValues;
+    }
+    if ([enumClass respondsToSelector:@selector(HK_enumStringValues)]) {
+        _allStringValues = [[(Class<HKEnumStaticTable>)enumClass HK_enumStringValues] copy];
+    }
+    
+    // HKEnumRegisterProperties(...) implements class method for each property
+    unsigned int numberOfMethods = 0;
+    Method *methods = class_copyMethodList(object_getClass(enumClass), &numberOfMethods);
+    for (unsigned int index = 0; index < numberOfMethods; index++) {
+        SEL selector = method_getName(methods[index]);
+        NSString *name = NSStringFromSelector(selector);
+        if ([name hasPrefix:kHKEnumPropertyObjectsPrefix]) {
+            NSArray<id> *objects = ((NSArray<id> *(*)(id, SEL))method_getImplementation(methods[index]))(enumClass, selector);
+            if (!_allProperties) {
+                _allProperties = [NSMutableDictionary dictionary];
+            }
+            _allProperties[[name substringFromIndex:kHKEnumPropertyObjectsPrefix.length]] = [objects copy];
+        }
+    }
+    free(methods);
+    
+    [self HK_materializeEnums];
+    [self HK_updateEnums];
+    [self HK_buildLookupTables];
+}
+
+- (void)HK_materializeEnums {
+    _classSeed = NSStringFromClass(self.enumClass).hash;
+    
+    NSMutableArray<__kindof HKEnum *> *allEnums = [NSMutableArray arrayWithCapacity:_allKeys.count];
+    NSMutableDictionary<NSString *, NSNumber *> *indexes = [NSMutableDictionary dictionaryWithCapacity:_allKeys.count];
+    for (NSUInteger index = 0; index < _allKeys.count; index++) {
+        __kindof HKEnum *result = [[self.enumClass alloc] init];
+        result->_ordinal = index;
+        [allEnums addObject:result];
+        indexes[_allKeys[index]] = @(index);
+    }
+    _allEnums = [allEnums copy];
+    _indexes = [indexes copy];
+}
+
+// registration order of keys, values and string values is not fixed, tables are rebuilt by each registration
+- (void)HK_buildLookupTables {
+    NSUInteger count = _allValues ? MIN(_allValues.count, _allKeys.count) : _allKeys.count;
+    NSInteger *values = malloc(MAX(count, 1) * sizeof(NSInteger));
+    for (NSUInteger index = 0; index < count; index++) {
+        values[index] = _allValues ? _allValues[index].integerValue : (NSInteger)index;
+    }
+    HKEnumValueTableBuild(&_valueTable, values, count);
+    free(values);
+    
+    NSArray<NSString *> *stringValues = _allStringValues ?: _allKeys;
+    HKEnumStringTableBuild(&_stringTable, stringValues, MIN(stringValues.count, _allKeys.count));
+}
+
+// set value, string value and properties of registration to enums
+- (void)HK_updateEnums {
+    for (NSUInteger index = 0; index < _allEnums.count; index++) {
+        __kindof HKEnum *result = _allEnums[index];
+        result->_value = _allValues && index < _allValues.count ? _allValues[index].integerValue : (NSInteger)index;
+        result->_stringValue = _allStringValues && index < _allStringValues.count ? [_allStringValues[index] copy] : [_allKeys[index] copy];
+        result->_hash = _classSeed ^ ((NSUInteger)result->_value * kHKEnumHashMultiplier);
+        for (NSString *propertyName in _allProperties) {
+            NSArray<id> *properyValues = _allProperties[propertyName];
+            if (index < properyValues.count) {
+                HKProperty *property = [HKProperty propertyWithClass:self.enumClass name:propertyName];
+                [result setObject:properyValues[index] forProperty:property];
+            }
+        }
     }
-    return result;
 }
 
 @end
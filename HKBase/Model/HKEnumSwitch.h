@@ -0,0 +1,75 @@
+//
+//  HKEnumSwitch.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKEnum.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ compiled switch of Enum (replacement of switchWithDefaultHandler: executed repeatedly)
+ handlers are arranged by ordinal of Enum once, result is dispatched without comparing cases
+ missing cases without default handler are asserted when switch is built (missingEnums)
+ switch of enumCase (HKEnumDeclare(...)) is checked at build time instead
+ usage example>
+ static HKEnumSwitch<HKWeekday *, UIColor *> *textColorSwitch = nil;
+ static dispatch_once_t onceToken;
+ dispatch_once(&onceToken, ^{
+     UIColor *(^weekend)(void) = ^UIColor *{ return UIColor.redColor; };
+     textColorSwitch = [HKEnumSwitch switchWithEnumClass:HKWeekday.class cases:@{ HKWeekday.Saturday : weekend, HKWeekday.Sunday : weekend } defaultHandler:^UIColor *{ return UIColor.blackColor; }];
+ });
+ UIColor *textColor = [textColorSwitch resultForEnum:weekday];
+ */
+@interface HKEnumSwitch<EnumType : HKEnum *, ResultType> : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+/**
+ switch
+
+ @param enumClass Enum class
+ @param cases block by Enum (same block for multiple Enums is allowed)
+ @param defaultHandler block for Enum not in cases (nil: all Enums should be in cases, result of nil Enum is nil)
+ @return switch
+ */
++ (instancetype)switchWithEnumClass:(Class)enumClass cases:(NSDictionary<EnumType, ResultType _Nullable (^)(void)> *)cases defaultHandler:(nullable ResultType _Nullable (^)(void))defaultHandler;
+
+/**
+ Enum class
+ */
+@property (nonatomic, unsafe_unretained, readonly) Class enumClass;
+/**
+ Enums not in cases (handled by default handler)
+ */
+@property (nonatomic, readonly) NSArray<EnumType> *missingEnums;
+
+/**
+ result of block for Enum
+
+ @param enumObject Enum (nil or Enum of other class: default handler)
+ @return result of block
+ */
+- (nullable ResultType)resultForEnum:(nullable EnumType)enumObject;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,95 @@
+//
+//  HKEnumSwitch.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKEnumSwitch.h"
+#import <objc/runtime.h>
+
+typedef id _Nullable (^HKEnumSwitchHandler)(void);
+
+@interface HKEnumSwitch () {
+    NSArray<HKEnumSwitchHandler> *_handlers;
+    __unsafe_unretained HKEnumSwitchHandler *_handlerTable;    // handler by ordinal (nil: default), owned by _handlers
+    NSUInteger _numberOfEnums;
+    HKEnumSwitchHandler _defaultHandler;
+}
+
+- (instancetype)HK_initWithEnumClass:(Class)enumClass cases:(NSDictionary<HKEnum *, HKEnumSwitchHandler> *)cases defaultHandler:(HKEnumSwitchHandler)defaultHandler;
+
+@end
+
+@implementation HKEnumSwitch
+
++ (instancetype)switchWithEnumClass:(Class)enumClass cases:(NSDictionary<HKEnum *, HKEnumSwitchHandler> *)cases defaultHandler:(HKEnumSwitchHandler)defaultHandler {
+    return [[self alloc] HK_initWithEnumClass:enumClass cases:cases defaultHandler:defaultHandler];
+}
+
+- (instancetype)HK_initWithEnumClass:(Class)enumClass cases:(NSDictionary<HKEnum *, HKEnumSwitchHandler> *)cases defaultHandler:(HKEnumSwitchHandler)defaultHandler {
+    self = [super init];
+    if (self) {
+        NSAssert([enumClass isSubclassOfClass:HKEnum.class], @"enum class should be subclass of HKEnum");
+        _enumClass = enumClass;
+        _defaultHandler = [defaultHandler copy];
+        
+        NSArray<HKEnum *> *allEnums = [enumClass allEnums];
+        _numberOfEnums = allEnums.count;
+        _handlerTable = (__unsafe_unretained HKEnumSwitchHandler *)calloc(MAX(_numberOfEnums, 1), sizeof(HKEnumSwitchHandler));
+        
+        NSMutableArray<HKEnumSwitchHandler> *handlers = [NSMutableArray arrayWithCapacity:cases.count];
+        [cases enumerateKeysAndObjectsUsingBlock:^(HKEnum *enumObject, HKEnumSwitchHandler handler, BOOL *stop) {
+            BOOL isCase = object_getClass(enumObject) == enumClass && enumObject.ordinal < self->_numberOfEnums;
+            NSCAssert(isCase, @"case %@ is not enum of %@", enumObject, enumClass);
+            if (isCase) {
+                HKEnumSwitchHandler copiedHandler = [handler copy];
+                [handlers addObject:copiedHandler];
+                self->_handlerTable[enumObject.ordinal] = copiedHandler;
+            }
+        }];
+        _handlers = [handlers copy];
+        
+        NSMutableArray<HKEnum *> *missingEnums = [NSMutableArray array];
+        for (HKEnum *enumObject in allEnums) {
+            if (!_handlerTable[enumObject.ordinal]) {
+                [missingEnums addObject:enumObject];
+            }
+        }
+        _missingEnums = [missingEnums copy];
+        NSAssert(_defaultHandler || !_missingEnums.count, @"HKEnumSwitch of %@ does not handle %@ without default handler", enumClass, [_missingEnums valueForKeyPath:@"stringValue"]);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_handlerTable);
+}
+
+- (id)resultForEnum:(HKEnum *)enumObject {
+    HKEnumSwitchHandler handler = nil;
+    if (enumObject && object_getClass(enumObject) == _enumClass) {
+        NSUInteger ordinal = enumObject.ordinal;
+        handler = ordinal < _numberOfEnums ? _handlerTable[ordinal] : nil;
+    }
+    handler = handler ?: _defaultHandler;
+    return handler ? handler() : nil;
+}
+
+@end
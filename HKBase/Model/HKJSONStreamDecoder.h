@@ -0,0 +1,139 @@
+//
+//  HKJSONStreamDecoder.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ layout of JSON stream
+
+ - HKJSONStreamFormatAutomatic: array if first character is '[', lines otherwise
+ - HKJSONStreamFormatLines: newline delimited JSON (NDJSON, concatenated values are also allowed)
+ - HKJSONStreamFormatArray: one top level JSON array
+ */
+typedef NS_ENUM(NSInteger, HKJSONStreamFormat) {
+    HKJSONStreamFormatAutomatic = 0,
+    HKJSONStreamFormatLines,
+    HKJSONStreamFormatArray,
+};
+
+/**
+ handler of decoded models
+
+ @param models decoded models of batch (non object values are dropped)
+ @param stop set YES to stop decoding
+ */
+typedef void (^HKJSONStreamHandler)(NSArray *models, BOOL *stop);
+
+/**
+ incremental decoder of JSON stream into models
+ input is pushed by chunks (or read from input stream, file descriptor), and bytes of decoded batch are released
+ memory is bounded by batch count and largest value, not by size of stream
+ */
+@interface HKJSONStreamDecoder<ObjectType : HKModel *> : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+/**
+ decoder
+
+ @param modelClass class of models
+ @param format layout of stream
+ @param batchCount number of models for each handler call (0 is 256)
+ @param handler handler of batch (nil: batches are kept for batch enumerator)
+ @return decoder
+ */
+- (instancetype)initWithModelClass:(Class)modelClass format:(HKJSONStreamFormat)format batchCount:(NSUInteger)batchCount handler:(nullable void (^)(NSArray<ObjectType> *models, BOOL *stop))handler NS_DESIGNATED_INITIALIZER;
+
+/**
+ class of models
+ */
+@property (nonatomic, unsafe_unretained, readonly) Class modelClass;
+/**
+ number of decoded models
+ */
+@property (nonatomic, readonly) NSUInteger numberOfModels;
+/**
+ handler stopped decoding (appended bytes are ignored)
+ */
+@property (nonatomic, readonly, getter=isStopped) BOOL stopped;
+/**
+ error of decoding (in HKJSONErrorDomain, nil if no error)
+ */
+@property (nonatomic, readonly, nullable) NSError *error;
+
+/**
+ append chunk of stream (complete values are decoded)
+
+ @param bytes bytes of chunk
+ @param length length of chunk
+ @param error error (in HKJSONErrorDomain)
+ @return NO if failed
+ */
+- (BOOL)appendBytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable * _Nullable)error;
+/**
+ append chunk of stream (complete values are decoded)
+
+ @param data chunk
+ @param error error (in HKJSONErrorDomain)
+ @return NO if failed
+ */
+- (BOOL)appendData:(NSData *)data error:(NSError * _Nullable * _Nullable)error;
+/**
+ end of stream (decode last value and batch)
+
+ @param error error (in HKJSONErrorDomain, ex. stream is terminated in value)
+ @return NO if failed
+ */
+- (BOOL)finishWithError:(NSError * _Nullable * _Nullable)error;
+
+/**
+ read input stream until end and finish (blocking)
+
+ @param inputStream input stream (opened if not opened)
+ @param error error (in HKJSONErrorDomain or error of stream)
+ @return NO if failed
+ */
+- (BOOL)decodeInputStream:(NSInputStream *)inputStream error:(NSError * _Nullable * _Nullable)error;
+/**
+ read file descriptor until end and finish (blocking)
+
+ @param fileDescriptor file descriptor (not closed)
+ @param error error (in HKJSONErrorDomain or NSPOSIXErrorDomain)
+ @return NO if failed
+ */
+- (BOOL)decodeFileDescriptor:(int)fileDescriptor error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ enumerator of batches read from input stream on demand (decoder without handler only)
+ enumeration ends at end of stream or error (see error)
+
+ @param inputStream input stream (opened if not opened)
+ @return enumerator of batches
+ */
+- (NSEnumerator<NSArray<ObjectType> *> *)batchEnumeratorWithInputStream:(NSInputStream *)inputStream;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,529 @@
+//
+//  HKJSONStreamDecoder.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKJSONStreamDecoder.h"
+#import "HKModel+JSON.h"
+#import "HKModelPlan.h"
+#import "HKArray.h"
+#include <unistd.h>
+#include <errno.h>
+
+static const NSUInteger kHKJSONStreamBatchCount = 256;          // default number of models for each batch
+static const NSUInteger kHKJSONStreamReadLength = 64 * 1024;    // bytes read from stream at once
+
+/**
+ position in stream (between values)
+
+ - HKJSONStreamStateValue: value of lines or '[' of array is expected
+ - HKJSONStreamStateFirstElement: element or ']' is expected
+ - HKJSONStreamStateElement: element is expected (after ',')
+ - HKJSONStreamStateSeparator: ',' or ']' is expected
+ - HKJSONStreamStateEnd: whitespace only (after ']')
+ */
+typedef NS_ENUM(NSInteger, HKJSONStreamState) {
+    HKJSONStreamStateValue = 0,
+    HKJSONStreamStateFirstElement,
+    HKJSONStreamStateElement,
+    HKJSONStreamStateSeparator,
+    HKJSONStreamStateEnd,
+};
+
+static inline BOOL HKJSONStreamIsWhitespace(uint8_t character) {
+    return character == ' ' || character == '\n' || character == '\r' || character == '\t';
+}
+
+#pragma mark - batch enumerator
+@interface HKJSONStreamBatchEnumerator : NSEnumerator {
+    HKJSONStreamDecoder *_decoder;
+    NSInputStream *_inputStream;
+    BOOL _isFinished;
+}
+
+- (instancetype)HK_initWithDecoder:(HKJSONStreamDecoder *)decoder inputStream:(NSInputStream *)inputStream;
+
+@end
+
+#pragma mark - decoder
+@interface HKJSONStreamDecoder () {
+    void (^_handler)(NSArray *, BOOL *);
+    NSUInteger _batchCount;
+    HKJSONStreamFormat _format;
+    
+    NSMutableData *_buffer;             // bytes of pending values and value in progress
+    unsigned long long _bufferOffset;   // offset of buffer in stream (for error)
+    NSUInteger _position;               // scanned length of buffer
+    HKJSONStreamState _state;
+    BOOL _isBOMChecked;
+    
+    NSUInteger _valueStart;             // start of value in progress (NSNotFound if between values)
+    NSUInteger _depth;
+    BOOL _isInString;
+    BOOL _isEscaped;
+    
+    NSRange *_ranges;                   // ranges of complete values in buffer (batchCount)
+    NSUInteger _numberOfRanges;
+    
+    NSMutableArray<NSArray *> *_batches; // batches for enumerator (without handler)
+}
+
+@property (nonatomic, readwrite) NSUInteger numberOfModels;
+@property (nonatomic, readwrite, getter=isStopped) BOOL stopped;
+@property (nonatomic, readwrite, nullable) NSError *error;
+
+- (nullable NSArray *)HK_nextBatch;
+
+@end
+
+@implementation HKJSONStreamDecoder
+
+- (instancetype)initWithModelClass:(Class)modelClass format:(HKJSONStreamFormat)format batchCount:(NSUInteger)batchCount handler:(void (^)(NSArray *, BOOL *))handler {
+    if (self = [super init]) {
+        _modelClass = modelClass;
+        _format = format;
+        _batchCount = batchCount ?: kHKJSONStreamBatchCount;
+        _handler = [handler copy];
+        _buffer = [NSMutableData data];
+        _valueStart = NSNotFound;
+        _ranges = malloc(sizeof(NSRange) * _batchCount);
+        _batches = handler ? nil : [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_ranges);
+}
+
+#pragma mark - error
+- (BOOL)HK_failWithCode:(HKJSONError)code position:(NSUInteger)position error:(NSError **)error {
+    if (!self.error) {
+        NSString *description = [NSString stringWithFormat:@"%@ at offset %llu", code == HKJSONErrorUnexpectedEnd ? @"unexpected end of data" : @"unexpected character", _bufferOffset + position];
+        self.error = [NSError errorWithDomain:HKJSONErrorDomain code:code userInfo:@{ NSLocalizedDescriptionKey : description }];
+    }
+    if (error) {
+        *error = self.error;
+    }
+    return NO;
+}
+
+#pragma mark - batch
+/**
+ decode complete values, call handler and release bytes of values
+ */
+- (BOOL)HK_flushBatchWithError:(NSError **)error {
+    NSUInteger count = _numberOfRanges;
+    if (count == 0) {
+        return YES;
+    }
+    
+    const uint8_t *bytes = _buffer.bytes;
+    const NSRange *ranges = _ranges;
+    __unsafe_unretained Class modelClass = self.modelClass;
+    __strong id *models = (__strong id *)calloc(count, sizeof(id));
+    __strong NSError **errors = (__strong NSError **)calloc(count, sizeof(NSError *));
+    void (^decode)(NSUInteger, NSRange) = ^(NSUInteger chunk, NSRange range) {
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            @autoreleasepool {
+                NSRange valueRange = ranges[index];
+                // non object values are dropped as elements of HKArray
+                if (bytes[valueRange.location] != '{') {
+                    continue;
+                }
+                NSError *decodeError = nil;
+                models[index] = [modelClass modelWithJSONBytes:bytes + valueRange.location length:valueRange.length error:&decodeError];
+                errors[index] = decodeError;
+            }
+        }
+    };
+    NSUInteger threshold = HKArray.concurrentThreshold;
+    if (threshold > 0 && count >= threshold) {
+        HKModelPerformConcurrently(count, HKModelConcurrentChunkCount(count), decode);
+    } else {
+        decode(0, NSMakeRange(0, count));
+    }
+    
+    NSMutableArray *batch = [NSMutableArray arrayWithCapacity:count];
+    NSError *decodeError = nil;
+    for (NSUInteger index = 0; index < count; index++) {
+        if (!decodeError && errors[index]) {
+            decodeError = errors[index];
+        }
+        if (models[index]) {
+            [batch addObject:models[index]];
+        }
+        models[index] = nil;
+        errors[index] = nil;
+    }
+    free(models);
+    free(errors);
+    
+    // release bytes of values (value in progress is moved to front)
+    NSUInteger consumed = _valueStart != NSNotFound ? _valueStart : _position;
+    [_buffer replaceBytesInRange:NSMakeRange(0, consumed) withBytes:NULL length:0];
+    _bufferOffset += consumed;
+    _position -= consumed;
+    if (_valueStart != NSNotFound) {
+        _valueStart = 0;
+    }
+    _numberOfRanges = 0;
+    
+    if (decodeError) {
+        self.error = decodeError;
+        if (error) {
+            *error = decodeError;
+        }
+        return NO;
+    }
+    
+    self.numberOfModels += batch.count;
+    if (batch.count > 0) {
+        if (_handler) {
+            BOOL stop = NO;
+            _handler(batch, &stop);
+            self.stopped = stop;
+        } else {
+            [_batches addObject:batch];
+        }
+    }
+    return YES;
+}
+
+- (nullable NSArray *)HK_nextBatch {
+    NSArray *batch = _batches.firstObject;
+    if (batch) {
+        [_batches removeObjectAtIndex:0];
+    }
+    return batch;
+}
+
+#pragma mark - scan
+- (BOOL)HK_endValueAtPosition:(NSUInteger)position error:(NSError **)error {
+    if (position == _valueStart) {
+        // value starts with separator
+        return [self HK_failWithCode:HKJSONErrorUnexpectedCharacter position:position error:error];
+    }
+    _ranges[_numberOfRanges++] = NSMakeRange(_valueStart, position - _valueStart);
+    _valueStart = NSNotFound;
+    _position = position;
+    _state = _state == HKJSONStreamStateValue ? HKJSONStreamStateValue : HKJSONStreamStateSeparator;
+    if (_numberOfRanges == _batchCount) {
+        return [self HK_flushBatchWithError:error];
+    }
+    return YES;
+}
+
+/**
+ find boundaries of values in scanned bytes (state is kept between chunks)
+ */
+- (BOOL)HK_scanWithError:(NSError **)error {
+    if (!_isBOMChecked) {
+        if (_buffer.length < 3) {
+            return YES;
+        }
+        const uint8_t *bytes = _buffer.bytes;
+        if (bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+            _position = 3;
+        }
+        _isBOMChecked = YES;
+    }
+    
+    while (_position < _buffer.length && !self.isStopped) {
+        // buffer may be compacted by batch
+        const uint8_t *bytes = _buffer.bytes;
+        NSUInteger length = _buffer.length;
+        NSUInteger position = _position;
+        uint8_t character = bytes[position];
+        
+        if (_valueStart != NSNotFound) {
+            if (_isInString) {
+                position++;
+                if (_isEscaped) {
+                    _isEscaped = NO;
+                } else if (character == '\\') {
+                    _isEscaped = YES;
+                } else if (character == '"') {
+                    _isInString = NO;
+                    if (_depth == 0) {
+                        // top level string
+                        if (![self HK_endValueAtPosition:position error:error]) {
+                            return NO;
+                        }
+                        continue;
+                    }
+                }
+                // skip characters of string at once
+                while (_isInString && !_isEscaped && position < length && bytes[position] != '"' && bytes[position] != '\\') {
+                    position++;
+                }
+                _position = position;
+                continue;
+            }
+            
+            switch (character) {
+                case '"':
+                    _isInString = YES;
+                    _position = position + 1;
+                    break;
+                case '{':
+                case '[':
+                    _depth++;
+                    _position = position + 1;
+                    break;
+                case '}':
+                case ']':
+                    if (_depth == 0) {
+                        // end of scalar element ('}' is checked by state)
+                        if (![self HK_endValueAtPosition:position error:error]) {
+                            return NO;
+                        }
+                        break;
+                    }
+                    _depth--;
+                    _position = position + 1;
+                    if (_depth == 0 && ![self HK_endValueAtPosition:_position error:error]) {
+                        return NO;
+                    }
+                    break;
+                default:
+                    if (_depth == 0 && (character == ',' || HKJSONStreamIsWhitespace(character))) {
+                        // end of scalar value
+                        if (![self HK_endValueAtPosition:position error:error]) {
+                            return NO;
+                        }
+                        break;
+                    }
+                    _position = position + 1;
+                    break;
+            }
+            continue;
+        }
+        
+        if (HKJSONStreamIsWhitespace(character)) {
+            _position = position + 1;
+            continue;
+        }
+        switch (_state) {
+            case HKJSONStreamStateValue:
+                if (_format == HKJSONStreamFormatAutomatic) {
+                    _format = character == '[' ? HKJSONStreamFormatArray : HKJSONStreamFormatLines;
+                }
+                if (_format == HKJSONStreamFormatArray) {
+                    if (character != '[') {
+                        return [self HK_failWithCode:HKJSONErrorUnexpectedCharacter position:position error:error];
+                    }
+                    _state = HKJSONStreamStateFirstElement;
+                    _position = position + 1;
+                } else {
+                    _valueStart = position;
+                }
+                break;
+            case HKJSONStreamStateFirstElement:
+                if (character == ']') {
+                    _state = HKJSONStreamStateEnd;
+                    _position = position + 1;
+                    break;
+                }
+                // fall through
+            case HKJSONStreamStateElement:
+                if (character == ',' || character == ']' || character == '}') {
+                    return [self HK_failWithCode:HKJSONErrorUnexpectedCharacter position:position error:error];
+                }
+                _valueStart = position;
+                break;
+            case HKJSONStreamStateSeparator:
+                if (character == ',') {
+                    _state = HKJSONStreamStateElement;
+                } else if (character == ']') {
+                    _state = HKJSONStreamStateEnd;
+                } else {
+                    return [self HK_failWithCode:HKJSONErrorUnexpectedCharacter position:position error:error];
+                }
+                _position = position + 1;
+                break;
+            case HKJSONStreamStateEnd:
+                return [self HK_failWithCode:HKJSONErrorUnexpectedCharacter position:position error:error];
+        }
+        if (_valueStart != NSNotFound) {
+            _depth = 0;
+            _isInString = NO;
+            _isEscaped = NO;
+        }
+    }
+    
+    // bytes between values are not needed
+    if (_numberOfRanges == 0 && _valueStart == NSNotFound && _isBOMChecked && _position > 0) {
+        [_buffer replaceBytesInRange:NSMakeRange(0, _position) withBytes:NULL length:0];
+        _bufferOffset += _position;
+        _position = 0;
+    }
+    return YES;
+}
+
+#pragma mark - input
+- (BOOL)appendBytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable __autoreleasing *)error {
+    if (self.error) {
+        if (error) {
+            *error = self.error;
+        }
+        return NO;
+    }
+    if (self.isStopped || length == 0) {
+        return YES;
+    }
+    [_buffer appendBytes:bytes length:length];
+    return [self HK_scanWithError:error];
+}
+
+- (BOOL)appendData:(NSData *)data error:(NSError * _Nullable __autoreleasing *)error {
+    return [self appendBytes:data.bytes length:data.length error:error];
+}
+
+- (BOOL)finishWithError:(NSError * _Nullable __autoreleasing *)error {
+    if (self.error) {
+        if (error) {
+            *error = self.error;
+        }
+        return NO;
+    }
+    if (self.isStopped) {
+        return YES;
+    }
+    if (!_isBOMChecked) {
+        _isBOMChecked = YES;
+        if (![self HK_scanWithError:error]) {
+            return NO;
+        }
+    }
+    if (_valueStart != NSNotFound) {
+        // scalar value may be terminated by end of lines
+        BOOL isScalar = _depth == 0 && !_isInString && _state == HKJSONStreamStateValue;
+        if (!isScalar) {
+            return [self HK_failWithCode:HKJSONErrorUnexpectedEnd position:_buffer.length error:error];
+        }
+        if (![self HK_endValueAtPosition:_buffer.length error:error]) {
+            return NO;
+        }
+    }
+    if (_format == HKJSONStreamFormatArray && _state != HKJSONStreamStateEnd) {
+        return [self HK_failWithCode:HKJSONErrorUnexpectedEnd position:_buffer.length error:error];
+    }
+    return [self HK_flushBatchWithError:error];
+}
+
+- (BOOL)decodeInputStream:(NSInputStream *)inputStream error:(NSError * _Nullable __autoreleasing *)error {
+    if (inputStream.streamStatus == NSStreamStatusNotOpen) {
+        [inputStream open];
+    }
+    uint8_t *bytes = malloc(kHKJSONStreamReadLength);
+    BOOL result = YES;
+    while (result && !self.isStopped) {
+        NSInteger length = [inputStream read:bytes maxLength:kHKJSONStreamReadLength];
+        if (length < 0) {
+            if (error) {
+                *error = inputStream.streamError;
+            }
+            result = NO;
+        } else if (length == 0) {
+            break;
+        } else {
+            result = [self appendBytes:bytes length:(NSUInteger)length error:error];
+        }
+    }
+    free(bytes);
+    
+    return result && [self finishWithError:error];
+}
+
+- (BOOL)decodeFileDescriptor:(int)fileDescriptor error:(NSError * _Nullable __autoreleasing *)error {
+    uint8_t *bytes = malloc(kHKJSONStreamReadLength);
+    BOOL result = YES;
+    while (result && !self.isStopped) {
+        ssize_t length = read(fileDescriptor, bytes, kHKJSONStreamReadLength);
+        if (length < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (error) {
+                *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+            }
+            result = NO;
+        } else if (length == 0) {
+            break;
+        } else {
+            result = [self appendBytes:bytes length:(NSUInteger)length error:error];
+        }
+    }
+    free(bytes);
+    
+    return result && [self finishWithError:error];
+}
+
+- (NSEnumerator<NSArray *> *)batchEnumeratorWithInputStream:(NSInputStream *)inputStream {
+    NSAssert(_handler == nil, @"batch enumerator needs decoder without handler");
+    return [[HKJSONStreamBatchEnumerator alloc] HK_initWithDecoder:self inputStream:inputStream];
+}
+
+@end
+
+@implementation HKJSONStreamBatchEnumerator
+
+- (instancetype)HK_initWithDecoder:(HKJSONStreamDecoder *)decoder inputStream:(NSInputStream *)inputStream {
+    if (self = [super init]) {
+        _decoder = decoder;
+        _inputStream = inputStream;
+    }
+    return self;
+}
+
+- (id)nextObject {
+    NSArray *batch = [_decoder HK_nextBatch];
+    if (batch || _isFinished) {
+        return batch;
+    }
+    
+    if (_inputStream.streamStatus == NSStreamStatusNotOpen) {
+        [_inputStream open];
+    }
+    uint8_t *bytes = malloc(kHKJSONStreamReadLength);
+    // read until one batch is decoded
+    while (!batch && !_isFinished) {
+        NSInteger length = [_inputStream read:bytes maxLength:kHKJSONStreamReadLength];
+        BOOL result = YES;
+        if (length < 0) {
+            _decoder.error = _inputStream.streamError;
+            result = NO;
+        } else if (length == 0) {
+            result = [_decoder finishWithError:NULL];
+            _isFinished = YES;
+        } else {
+            result = [_decoder appendBytes:bytes length:(NSUInteger)length error:NULL];
+        }
+        _isFinished = _isFinished || !result;
+        batch = [_decoder HK_nextBatch];
+    }
+    free(bytes);
+    
+    return batch;
+}
+
+@end
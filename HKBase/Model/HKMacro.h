@@ -0,0 +1,303 @@
+//
+//  HKMacro.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+/**
+ concatenate tokens after expansion
+ */
+#define HK_MACRO_CONCAT(a, b) HK_MACRO_CONCAT_(a, b)
+#define HK_MACRO_CONCAT_(a, b) a ## b
+
+/**
+ number of arguments (1 ~ 512, counted beyond 256 for HK_MACRO_ASSERT_COUNT)
+ */
+#define HK_MACRO_COUNT(...) HK_MACRO_COUNT_(__VA_ARGS__, 512, 511, 510, 509, 508, 507, 506, 505, 504, 503, 502, 501, 500, 499, 498, 497, 496, 495, 494, 493, 492, 491, 490, 489, 488, 487, 486, 485, 484, 483, 482, 481, 480, 479, 478, 477, 476, 475, 474, 473, 472, 471, 470, 469, 468, 467, 466, 465, 464, 463, 462, 461, 460, 459, 458, 457, 456, 455, 454, 453, 452, 451, 450, 449, 448, 447, 446, 445, 444, 443, 442, 441, 440, 439, 438, 437, 436, 435, 434, 433, 432, 431, 430, 429, 428, 427, 426, 425, 424, 423, 422, 421, 420, 419, 418, 417, 416, 415, 414, 413, 412, 411, 410, 409, 408, 407, 406, 405, 404, 403, 402, 401, 400, 399, 398, 397, 396, 395, 394, 393, 392, 391, 390, 389, 388, 387, 386, 385, 384, 383, 382, 381, 380, 379, 378, 377, 376, 375, 374, 373, 372, 371, 370, 369, 368, 367, 366, 365, 364, 363, 362, 361, 360, 359, 358, 357, 356, 355, 354, 353, 352, 351, 350, 349, 348, 347, 346, 345, 344, 343, 342, 341, 340, 339, 338, 337, 336, 335, 334, 333, 332, 331, 330, 329, 328, 327, 326, 325, 324, 323, 322, 321, 320, 319, 318, 317, 316, 315, 314, 313, 312, 311, 310, 309, 308, 307, 306, 305, 304, 303, 302, 301, 300, 299, 298, 297, 296, 295, 294, 293, 292, 291, 290, 289, 288, 287, 286, 285, 284, 283, 282, 281, 280, 279, 278, 277, 276, 275, 274, 273, 272, 271, 270, 269, 268, 267, 266, 265, 264, 263, 262, 261, 260, 259, 258, 257, 256, 255, 254, 253, 252, 251, 250, 249, 248, 247, 246, 245, 244, 243, 242, 241, 240, 239, 238, 237, 236, 235, 234, 233, 232, 231, 230, 229, 228, 227, 226, 225, 224, 223, 222, 221, 220, 219, 218, 217, 216, 215, 214, 213, 212, 211, 210, 209, 208, 207, 206, 205, 204, 203, 202, 201, 200, 199, 198, 197, 196, 195, 194, 193, 192, 191, 190, 189, 188, 187, 186, 185, 184, 183, 182, 181, 180, 179, 178, 177, 176, 175, 174, 173, 172, 171, 170, 169, 168, 167, 166, 165, 164, 163, 162, 161, 160, 159, 158, 157, 156, 155, 154, 153, 152, 151, 150, 149, 148, 147, 146, 145, 144, 143, 142, 141, 140, 139, 138, 137, 136, 135, 134, 133, 132, 131, 130, 129, 128, 127, 126, 125, 124, 123, 122, 121, 120, 119, 118, 117, 116, 115, 114, 113, 112, 111, 110, 109, 108, 107, 106, 105, 104, 103, 102, 101, 100, 99, 98, 97, 96, 95, 94, 93, 92, 91, 90, 89, 88, 87, 86, 85, 84, 83, 82, 81, 80, 79, 78, 77, 76, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define HK_MACRO_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116, _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, _129, _130, _131, _132, _133, _134, _135, _136, _137, _138, _139, _140, _141, _142, _143, _144, _145, _146, _147, _148, _149, _150, _151, _152, _153, _154, _155, _156, _157, _158, _159, _160, _161, _162, _163, _164, _165, _166, _167, _168, _169, _170, _171, _172, _173, _174, _175, _176, _177, _178, _179, _180, _181, _182, _183, _184, _185, _186, _187, _188, _189, _190, _191, _192, _193, _194, _195, _196, _197, _198, _199, _200, _201, _202, _203, _204, _205, _206, _207, _208, _209, _210, _211, _212, _213, _214, _215, _216, _217, _218, _219, _220, _221, _222, _223, _224, _225, _226, _227, _228, _229, _230, _231, _232, _233, _234, _235, _236, _237, _238, _239, _240, _241, _242, _243, _244, _245, _246, _247, _248, _249, _250, _251, _252, _253, _254, _255, _256, _257, _258, _259, _260, _261, _262, _263, _264, _265, _266, _267, _268, _269, _270, _271, _272, _273, _274, _275, _276, _277, _278, _279, _280, _281, _282, _283, _284, _285, _286, _287, _288, _289, _290, _291, _292, _293, _294, _295, _296, _297, _298, _299, _300, _301, _302, _303, _304, _305, _306, _307, _308, _309, _310, _311, _312, _313, _314, _315, _316, _317, _318, _319, _320, _321, _322, _323, _324, _325, _326, _327, _328, _329, _330, _331, _332, _333, _334, _335, _336, _337, _338, _339, _340, _341, _342, _343, _344, _345, _346, _347, _348, _349, _350, _351, _352, _353, _354, _355, _356, _357, _358, _359, _360, _361, _362, _363, _364, _365, _366, _367, _368, _369, _370, _371, _372, _373, _374, _375, _376, _377, _378, _379, _380, _381, _382, _383, _384, _385, _386, _387, _388, _389, _390, _391, _392, _393, _394, _395, _396, _397, _398, _399, _400, _401, _402, _403, _404, _405, _406, _407, _408, _409, _410, _411, _412, _413, _414, _415, _416, _417, _418, _419, _420, _421, _422, _423, _424, _425, _426, _427, _428, _429, _430, _431, _432, _433, _434, _435, _436, _437, _438, _439, _440, _441, _442, _443, _444, _445, _446, _447, _448, _449, _450, _451, _452, _453, _454, _455, _456, _457, _458, _459, _460, _461, _462, _463, _464, _465, _466, _467, _468, _469, _470, _471, _472, _473, _474, _475, _476, _477, _478, _479, _480, _481, _482, _483, _484, _485, _486, _487, _488, _489, _490, _491, _492, _493, _494, _495, _496, _497, _498, _499, _500, _501, _502, _503, _504, _505, _506, _507, _508, _509, _510, _511, _512, N, ...) N
+
+/**
+ compile error if number of arguments is more than HK_MACRO_FOR_EACH supports (256)
+ use at file scope before HK_MACRO_FOR_EACH
+ */
+#define HK_MACRO_ASSERT_COUNT(...) _Static_assert(HK_MACRO_COUNT(__VA_ARGS__) <= 256, "HK_MACRO_FOR_EACH supports 1 ~ 256 arguments");
+
+/**
+ expand macro(context, index, argument) for each argument (1 ~ 256 arguments)
+ index is constant expression from 0 (ex. 3 - 3)
+ */
+#define HK_MACRO_FOR_EACH(macro, context, ...) HK_MACRO_CONCAT(HK_MACRO_FOR_EACH_, HK_MACRO_COUNT(__VA_ARGS__))(macro, context, HK_MACRO_COUNT(__VA_ARGS__), __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_1(macro, context, count, x) macro(context, count - 1, x)
+#define HK_MACRO_FOR_EACH_2(macro, context, count, x, ...) macro(context, count - 2, x) HK_MACRO_FOR_EACH_1(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_3(macro, context, count, x, ...) macro(context, count - 3, x) HK_MACRO_FOR_EACH_2(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_4(macro, context, count, x, ...) macro(context, count - 4, x) HK_MACRO_FOR_EACH_3(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_5(macro, context, count, x, ...) macro(context, count - 5, x) HK_MACRO_FOR_EACH_4(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_6(macro, context, count, x, ...) macro(context, count - 6, x) HK_MACRO_FOR_EACH_5(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_7(macro, context, count, x, ...) macro(context, count - 7, x) HK_MACRO_FOR_EACH_6(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_8(macro, context, count, x, ...) macro(context, count - 8, x) HK_MACRO_FOR_EACH_7(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_9(macro, context, count, x, ...) macro(context, count - 9, x) HK_MACRO_FOR_EACH_8(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_10(macro, context, count, x, ...) macro(context, count - 10, x) HK_MACRO_FOR_EACH_9(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_11(macro, context, count, x, ...) macro(context, count - 11, x) HK_MACRO_FOR_EACH_10(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_12(macro, context, count, x, ...) macro(context, count - 12, x) HK_MACRO_FOR_EACH_11(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_13(macro, context, count, x, ...) macro(context, count - 13, x) HK_MACRO_FOR_EACH_12(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_14(macro, context, count, x, ...) macro(context, count - 14, x) HK_MACRO_FOR_EACH_13(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_15(macro, context, count, x, ...) macro(context, count - 15, x) HK_MACRO_FOR_EACH_14(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_16(macro, context, count, x, ...) macro(context, count - 16, x) HK_MACRO_FOR_EACH_15(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_17(macro, context, count, x, ...) macro(context, count - 17, x) HK_MACRO_FOR_EACH_16(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_18(macro, context, count, x, ...) macro(context, count - 18, x) HK_MACRO_FOR_EACH_17(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_19(macro, context, count, x, ...) macro(context, count - 19, x) HK_MACRO_FOR_EACH_18(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_20(macro, context, count, x, ...) macro(context, count - 20, x) HK_MACRO_FOR_EACH_19(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_21(macro, context, count, x, ...) macro(context, count - 21, x) HK_MACRO_FOR_EACH_20(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_22(macro, context, count, x, ...) macro(context, count - 22, x) HK_MACRO_FOR_EACH_21(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_23(macro, context, count, x, ...) macro(context, count - 23, x) HK_MACRO_FOR_EACH_22(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_24(macro, context, count, x, ...) macro(context, count - 24, x) HK_MACRO_FOR_EACH_23(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_25(macro, context, count, x, ...) macro(context, count - 25, x) HK_MACRO_FOR_EACH_24(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_26(macro, context, count, x, ...) macro(context, count - 26, x) HK_MACRO_FOR_EACH_25(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_27(macro, context, count, x, ...) macro(context, count - 27, x) HK_MACRO_FOR_EACH_26(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_28(macro, context, count, x, ...) macro(context, count - 28, x) HK_MACRO_FOR_EACH_27(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_29(macro, context, count, x, ...) macro(context, count - 29, x) HK_MACRO_FOR_EACH_28(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_30(macro, context, count, x, ...) macro(context, count - 30, x) HK_MACRO_FOR_EACH_29(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_31(macro, context, count, x, ...) macro(context, count - 31, x) HK_MACRO_FOR_EACH_30(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_32(macro, context, count, x, ...) macro(context, count - 32, x) HK_MACRO_FOR_EACH_31(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_33(macro, context, count, x, ...) macro(context, count - 33, x) HK_MACRO_FOR_EACH_32(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_34(macro, context, count, x, ...) macro(context, count - 34, x) HK_MACRO_FOR_EACH_33(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_35(macro, context, count, x, ...) macro(context, count - 35, x) HK_MACRO_FOR_EACH_34(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_36(macro, context, count, x, ...) macro(context, count - 36, x) HK_MACRO_FOR_EACH_35(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_37(macro, context, count, x, ...) macro(context, count - 37, x) HK_MACRO_FOR_EACH_36(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_38(macro, context, count, x, ...) macro(context, count - 38, x) HK_MACRO_FOR_EACH_37(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_39(macro, context, count, x, ...) macro(context, count - 39, x) HK_MACRO_FOR_EACH_38(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_40(macro, context, count, x, ...) macro(context, count - 40, x) HK_MACRO_FOR_EACH_39(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_41(macro, context, count, x, ...) macro(context, count - 41, x) HK_MACRO_FOR_EACH_40(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_42(macro, context, count, x, ...) macro(context, count - 42, x) HK_MACRO_FOR_EACH_41(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_43(macro, context, count, x, ...) macro(context, count - 43, x) HK_MACRO_FOR_EACH_42(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_44(macro, context, count, x, ...) macro(context, count - 44, x) HK_MACRO_FOR_EACH_43(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_45(macro, context, count, x, ...) macro(context, count - 45, x) HK_MACRO_FOR_EACH_44(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_46(macro, context, count, x, ...) macro(context, count - 46, x) HK_MACRO_FOR_EACH_45(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_47(macro, context, count, x, ...) macro(context, count - 47, x) HK_MACRO_FOR_EACH_46(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_48(macro, context, count, x, ...) macro(context, count - 48, x) HK_MACRO_FOR_EACH_47(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_49(macro, context, count, x, ...) macro(context, count - 49, x) HK_MACRO_FOR_EACH_48(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_50(macro, context, count, x, ...) macro(context, count - 50, x) HK_MACRO_FOR_EACH_49(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_51(macro, context, count, x, ...) macro(context, count - 51, x) HK_MACRO_FOR_EACH_50(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_52(macro, context, count, x, ...) macro(context, count - 52, x) HK_MACRO_FOR_EACH_51(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_53(macro, context, count, x, ...) macro(context, count - 53, x) HK_MACRO_FOR_EACH_52(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_54(macro, context, count, x, ...) macro(context, count - 54, x) HK_MACRO_FOR_EACH_53(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_55(macro, context, count, x, ...) macro(context, count - 55, x) HK_MACRO_FOR_EACH_54(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_56(macro, context, count, x, ...) macro(context, count - 56, x) HK_MACRO_FOR_EACH_55(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_57(macro, context, count, x, ...) macro(context, count - 57, x) HK_MACRO_FOR_EACH_56(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_58(macro, context, count, x, ...) macro(context, count - 58, x) HK_MACRO_FOR_EACH_57(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_59(macro, context, count, x, ...) macro(context, count - 59, x) HK_MACRO_FOR_EACH_58(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_60(macro, context, count, x, ...) macro(context, count - 60, x) HK_MACRO_FOR_EACH_59(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_61(macro, context, count, x, ...) macro(context, count - 61, x) HK_MACRO_FOR_EACH_60(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_62(macro, context, count, x, ...) macro(context, count - 62, x) HK_MACRO_FOR_EACH_61(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_63(macro, context, count, x, ...) macro(context, count - 63, x) HK_MACRO_FOR_EACH_62(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_64(macro, context, count, x, ...) macro(context, count - 64, x) HK_MACRO_FOR_EACH_63(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_65(macro, context, count, x, ...) macro(context, count - 65, x) HK_MACRO_FOR_EACH_64(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_66(macro, context, count, x, ...) macro(context, count - 66, x) HK_MACRO_FOR_EACH_65(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_67(macro, context, count, x, ...) macro(context, count - 67, x) HK_MACRO_FOR_EACH_66(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_68(macro, context, count, x, ...) macro(context, count - 68, x) HK_MACRO_FOR_EACH_67(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_69(macro, context, count, x, ...) macro(context, count - 69, x) HK_MACRO_FOR_EACH_68(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_70(macro, context, count, x, ...) macro(context, count - 70, x) HK_MACRO_FOR_EACH_69(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_71(macro, context, count, x, ...) macro(context, count - 71, x) HK_MACRO_FOR_EACH_70(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_72(macro, context, count, x, ...) macro(context, count - 72, x) HK_MACRO_FOR_EACH_71(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_73(macro, context, count, x, ...) macro(context, count - 73, x) HK_MACRO_FOR_EACH_72(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_74(macro, context, count, x, ...) macro(context, count - 74, x) HK_MACRO_FOR_EACH_73(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_75(macro, context, count, x, ...) macro(context, count - 75, x) HK_MACRO_FOR_EACH_74(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_76(macro, context, count, x, ...) macro(context, count - 76, x) HK_MACRO_FOR_EACH_75(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_77(macro, context, count, x, ...) macro(context, count - 77, x) HK_MACRO_FOR_EACH_76(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_78(macro, context, count, x, ...) macro(context, count - 78, x) HK_MACRO_FOR_EACH_77(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_79(macro, context, count, x, ...) macro(context, count - 79, x) HK_MACRO_FOR_EACH_78(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_80(macro, context, count, x, ...) macro(context, count - 80, x) HK_MACRO_FOR_EACH_79(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_81(macro, context, count, x, ...) macro(context, count - 81, x) HK_MACRO_FOR_EACH_80(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_82(macro, context, count, x, ...) macro(context, count - 82, x) HK_MACRO_FOR_EACH_81(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_83(macro, context, count, x, ...) macro(context, count - 83, x) HK_MACRO_FOR_EACH_82(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_84(macro, context, count, x, ...) macro(context, count - 84, x) HK_MACRO_FOR_EACH_83(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_85(macro, context, count, x, ...) macro(context, count - 85, x) HK_MACRO_FOR_EACH_84(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_86(macro, context, count, x, ...) macro(context, count - 86, x) HK_MACRO_FOR_EACH_85(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_87(macro, context, count, x, ...) macro(context, count - 87, x) HK_MACRO_FOR_EACH_86(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_88(macro, context, count, x, ...) macro(context, count - 88, x) HK_MACRO_FOR_EACH_87(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_89(macro, context, count, x, ...) macro(context, count - 89, x) HK_MACRO_FOR_EACH_88(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_90(macro, context, count, x, ...) macro(context, count - 90, x) HK_MACRO_FOR_EACH_89(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_91(macro, context, count, x, ...) macro(context, count - 91, x) HK_MACRO_FOR_EACH_90(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_92(macro, context, count, x, ...) macro(context, count - 92, x) HK_MACRO_FOR_EACH_91(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_93(macro, context, count, x, ...) macro(context, count - 93, x) HK_MACRO_FOR_EACH_92(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_94(macro, context, count, x, ...) macro(context, count - 94, x) HK_MACRO_FOR_EACH_93(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_95(macro, context, count, x, ...) macro(context, count - 95, x) HK_MACRO_FOR_EACH_94(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_96(macro, context, count, x, ...) macro(context, count - 96, x) HK_MACRO_FOR_EACH_95(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_97(macro, context, count, x, ...) macro(context, count - 97, x) HK_MACRO_FOR_EACH_96(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_98(macro, context, count, x, ...) macro(context, count - 98, x) HK_MACRO_FOR_EACH_97(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_99(macro, context, count, x, ...) macro(context, count - 99, x) HK_MACRO_FOR_EACH_98(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_100(macro, context, count, x, ...) macro(context, count - 100, x) HK_MACRO_FOR_EACH_99(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_101(macro, context, count, x, ...) macro(context, count - 101, x) HK_MACRO_FOR_EACH_100(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_102(macro, context, count, x, ...) macro(context, count - 102, x) HK_MACRO_FOR_EACH_101(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_103(macro, context, count, x, ...) macro(context, count - 103, x) HK_MACRO_FOR_EACH_102(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_104(macro, context, count, x, ...) macro(context, count - 104, x) HK_MACRO_FOR_EACH_103(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_105(macro, context, count, x, ...) macro(context, count - 105, x) HK_MACRO_FOR_EACH_104(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_106(macro, context, count, x, ...) macro(context, count - 106, x) HK_MACRO_FOR_EACH_105(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_107(macro, context, count, x, ...) macro(context, count - 107, x) HK_MACRO_FOR_EACH_106(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_108(macro, context, count, x, ...) macro(context, count - 108, x) HK_MACRO_FOR_EACH_107(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_109(macro, context, count, x, ...) macro(context, count - 109, x) HK_MACRO_FOR_EACH_108(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_110(macro, context, count, x, ...) macro(context, count - 110, x) HK_MACRO_FOR_EACH_109(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_111(macro, context, count, x, ...) macro(context, count - 111, x) HK_MACRO_FOR_EACH_110(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_112(macro, context, count, x, ...) macro(context, count - 112, x) HK_MACRO_FOR_EACH_111(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_113(macro, context, count, x, ...) macro(context, count - 113, x) HK_MACRO_FOR_EACH_112(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_114(macro, context, count, x, ...) macro(context, count - 114, x) HK_MACRO_FOR_EACH_113(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_115(macro, context, count, x, ...) macro(context, count - 115, x) HK_MACRO_FOR_EACH_114(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_116(macro, context, count, x, ...) macro(context, count - 116, x) HK_MACRO_FOR_EACH_115(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_117(macro, context, count, x, ...) macro(context, count - 117, x) HK_MACRO_FOR_EACH_116(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_118(macro, context, count, x, ...) macro(context, count - 118, x) HK_MACRO_FOR_EACH_117(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_119(macro, context, count, x, ...) macro(context, count - 119, x) HK_MACRO_FOR_EACH_118(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_120(macro, context, count, x, ...) macro(context, count - 120, x) HK_MACRO_FOR_EACH_119(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_121(macro, context, count, x, ...) macro(context, count - 121, x) HK_MACRO_FOR_EACH_120(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_122(macro, context, count, x, ...) macro(context, count - 122, x) HK_MACRO_FOR_EACH_121(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_123(macro, context, count, x, ...) macro(context, count - 123, x) HK_MACRO_FOR_EACH_122(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_124(macro, context, count, x, ...) macro(context, count - 124, x) HK_MACRO_FOR_EACH_123(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_125(macro, context, count, x, ...) macro(context, count - 125, x) HK_MACRO_FOR_EACH_124(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_126(macro, context, count, x, ...) macro(context, count - 126, x) HK_MACRO_FOR_EACH_125(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_127(macro, context, count, x, ...) macro(context, count - 127, x) HK_MACRO_FOR_EACH_126(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_128(macro, context, count, x, ...) macro(context, count - 128, x) HK_MACRO_FOR_EACH_127(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_129(macro, context, count, x, ...) macro(context, count - 129, x) HK_MACRO_FOR_EACH_128(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_130(macro, context, count, x, ...) macro(context, count - 130, x) HK_MACRO_FOR_EACH_129(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_131(macro, context, count, x, ...) macro(context, count - 131, x) HK_MACRO_FOR_EACH_130(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_132(macro, context, count, x, ...) macro(context, count - 132, x) HK_MACRO_FOR_EACH_131(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_133(macro, context, count, x, ...) macro(context, count - 133, x) HK_MACRO_FOR_EACH_132(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_134(macro, context, count, x, ...) macro(context, count - 134, x) HK_MACRO_FOR_EACH_133(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_135(macro, context, count, x, ...) macro(context, count - 135, x) HK_MACRO_FOR_EACH_134(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_136(macro, context, count, x, ...) macro(context, count - 136, x) HK_MACRO_FOR_EACH_135(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_137(macro, context, count, x, ...) macro(context, count - 137, x) HK_MACRO_FOR_EACH_136(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_138(macro, context, count, x, ...) macro(context, count - 138, x) HK_MACRO_FOR_EACH_137(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_139(macro, context, count, x, ...) macro(context, count - 139, x) HK_MACRO_FOR_EACH_138(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_140(macro, context, count, x, ...) macro(context, count - 140, x) HK_MACRO_FOR_EACH_139(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_141(macro, context, count, x, ...) macro(context, count - 141, x) HK_MACRO_FOR_EACH_140(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_142(macro, context, count, x, ...) macro(context, count - 142, x) HK_MACRO_FOR_EACH_141(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_143(macro, context, count, x, ...) macro(context, count - 143, x) HK_MACRO_FOR_EACH_142(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_144(macro, context, count, x, ...) macro(context, count - 144, x) HK_MACRO_FOR_EACH_143(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_145(macro, context, count, x, ...) macro(context, count - 145, x) HK_MACRO_FOR_EACH_144(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_146(macro, context, count, x, ...) macro(context, count - 146, x) HK_MACRO_FOR_EACH_145(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_147(macro, context, count, x, ...) macro(context, count - 147, x) HK_MACRO_FOR_EACH_146(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_148(macro, context, count, x, ...) macro(context, count - 148, x) HK_MACRO_FOR_EACH_147(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_149(macro, context, count, x, ...) macro(context, count - 149, x) HK_MACRO_FOR_EACH_148(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_150(macro, context, count, x, ...) macro(context, count - 150, x) HK_MACRO_FOR_EACH_149(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_151(macro, context, count, x, ...) macro(context, count - 151, x) HK_MACRO_FOR_EACH_150(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_152(macro, context, count, x, ...) macro(context, count - 152, x) HK_MACRO_FOR_EACH_151(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_153(macro, context, count, x, ...) macro(context, count - 153, x) HK_MACRO_FOR_EACH_152(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_154(macro, context, count, x, ...) macro(context, count - 154, x) HK_MACRO_FOR_EACH_153(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_155(macro, context, count, x, ...) macro(context, count - 155, x) HK_MACRO_FOR_EACH_154(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_156(macro, context, count, x, ...) macro(context, count - 156, x) HK_MACRO_FOR_EACH_155(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_157(macro, context, count, x, ...) macro(context, count - 157, x) HK_MACRO_FOR_EACH_156(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_158(macro, context, count, x, ...) macro(context, count - 158, x) HK_MACRO_FOR_EACH_157(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_159(macro, context, count, x, ...) macro(context, count - 159, x) HK_MACRO_FOR_EACH_158(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_160(macro, context, count, x, ...) macro(context, count - 160, x) HK_MACRO_FOR_EACH_159(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_161(macro, context, count, x, ...) macro(context, count - 161, x) HK_MACRO_FOR_EACH_160(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_162(macro, context, count, x, ...) macro(context, count - 162, x) HK_MACRO_FOR_EACH_161(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_163(macro, context, count, x, ...) macro(context, count - 163, x) HK_MACRO_FOR_EACH_162(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_164(macro, context, count, x, ...) macro(context, count - 164, x) HK_MACRO_FOR_EACH_163(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_165(macro, context, count, x, ...) macro(context, count - 165, x) HK_MACRO_FOR_EACH_164(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_166(macro, context, count, x, ...) macro(context, count - 166, x) HK_MACRO_FOR_EACH_165(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_167(macro, context, count, x, ...) macro(context, count - 167, x) HK_MACRO_FOR_EACH_166(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_168(macro, context, count, x, ...) macro(context, count - 168, x) HK_MACRO_FOR_EACH_167(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_169(macro, context, count, x, ...) macro(context, count - 169, x) HK_MACRO_FOR_EACH_168(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_170(macro, context, count, x, ...) macro(context, count - 170, x) HK_MACRO_FOR_EACH_169(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_171(macro, context, count, x, ...) macro(context, count - 171, x) HK_MACRO_FOR_EACH_170(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_172(macro, context, count, x, ...) macro(context, count - 172, x) HK_MACRO_FOR_EACH_171(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_173(macro, context, count, x, ...) macro(context, count - 173, x) HK_MACRO_FOR_EACH_172(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_174(macro, context, count, x, ...) macro(context, count - 174, x) HK_MACRO_FOR_EACH_173(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_175(macro, context, count, x, ...) macro(context, count - 175, x) HK_MACRO_FOR_EACH_174(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_176(macro, context, count, x, ...) macro(context, count - 176, x) HK_MACRO_FOR_EACH_175(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_177(macro, context, count, x, ...) macro(context, count - 177, x) HK_MACRO_FOR_EACH_176(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_178(macro, context, count, x, ...) macro(context, count - 178, x) HK_MACRO_FOR_EACH_177(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_179(macro, context, count, x, ...) macro(context, count - 179, x) HK_MACRO_FOR_EACH_178(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_180(macro, context, count, x, ...) macro(context, count - 180, x) HK_MACRO_FOR_EACH_179(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_181(macro, context, count, x, ...) macro(context, count - 181, x) HK_MACRO_FOR_EACH_180(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_182(macro, context, count, x, ...) macro(context, count - 182, x) HK_MACRO_FOR_EACH_181(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_183(macro, context, count, x, ...) macro(context, count - 183, x) HK_MACRO_FOR_EACH_182(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_184(macro, context, count, x, ...) macro(context, count - 184, x) HK_MACRO_FOR_EACH_183(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_185(macro, context, count, x, ...) macro(context, count - 185, x) HK_MACRO_FOR_EACH_184(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_186(macro, context, count, x, ...) macro(context, count - 186, x) HK_MACRO_FOR_EACH_185(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_187(macro, context, count, x, ...) macro(context, count - 187, x) HK_MACRO_FOR_EACH_186(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_188(macro, context, count, x, ...) macro(context, count - 188, x) HK_MACRO_FOR_EACH_187(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_189(macro, context, count, x, ...) macro(context, count - 189, x) HK_MACRO_FOR_EACH_188(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_190(macro, context, count, x, ...) macro(context, count - 190, x) HK_MACRO_FOR_EACH_189(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_191(macro, context, count, x, ...) macro(context, count - 191, x) HK_MACRO_FOR_EACH_190(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_192(macro, context, count, x, ...) macro(context, count - 192, x) HK_MACRO_FOR_EACH_191(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_193(macro, context, count, x, ...) macro(context, count - 193, x) HK_MACRO_FOR_EACH_192(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_194(macro, context, count, x, ...) macro(context, count - 194, x) HK_MACRO_FOR_EACH_193(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_195(macro, context, count, x, ...) macro(context, count - 195, x) HK_MACRO_FOR_EACH_194(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_196(macro, context, count, x, ...) macro(context, count - 196, x) HK_MACRO_FOR_EACH_195(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_197(macro, context, count, x, ...) macro(context, count - 197, x) HK_MACRO_FOR_EACH_196(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_198(macro, context, count, x, ...) macro(context, count - 198, x) HK_MACRO_FOR_EACH_197(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_199(macro, context, count, x, ...) macro(context, count - 199, x) HK_MACRO_FOR_EACH_198(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_200(macro, context, count, x, ...) macro(context, count - 200, x) HK_MACRO_FOR_EACH_199(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_201(macro, context, count, x, ...) macro(context, count - 201, x) HK_MACRO_FOR_EACH_200(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_202(macro, context, count, x, ...) macro(context, count - 202, x) HK_MACRO_FOR_EACH_201(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_203(macro, context, count, x, ...) macro(context, count - 203, x) HK_MACRO_FOR_EACH_202(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_204(macro, context, count, x, ...) macro(context, count - 204, x) HK_MACRO_FOR_EACH_203(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_205(macro, context, count, x, ...) macro(context, count - 205, x) HK_MACRO_FOR_EACH_204(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_206(macro, context, count, x, ...) macro(context, count - 206, x) HK_MACRO_FOR_EACH_205(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_207(macro, context, count, x, ...) macro(context, count - 207, x) HK_MACRO_FOR_EACH_206(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_208(macro, context, count, x, ...) macro(context, count - 208, x) HK_MACRO_FOR_EACH_207(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_209(macro, context, count, x, ...) macro(context, count - 209, x) HK_MACRO_FOR_EACH_208(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_210(macro, context, count, x, ...) macro(context, count - 210, x) HK_MACRO_FOR_EACH_209(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_211(macro, context, count, x, ...) macro(context, count - 211, x) HK_MACRO_FOR_EACH_210(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_212(macro, context, count, x, ...) macro(context, count - 212, x) HK_MACRO_FOR_EACH_211(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_213(macro, context, count, x, ...) macro(context, count - 213, x) HK_MACRO_FOR_EACH_212(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_214(macro, context, count, x, ...) macro(context, count - 214, x) HK_MACRO_FOR_EACH_213(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_215(macro, context, count, x, ...) macro(context, count - 215, x) HK_MACRO_FOR_EACH_214(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_216(macro, context, count, x, ...) macro(context, count - 216, x) HK_MACRO_FOR_EACH_215(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_217(macro, context, count, x, ...) macro(context, count - 217, x) HK_MACRO_FOR_EACH_216(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_218(macro, context, count, x, ...) macro(context, count - 218, x) HK_MACRO_FOR_EACH_217(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_219(macro, context, count, x, ...) macro(context, count - 219, x) HK_MACRO_FOR_EACH_218(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_220(macro, context, count, x, ...) macro(context, count - 220, x) HK_MACRO_FOR_EACH_219(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_221(macro, context, count, x, ...) macro(context, count - 221, x) HK_MACRO_FOR_EACH_220(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_222(macro, context, count, x, ...) macro(context, count - 222, x) HK_MACRO_FOR_EACH_221(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_223(macro, context, count, x, ...) macro(context, count - 223, x) HK_MACRO_FOR_EACH_222(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_224(macro, context, count, x, ...) macro(context, count - 224, x) HK_MACRO_FOR_EACH_223(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_225(macro, context, count, x, ...) macro(context, count - 225, x) HK_MACRO_FOR_EACH_224(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_226(macro, context, count, x, ...) macro(context, count - 226, x) HK_MACRO_FOR_EACH_225(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_227(macro, context, count, x, ...) macro(context, count - 227, x) HK_MACRO_FOR_EACH_226(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_228(macro, context, count, x, ...) macro(context, count - 228, x) HK_MACRO_FOR_EACH_227(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_229(macro, context, count, x, ...) macro(context, count - 229, x) HK_MACRO_FOR_EACH_228(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_230(macro, context, count, x, ...) macro(context, count - 230, x) HK_MACRO_FOR_EACH_229(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_231(macro, context, count, x, ...) macro(context, count - 231, x) HK_MACRO_FOR_EACH_230(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_232(macro, context, count, x, ...) macro(context, count - 232, x) HK_MACRO_FOR_EACH_231(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_233(macro, context, count, x, ...) macro(context, count - 233, x) HK_MACRO_FOR_EACH_232(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_234(macro, context, count, x, ...) macro(context, count - 234, x) HK_MACRO_FOR_EACH_233(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_235(macro, context, count, x, ...) macro(context, count - 235, x) HK_MACRO_FOR_EACH_234(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_236(macro, context, count, x, ...) macro(context, count - 236, x) HK_MACRO_FOR_EACH_235(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_237(macro, context, count, x, ...) macro(context, count - 237, x) HK_MACRO_FOR_EACH_236(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_238(macro, context, count, x, ...) macro(context, count - 238, x) HK_MACRO_FOR_EACH_237(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_239(macro, context, count, x, ...) macro(context, count - 239, x) HK_MACRO_FOR_EACH_238(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_240(macro, context, count, x, ...) macro(context, count - 240, x) HK_MACRO_FOR_EACH_239(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_241(macro, context, count, x, ...) macro(context, count - 241, x) HK_MACRO_FOR_EACH_240(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_242(macro, context, count, x, ...) macro(context, count - 242, x) HK_MACRO_FOR_EACH_241(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_243(macro, context, count, x, ...) macro(context, count - 243, x) HK_MACRO_FOR_EACH_242(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_244(macro, context, count, x, ...) macro(context, count - 244, x) HK_MACRO_FOR_EACH_243(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_245(macro, context, count, x, ...) macro(context, count - 245, x) HK_MACRO_FOR_EACH_244(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_246(macro, context, count, x, ...) macro(context, count - 246, x) HK_MACRO_FOR_EACH_245(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_247(macro, context, count, x, ...) macro(context, count - 247, x) HK_MACRO_FOR_EACH_246(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_248(macro, context, count, x, ...) macro(context, count - 248, x) HK_MACRO_FOR_EACH_247(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_249(macro, context, count, x, ...) macro(context, count - 249, x) HK_MACRO_FOR_EACH_248(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_250(macro, context, count, x, ...) macro(context, count - 250, x) HK_MACRO_FOR_EACH_249(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_251(macro, context, count, x, ...) macro(context, count - 251, x) HK_MACRO_FOR_EACH_250(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_252(macro, context, count, x, ...) macro(context, count - 252, x) HK_MACRO_FOR_EACH_251(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_253(macro, context, count, x, ...) macro(context, count - 253, x) HK_MACRO_FOR_EACH_252(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_254(macro, context, count, x, ...) macro(context, count - 254, x) HK_MACRO_FOR_EACH_253(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_255(macro, context, count, x, ...) macro(context, count - 255, x) HK_MACRO_FOR_EACH_254(macro, context, count, __VA_ARGS__)
+#define HK_MACRO_FOR_EACH_256(macro, context, count, x, ...) macro(context, count - 256, x) HK_MACRO_FOR_EACH_255(macro, context, count, __VA_ARGS__)
+
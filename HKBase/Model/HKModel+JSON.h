@@ -0,0 +1,158 @@
+//
+//  HKModel+JSON.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModel.h"
+#import "HKArray.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ error domain of JSON decoding
+ */
+OBJC_EXTERN NSString *const HKJSONErrorDomain;
+
+/**
+ error code in HKJSONErrorDomain
+
+ - HKJSONErrorUnexpectedCharacter: unexpected character in JSON
+ - HKJSONErrorUnexpectedEnd: JSON is terminated in value
+ - HKJSONErrorInvalidString: invalid string (control character, escape or UTF-8)
+ - HKJSONErrorInvalidNumber: invalid number format
+ - HKJSONErrorTooDeep: nesting is deeper than limit
+ - HKJSONErrorTypeMismatch: top level value is not matched with model (object or array)
+ - HKJSONErrorCancelled: current progress (NSProgress.currentProgress) is cancelled while decoding
+ */
+typedef NS_ENUM(NSInteger, HKJSONError) {
+    HKJSONErrorUnexpectedCharacter = 1,
+    HKJSONErrorUnexpectedEnd,
+    HKJSONErrorInvalidString,
+    HKJSONErrorInvalidNumber,
+    HKJSONErrorTooDeep,
+    HKJSONErrorTypeMismatch,
+    HKJSONErrorCancelled,
+};
+
+/**
+ decode JSON into model directly and encode model into JSON directly
+ values are set to properties while reading (without NSJSONSerialization)
+ only unknown subtree (ex. NSDictionary property) are made as Foundation objects
+ decoding reports read bytes to current progress (NSProgress.currentProgress) and stops if it is cancelled
+ */
+@interface HKModel (JSON)
+
+/**
+ initialize model from JSON data
+
+ @param data JSON data (UTF-8)
+ @param error error (in HKJSONErrorDomain)
+ @return model object
+ */
++ (nullable instancetype)modelWithJSONData:(NSData *)data error:(NSError * _Nullable * _Nullable)error;
+/**
+ initialize model from JSON bytes
+
+ @param bytes JSON bytes (UTF-8)
+ @param length length of bytes
+ @param error error (in HKJSONErrorDomain)
+ @return model object
+ */
++ (nullable instancetype)modelWithJSONBytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ JSON data of model (written directly without serializedObject and NSJSONSerialization)
+ */
+@property (nonatomic, readonly, nullable) NSData *JSONData;
+/**
+ append JSON of model to data
+
+ @param data data for append
+ @param error error (in HKJSONErrorDomain)
+ @return success
+ */
+- (BOOL)writeJSONToData:(NSMutableData *)data error:(NSError * _Nullable * _Nullable)error;
+/**
+ write JSON of model to file descriptor (buffered)
+
+ @param fileDescriptor file descriptor (ex. opened cache file)
+ @param error error (in HKJSONErrorDomain or NSPOSIXErrorDomain)
+ @return success
+ */
+- (BOOL)writeJSONToFileDescriptor:(int)fileDescriptor error:(NSError * _Nullable * _Nullable)error;
+
+@end
+
+/**
+ decode JSON array into model array directly
+ */
+@interface HKArray<ObjectType> (JSON)
+
+/**
+ initialize model array from JSON data
+
+ @param data JSON data (UTF-8)
+ @param error error (in HKJSONErrorDomain)
+ @return model array
+ */
++ (nullable instancetype)modelWithJSONData:(NSData *)data error:(NSError * _Nullable * _Nullable)error;
+/**
+ initialize model array from JSON bytes
+
+ @param bytes JSON bytes (UTF-8)
+ @param length length of bytes
+ @param error error (in HKJSONErrorDomain)
+ @return model array
+ */
++ (nullable instancetype)modelWithJSONBytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable * _Nullable)error;
+
+@end
+
+/**
+ encode array (ex. HKArray) into JSON directly
+ */
+@interface NSArray (JSON)
+
+/**
+ JSON data of array (written directly without serializedObject and NSJSONSerialization)
+ */
+@property (nonatomic, readonly, nullable) NSData *JSONData;
+/**
+ append JSON of array to data
+
+ @param data data for append
+ @param error error (in HKJSONErrorDomain)
+ @return success
+ */
+- (BOOL)writeJSONToData:(NSMutableData *)data error:(NSError * _Nullable * _Nullable)error;
+/**
+ write JSON of array to file descriptor (buffered)
+
+ @param fileDescriptor file descriptor (ex. opened cache file)
+ @param error error (in HKJSONErrorDomain or NSPOSIXErrorDomain)
+ @return success
+ */
+- (BOOL)writeJSONToFileDescriptor:(int)fileDescriptor error:(NSError * _Nullable * _Nullable)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
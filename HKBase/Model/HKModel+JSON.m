@@ -0,0 +1,1330 @@
+//
+//  HKModel+JSON.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModel+JSON.h"
+#import "HKModelPlan.h"
+#import "HKModelDecodeContext.h"
+#import "HKModelDecodeSession.h"
+#import "HKModelNumber.h"
+#import "HKModelDate.h"
+#import "HKModelBase64.h"
+#import "HKEnum.h"
+#import "HKOption.h"
+#import <unistd.h>
+#import <xlocale.h>
+
+NSString *const HKJSONErrorDomain = @"HKJSONErrorDomain";
+
+static const NSInteger kHKJSONMaximumDepth = 512;
+static const size_t kHKJSONWriterFlushLength = 64 * 1024;
+static const size_t kHKJSONProgressInterval = 64 * 1024;       // bytes read between progress updates
+
+#pragma mark - reader
+typedef struct _HKJSONReader {
+    const uint8_t *start;
+    const uint8_t *cursor;
+    const uint8_t *end;
+    NSInteger depth;
+    
+    char *buffer;               // unescaped string (reused for every string)
+    size_t capacity;
+    __unsafe_unretained HKModelDecodeContext *context;    // intern table (nil if not in context)
+    __unsafe_unretained NSProgress *progress;             // child of current progress (nil if there is no current progress)
+    const uint8_t *checkpoint;                            // next position to update progress
+    
+    HKJSONError error;          // 0 if no error
+    const uint8_t *errorPosition;
+} HKJSONReader;
+
+typedef struct _HKJSONNumber {
+    BOOL isInteger;
+    BOOL isNegative;
+    unsigned long long integer; // absolute value
+    double real;
+} HKJSONNumber;
+
+static void HKJSONReaderInitialize(HKJSONReader *reader, const void *bytes, NSUInteger length) {
+    memset(reader, 0, sizeof(HKJSONReader));
+    reader->start = bytes;
+    reader->cursor = bytes;
+    reader->end = reader->start + length;
+    
+    // skip UTF-8 BOM
+    if (length >= 3 && memcmp(bytes, "\xEF\xBB\xBF", 3) == 0) {
+        reader->cursor += 3;
+    }
+    
+    // string buffer of previous decoding in session
+    reader->buffer = HKModelArenaAllocate(0, &reader->capacity);
+}
+
+static inline void HKJSONFail(HKJSONReader *reader, HKJSONError error) {
+    if (!reader->error) {
+        reader->error = error;
+        reader->errorPosition = reader->cursor;
+    }
+}
+
+static inline void HKJSONFailUnexpected(HKJSONReader *reader) {
+    HKJSONFail(reader, reader->cursor < reader->end ? HKJSONErrorUnexpectedCharacter : HKJSONErrorUnexpectedEnd);
+}
+
+/**
+ update progress by read bytes (every kHKJSONProgressInterval), fail if progress is cancelled
+ */
+static inline BOOL HKJSONCheckProgress(HKJSONReader *reader) {
+    if (!reader->progress || reader->cursor < reader->checkpoint) {
+        return YES;
+    }
+    reader->checkpoint = reader->cursor + kHKJSONProgressInterval;
+    reader->progress.completedUnitCount = (int64_t)(reader->cursor - reader->start);
+    if (reader->progress.isCancelled) {
+        HKJSONFail(reader, HKJSONErrorCancelled);
+        return NO;
+    }
+    return YES;
+}
+
+/**
+ skip whitespace and return next character (0 if end)
+ */
+static inline uint8_t HKJSONPeek(HKJSONReader *reader) {
+    const uint8_t *cursor = reader->cursor;
+    const uint8_t *end = reader->end;
+    while (cursor < end && (*cursor == ' ' || *cursor == '\n' || *cursor == '\r' || *cursor == '\t')) {
+        cursor++;
+    }
+    reader->cursor = cursor;
+    return cursor < end ? *cursor : 0;
+}
+
+static inline BOOL HKJSONConsume(HKJSONReader *reader, uint8_t character) {
+    if (HKJSONPeek(reader) == character) {
+        reader->cursor++;
+        return YES;
+    }
+    return NO;
+}
+
+static inline BOOL HKJSONExpect(HKJSONReader *reader, uint8_t character) {
+    if (!HKJSONConsume(reader, character)) {
+        HKJSONFailUnexpected(reader);
+        return NO;
+    }
+    return YES;
+}
+
+static BOOL HKJSONReadLiteral(HKJSONReader *reader, const char *literal, size_t length) {
+    if ((size_t)(reader->end - reader->cursor) >= length && memcmp(reader->cursor, literal, length) == 0) {
+        reader->cursor += length;
+        return YES;
+    }
+    HKJSONFailUnexpected(reader);
+    return NO;
+}
+
+static inline BOOL HKJSONEnter(HKJSONReader *reader) {
+    if (++reader->depth > kHKJSONMaximumDepth) {
+        HKJSONFail(reader, HKJSONErrorTooDeep);
+        return NO;
+    }
+    reader->cursor++;
+    return YES;
+}
+
+#pragma mark - string
+static inline void HKJSONReserve(HKJSONReader *reader, size_t length) {
+    if (length > reader->capacity) {
+        size_t capacity = MAX(reader->capacity * 2, MAX(length, 64));
+        reader->buffer = realloc(reader->buffer, capacity);
+        reader->capacity = capacity;
+    }
+}
+
+static inline int HKJSONHexValue(uint8_t character) {
+    if (character >= '0' && character <= '9') {
+        return character - '0';
+    } else if (character >= 'a' && character <= 'f') {
+        return character - 'a' + 10;
+    } else if (character >= 'A' && character <= 'F') {
+        return character - 'A' + 10;
+    }
+    return -1;
+}
+
+// read 4 hex digits after "\u"
+static BOOL HKJSONReadHex4(const uint8_t **cursor, const uint8_t *end, uint32_t *value) {
+    if (end - *cursor < 4) {
+        return NO;
+    }
+    uint32_t result = 0;
+    for (NSInteger index = 0; index < 4; index++) {
+        int hex = HKJSONHexValue((*cursor)[index]);
+        if (hex < 0) {
+            return NO;
+        }
+        result = (result << 4) | (uint32_t)hex;
+    }
+    *cursor += 4;
+    *value = result;
+    return YES;
+}
+
+static inline size_t HKJSONEncodeUTF8(uint32_t code, char *output) {
+    if (code < 0x80) {
+        output[0] = (char)code;
+        return 1;
+    } else if (code < 0x800) {
+        output[0] = (char)(0xC0 | (code >> 6));
+        output[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    } else if (code < 0x10000) {
+        output[0] = (char)(0xE0 | (code >> 12));
+        output[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        output[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+    output[0] = (char)(0xF0 | (code >> 18));
+    output[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    output[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    output[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+/**
+ read string token (cursor is at '"')
+ result bytes point into JSON if there is no escape, or into reader buffer (valid until next string)
+ */
+static BOOL HKJSONReadStringBytes(HKJSONReader *reader, const char **bytes, size_t *length) {
+    const uint8_t *start = reader->cursor + 1;
+    const uint8_t *cursor = start;
+    const uint8_t *end = reader->end;
+    while (cursor < end && *cursor != '"' && *cursor != '\\' && *cursor >= 0x20) {
+        cursor++;
+    }
+    
+    if (cursor < end && *cursor == '"') {
+        *bytes = (const char *)start;
+        *length = (size_t)(cursor - start);
+        reader->cursor = cursor + 1;
+        return YES;
+    }
+    
+    // has escape: unescape into buffer
+    size_t used = (size_t)(cursor - start);
+    HKJSONReserve(reader, used + 16);
+    memcpy(reader->buffer, start, used);
+    while (cursor < end && *cursor != '"') {
+        HKJSONReserve(reader, used + 8);
+        uint8_t character = *cursor;
+        if (character < 0x20) {
+            reader->cursor = cursor;
+            HKJSONFail(reader, HKJSONErrorInvalidString);
+            return NO;
+        } else if (character != '\\') {
+            reader->buffer[used++] = (char)character;
+            cursor++;
+            continue;
+        }
+        
+        if (++cursor >= end) {
+            break;
+        }
+        switch (*cursor++) {
+            case '"':   reader->buffer[used++] = '"';     break;
+            case '\\':  reader->buffer[used++] = '\\';    break;
+            case '/':   reader->buffer[used++] = '/';     break;
+            case 'b':   reader->buffer[used++] = '\b';    break;
+            case 'f':   reader->buffer[used++] = '\f';    break;
+            case 'n':   reader->buffer[used++] = '\n';    break;
+            case 'r':   reader->buffer[used++] = '\r';    break;
+            case 't':   reader->buffer[used++] = '\t';    break;
+            case 'u': {
+                uint32_t code = 0;
+                if (!HKJSONReadHex4(&cursor, end, &code)) {
+                    reader->cursor = cursor;
+                    HKJSONFail(reader, HKJSONErrorInvalidString);
+                    return NO;
+                }
+                if (code >= 0xD800 && code < 0xDC00) {
+                    // surrogate pair
+                    uint32_t low = 0;
+                    const uint8_t *next = cursor + 2;
+                    if (end - cursor >= 6 && cursor[0] == '\\' && cursor[1] == 'u' && HKJSONReadHex4(&next, end, &low) && low >= 0xDC00 && low < 0xE000) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        cursor = next;
+                    } else {
+                        code = 0xFFFD;
+                    }
+                } else if (code >= 0xDC00 && code < 0xE000) {
+                    code = 0xFFFD;
+                }
+                used += HKJSONEncodeUTF8(code, reader->buffer + used);
+                break;
+            }
+            default:
+                reader->cursor = cursor - 1;
+                HKJSONFail(reader, HKJSONErrorInvalidString);
+                return NO;
+        }
+    }
+    
+    if (cursor >= end) {
+        reader->cursor = end;
+        HKJSONFail(reader, HKJSONErrorUnexpectedEnd);
+        return NO;
+    }
+    
+    *bytes = reader->buffer;
+    *length = used;
+    reader->cursor = cursor + 1;
+    return YES;
+}
+
+static NSString *HKJSONReadString(HKJSONReader *reader) {
+    const uint8_t *position = reader->cursor;
+    const char *bytes = NULL;
+    size_t length = 0;
+    if (!HKJSONReadStringBytes(reader, &bytes, &length)) {
+        return nil;
+    }
+    
+    NSString *result = reader->context ? [reader->context internedStringWithUTF8Bytes:bytes length:length] : [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    if (!result) {
+        reader->cursor = position;
+        HKJSONFail(reader, HKJSONErrorInvalidString);
+    }
+    return result;
+}
+
+#pragma mark - number
+static BOOL HKJSONReadNumber(HKJSONReader *reader, HKJSONNumber *number) {
+    const uint8_t *start = reader->cursor;
+    const uint8_t *cursor = start;
+    const uint8_t *end = reader->end;
+    
+    BOOL isNegative = NO;
+    if (cursor < end && *cursor == '-') {
+        isNegative = YES;
+        cursor++;
+    }
+    if (cursor >= end || *cursor < '0' || *cursor > '9') {
+        reader->cursor = cursor;
+        HKJSONFail(reader, HKJSONErrorInvalidNumber);
+        return NO;
+    }
+    
+    unsigned long long integer = 0;
+    BOOL isOverflow = NO;
+    if (*cursor == '0') {
+        cursor++;
+    } else {
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            unsigned int digit = *cursor++ - '0';
+            if (integer > (ULLONG_MAX - digit) / 10) {
+                isOverflow = YES;
+            } else {
+                integer = integer * 10 + digit;
+            }
+        }
+    }
+    
+    BOOL isInteger = YES;
+    if (cursor < end && *cursor == '.') {
+        isInteger = NO;
+        if (++cursor >= end || *cursor < '0' || *cursor > '9') {
+            reader->cursor = cursor;
+            HKJSONFail(reader, HKJSONErrorInvalidNumber);
+            return NO;
+        }
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            cursor++;
+        }
+    }
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        isInteger = NO;
+        if (++cursor < end && (*cursor == '+' || *cursor == '-')) {
+            cursor++;
+        }
+        if (cursor >= end || *cursor < '0' || *cursor > '9') {
+            reader->cursor = cursor;
+            HKJSONFail(reader, HKJSONErrorInvalidNumber);
+            return NO;
+        }
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            cursor++;
+        }
+    }
+    reader->cursor = cursor;
+    
+    if (isInteger && !isOverflow && (!isNegative || integer <= (unsigned long long)LLONG_MAX + 1)) {
+        number->isInteger = YES;
+        number->isNegative = isNegative;
+        number->integer = integer;
+    } else {
+        HKModelNumber parsed;
+        HKModelNumberParse((const char *)start, (NSUInteger)(cursor - start), &parsed);
+        number->isInteger = NO;
+        number->isNegative = isNegative;
+        number->real = parsed.real;
+    }
+    return YES;
+}
+
+static inline long long HKJSONNegativeInteger(unsigned long long integer) {
+    return integer ? -(long long)(integer - 1) - 1 : 0;
+}
+
+static NSNumber *HKJSONNumberObject(const HKJSONNumber *number) {
+    if (!number->isInteger) {
+        return @(number->real);
+    } else if (number->isNegative) {
+        return @(HKJSONNegativeInteger(number->integer));
+    } else if (number->integer > LLONG_MAX) {
+        return @(number->integer);
+    }
+    return @((long long)number->integer);
+}
+
+static inline void HKJSONSetNumber(id model, const HKModelSlot *slot, const HKJSONNumber *number) {
+    if (!number->isInteger) {
+        HKModelSlotSetDouble(model, slot, number->real);
+    } else if (number->isNegative) {
+        HKModelSlotSetLongLong(model, slot, HKJSONNegativeInteger(number->integer));
+    } else {
+        HKModelSlotSetUnsignedLongLong(model, slot, number->integer);
+    }
+}
+
+#pragma mark - value
+static id HKJSONReadObject(HKJSONReader *reader);
+static id HKJSONReadModel(HKJSONReader *reader, __unsafe_unretained Class modelClass);
+static id HKJSONReadArray(HKJSONReader *reader, __unsafe_unretained Class arrayClass);
+
+/**
+ skip value without making object
+ */
+static void HKJSONSkipValue(HKJSONReader *reader) {
+    switch (HKJSONPeek(reader)) {
+        case '{':
+            if (!HKJSONEnter(reader)) {
+                return;
+            }
+            if (!HKJSONConsume(reader, '}')) {
+                do {
+                    const char *bytes = NULL;
+                    size_t length = 0;
+                    if (HKJSONPeek(reader) != '"') {
+                        HKJSONFailUnexpected(reader);
+                        return;
+                    }
+                    if (!HKJSONReadStringBytes(reader, &bytes, &length) || !HKJSONExpect(reader, ':')) {
+                        return;
+                    }
+                    HKJSONSkipValue(reader);
+                    if (reader->error) {
+                        return;
+                    }
+                } while (HKJSONConsume(reader, ','));
+                if (!HKJSONExpect(reader, '}')) {
+                    return;
+                }
+            }
+            reader->depth--;
+            break;
+        case '[':
+            if (!HKJSONEnter(reader)) {
+                return;
+            }
+            if (!HKJSONConsume(reader, ']')) {
+                do {
+                    HKJSONSkipValue(reader);
+                    if (reader->error) {
+                        return;
+                    }
+                } while (HKJSONConsume(reader, ','));
+                if (!HKJSONExpect(reader, ']')) {
+                    return;
+                }
+            }
+            reader->depth--;
+            break;
+        case '"': {
+            const char *bytes = NULL;
+            size_t length = 0;
+            HKJSONReadStringBytes(reader, &bytes, &length);
+            break;
+        }
+        case 't':
+            HKJSONReadLiteral(reader, "true", 4);
+            break;
+        case 'f':
+            HKJSONReadLiteral(reader, "false", 5);
+            break;
+        case 'n':
+            HKJSONReadLiteral(reader, "null", 4);
+            break;
+        default: {
+            HKJSONNumber number;
+            HKJSONReadNumber(reader, &number);
+            break;
+        }
+    }
+}
+
+/**
+ read value as Foundation object (same as NSJSONSerialization)
+ */
+static id HKJSONReadObject(HKJSONReader *reader) {
+    switch (HKJSONPeek(reader)) {
+        case '{': {
+            if (!HKJSONEnter(reader)) {
+                return nil;
+            }
+            NSMutableDictionary<NSString *, id> *result = [NSMutableDictionary dictionary];
+            if (!HKJSONConsume(reader, '}')) {
+                do {
+                    if (HKJSONPeek(reader) != '"') {
+                        HKJSONFailUnexpected(reader);
+                        return nil;
+                    }
+                    NSString *key = HKJSONReadString(reader);
+                    if (!key || !HKJSONExpect(reader, ':')) {
+                        return nil;
+                    }
+                    id value = HKJSONReadObject(reader);
+                    if (!value) {
+                        return nil;
+                    }
+                    result[key] = value;
+                } while (HKJSONConsume(reader, ','));
+                if (!HKJSONExpect(reader, '}')) {
+                    return nil;
+                }
+            }
+            reader->depth--;
+            return result;
+        }
+        case '[': {
+            if (!HKJSONEnter(reader)) {
+                return nil;
+            }
+            NSMutableArray<id> *result = [NSMutableArray array];
+            if (!HKJSONConsume(reader, ']')) {
+                do {
+                    id value = HKJSONReadObject(reader);
+                    if (!value) {
+                        return nil;
+                    }
+                    [result addObject:value];
+                } while (HKJSONConsume(reader, ','));
+                if (!HKJSONExpect(reader, ']')) {
+                    return nil;
+                }
+            }
+            reader->depth--;
+            return result;
+        }
+        case '"':
+            return HKJSONReadString(reader);
+        case 't':
+            return HKJSONReadLiteral(reader, "true", 4) ? @YES : nil;
+        case 'f':
+            return HKJSONReadLiteral(reader, "false", 5) ? @NO : nil;
+        case 'n':
+            return HKJSONReadLiteral(reader, "null", 4) ? NSNull.null : nil;
+        case '-': case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': {
+            HKJSONNumber number;
+            return HKJSONReadNumber(reader, &number) ? HKJSONNumberObject(&number) : nil;
+        }
+        default:
+            HKJSONFailUnexpected(reader);
+            return nil;
+    }
+}
+
+/**
+ read value of property and set to model
+ */
+static void HKJSONReadSlot(HKJSONReader *reader, id model, const HKModelSlot *slot) {
+    uint8_t character = HKJSONPeek(reader);
+    if (character == 'n') {
+        HKJSONReadLiteral(reader, "null", 4);
+        return;
+    }
+    
+    id value = nil;
+    switch (slot->type) {
+        case HKModelSlotTypeModel:
+            switch (slot->classKind) {
+                case HKModelSlotClassKindModel:
+                    value = HKJSONReadModel(reader, slot->propertyClass);
+                    break;
+                case HKModelSlotClassKindArray:
+                    value = HKJSONReadArray(reader, slot->propertyClass);
+                    break;
+                case HKModelSlotClassKindString:
+                    value = character == '"' ? HKJSONReadString(reader) : [NSString modelWithSerializedObject:HKJSONReadObject(reader)];
+                    break;
+                case HKModelSlotClassKindData:
+                    if (slot->isBase64 && character == '"') {
+                        // Base64 is decoded from JSON bytes into data buffer without string object
+                        const char *bytes = NULL;
+                        size_t length = 0;
+                        if (HKJSONReadStringBytes(reader, &bytes, &length)) {
+                            value = HKModelBase64DataWithBytes(bytes, length);
+                        }
+                    } else {
+                        id object = HKJSONReadObject(reader);
+                        value = object ? [NSData modelWithSerializedObject:object] : nil;
+                    }
+                    break;
+                case HKModelSlotClassKindDate:
+                    if (character == '"') {
+                        // ISO 8601 is parsed without string object
+                        const char *bytes = NULL;
+                        size_t length = 0;
+                        NSTimeInterval timeInterval = 0;
+                        if (HKJSONReadStringBytes(reader, &bytes, &length)) {
+                            HKModelNumber number;
+                            if (HKModelDateParseISO8601(bytes, length, &timeInterval)) {
+                                value = [NSDate dateWithTimeIntervalSince1970:timeInterval];
+                            } else if (length && HKModelNumberParse(bytes, length, &number) == length) {
+                                // epoch in string (whole string, ex. "12abc" is not date)
+                                value = [NSDate dateWithTimeIntervalSince1970:HKModelDateTimeIntervalWithEpoch(number.real)];
+                            }
+                        }
+                    } else if (character == '-' || (character >= '0' && character <= '9')) {
+                        HKJSONNumber number;
+                        if (HKJSONReadNumber(reader, &number)) {
+                            double epoch = number.isInteger ? (number.isNegative ? -(double)number.integer : (double)number.integer) : number.real;
+                            value = [NSDate dateWithTimeIntervalSince1970:HKModelDateTimeIntervalWithEpoch(epoch)];
+                        }
+                    } else {
+                        HKJSONSkipValue(reader);
+                    }
+                    break;
+                case HKModelSlotClassKindEnum:
+                case HKModelSlotClassKindOption:
+                    if (character == '-' || (character >= '0' && character <= '9')) {
+                        HKJSONNumber number;
+                        if (HKJSONReadNumber(reader, &number)) {
+                            NSInteger enumValue = number.isInteger ? (number.isNegative ? (NSInteger)HKJSONNegativeInteger(number.integer) : (NSInteger)number.integer) : (NSInteger)number.real;
+                            value = slot->classKind == HKModelSlotClassKindEnum ? [slot->propertyClass enumWithValue:enumValue] : [slot->propertyClass optionWithValue:enumValue];
+                        }
+                        break;
+                    }
+                    // fall through (ex. string value)
+                default: {
+                    id object = HKJSONReadObject(reader);
+                    value = object ? [slot->propertyClass modelWithSerializedObject:object] : nil;
+                    break;
+                }
+            }
+            if (!reader->error && value) {
+                HKModelSlotSetObject(model, slot, value);
+            }
+            break;
+        case HKModelSlotTypeObject:
+            value = HKJSONReadObject(reader);
+            if (value) {
+                HKModelSlotSetObject(model, slot, value);
+            }
+            break;
+        case HKModelSlotTypeBool:
+        case HKModelSlotTypeChar:
+        case HKModelSlotTypeUnsignedChar:
+        case HKModelSlotTypeShort:
+        case HKModelSlotTypeUnsignedShort:
+        case HKModelSlotTypeInt:
+        case HKModelSlotTypeUnsignedInt:
+        case HKModelSlotTypeLong:
+        case HKModelSlotTypeUnsignedLong:
+        case HKModelSlotTypeLongLong:
+        case HKModelSlotTypeUnsignedLongLong:
+        case HKModelSlotTypeFloat:
+        case HKModelSlotTypeDouble:
+            if (character == '"' && slot->type != HKModelSlotTypeBool && slot->type != HKModelSlotTypeChar) {
+                // string encoded number is parsed without string object
+                const char *bytes = NULL;
+                size_t length = 0;
+                if (HKJSONReadStringBytes(reader, &bytes, &length)) {
+                    HKModelSlotSetNumberBytes(model, slot, bytes, length);
+                }
+            } else if (character == '"') {
+                value = HKJSONReadString(reader);
+                if (value) {
+                    HKModelSlotSetSerializedObject(model, slot, value);
+                }
+            } else if (character == 't' || character == 'f') {
+                if (character == 't' ? HKJSONReadLiteral(reader, "true", 4) : HKJSONReadLiteral(reader, "false", 5)) {
+                    HKModelSlotSetLongLong(model, slot, character == 't');
+                }
+            } else if (character == '-' || (character >= '0' && character <= '9')) {
+                HKJSONNumber number;
+                if (HKJSONReadNumber(reader, &number)) {
+                    HKJSONSetNumber(model, slot, &number);
+                }
+            } else {
+                HKJSONSkipValue(reader);
+            }
+            break;
+        default:
+            HKJSONSkipValue(reader);
+            break;
+    }
+}
+
+/**
+ read JSON object into model (modelClass is subclass of HKModel)
+ */
+static id HKJSONReadModel(HKJSONReader *reader, __unsafe_unretained Class modelClass) {
+    uint8_t character = HKJSONPeek(reader);
+    if (character != '{') {
+        HKJSONSkipValue(reader);
+        return nil;
+    }
+    
+    HKModelPlan *plan = [HKModelPlan planWithClass:modelClass];
+    if (plan.isSerializedObjectRequired) {
+        // custom or lazy decoding needs serialized object
+        id object = HKJSONReadObject(reader);
+        return object ? [modelClass modelWithSerializedObject:object] : nil;
+    }
+    if (!HKJSONEnter(reader)) {
+        return nil;
+    }
+    
+    BOOL isCustomSetSerializedObject = plan.isCustomSetSerializedObject;
+    HKModel *result = [[modelClass alloc] init];
+    
+    if (!HKJSONConsume(reader, '}')) {
+        do {
+            if (HKJSONPeek(reader) != '"') {
+                HKJSONFailUnexpected(reader);
+                return nil;
+            }
+            const char *key = NULL;
+            size_t length = 0;
+            if (!HKJSONReadStringBytes(reader, &key, &length)) {
+                return nil;
+            }
+            const HKModelSlot *slot = [plan slotForUTF8Key:key length:length];
+            if (!HKJSONExpect(reader, ':')) {
+                return nil;
+            }
+            
+            if (!slot) {
+                HKJSONSkipValue(reader);
+            } else if (isCustomSetSerializedObject) {
+                id value = HKJSONReadObject(reader);
+                value ? [result setSerializedObject:value forKey:slot->key] : nil;
+            } else {
+                HKJSONReadSlot(reader, result, slot);
+            }
+            if (reader->error || !HKJSONCheckProgress(reader)) {
+                return nil;
+            }
+        } while (HKJSONConsume(reader, ','));
+        if (!HKJSONExpect(reader, '}')) {
+            return nil;
+        }
+    }
+    reader->depth--;
+    
+    // custom setter of model can call wrapped setters (change tracking)
+    isCustomSetSerializedObject ? [result resetChanges] : nil;
+    return reader->context && plan.isInternable ? [reader->context internedModel:result] : result;
+}
+
+/**
+ read JSON array into model array (arrayClass is subclass of HKArray)
+ */
+static id HKJSONReadArray(HKJSONReader *reader, __unsafe_unretained Class arrayClass) {
+    uint8_t character = HKJSONPeek(reader);
+    if (character != '[') {
+        HKJSONSkipValue(reader);
+        return nil;
+    }
+    if (!HKJSONEnter(reader)) {
+        return nil;
+    }
+    
+    Class objectClass = [arrayClass objectClass];
+    BOOL isModel = [objectClass isSubclassOfClass:HKModel.class];
+    BOOL isArray = [objectClass isSubclassOfClass:HKArray.class];
+    BOOL isConvertible = [objectClass conformsToProtocol:@protocol(HKModel)];
+    NSMutableArray *result = [arrayClass array];
+    
+    if (!HKJSONConsume(reader, ']')) {
+        do {
+            id object = nil;
+            if (isModel) {
+                object = HKJSONReadModel(reader, objectClass);
+            } else if (isArray) {
+                object = HKJSONReadArray(reader, objectClass);
+            } else {
+                object = HKJSONReadObject(reader);
+                object = object && isConvertible ? [objectClass modelWithSerializedObject:object] : object;
+            }
+            if (reader->error || !HKJSONCheckProgress(reader)) {
+                return nil;
+            }
+            object ? [result addObject:object] : nil;
+        } while (HKJSONConsume(reader, ','));
+        if (!HKJSONExpect(reader, ']')) {
+            return nil;
+        }
+    }
+    reader->depth--;
+    
+    return result;
+}
+
+static NSString *HKJSONErrorDescription(HKJSONError error) {
+    switch (error) {
+        case HKJSONErrorUnexpectedCharacter:    return @"unexpected character";
+        case HKJSONErrorUnexpectedEnd:          return @"unexpected end of data";
+        case HKJSONErrorInvalidString:          return @"invalid string";
+        case HKJSONErrorInvalidNumber:          return @"invalid number";
+        case HKJSONErrorTooDeep:                return @"too deep nesting";
+        case HKJSONErrorTypeMismatch:           return @"type mismatch of top level value";
+        case HKJSONErrorCancelled:              return @"cancelled";
+    }
+    return @"unknown error";
+}
+
+/**
+ read top level value, check trailing characters and release reader
+ */
+static id HKJSONReadRoot(const void *bytes, NSUInteger length, uint8_t character, id(*read)(HKJSONReader *, __unsafe_unretained Class), __unsafe_unretained Class class, NSError **error) {
+    HKJSONReader reader;
+    HKJSONReaderInitialize(&reader, bytes, length);
+    reader.context = HKModelDecodeContext.currentContext;
+    NSProgress *progress = NSProgress.currentProgress ? [NSProgress progressWithTotalUnitCount:(int64_t)length] : nil;
+    reader.progress = progress;
+    reader.checkpoint = reader.start + kHKJSONProgressInterval;
+    
+    id result = nil;
+    if (HKJSONPeek(&reader) == character) {
+        result = read(&reader, class);
+    } else {
+        HKJSONFail(&reader, reader.cursor < reader.end ? HKJSONErrorTypeMismatch : HKJSONErrorUnexpectedEnd);
+    }
+    if (!reader.error) {
+        HKJSONPeek(&reader);
+        if (reader.cursor < reader.end) {
+            HKJSONFail(&reader, HKJSONErrorUnexpectedCharacter);
+        }
+    }
+    if (!reader.error) {
+        progress.completedUnitCount = (int64_t)length;
+    }
+    HKModelArenaFree(reader.buffer, reader.capacity);
+    
+    if (reader.error) {
+        result = nil;
+        if (error) {
+            NSUInteger offset = (NSUInteger)(reader.errorPosition - reader.start);
+            NSString *description = [NSString stringWithFormat:@"%@ at offset %lu", HKJSONErrorDescription(reader.error), (unsigned long)offset];
+            *error = [NSError errorWithDomain:HKJSONErrorDomain code:reader.error userInfo:@{ NSLocalizedDescriptionKey : description }];
+        }
+    }
+    
+    return result;
+}
+
+#pragma mark - writer
+typedef struct _HKJSONWriter {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+    int fileDescriptor;         // -1 if write to buffer only
+    NSInteger depth;
+    
+    HKJSONError error;          // 0 if no error
+    int errorNumber;            // errno of write(2)
+} HKJSONWriter;
+
+static void HKJSONWriterInitialize(HKJSONWriter *writer, int fileDescriptor) {
+    memset(writer, 0, sizeof(HKJSONWriter));
+    writer->fileDescriptor = fileDescriptor;
+}
+
+static void HKJSONWriterFlush(HKJSONWriter *writer) {
+    size_t offset = 0;
+    while (offset < writer->length && !writer->errorNumber) {
+        ssize_t written = write(writer->fileDescriptor, writer->bytes + offset, writer->length - offset);
+        if (written >= 0) {
+            offset += (size_t)written;
+        } else if (errno != EINTR) {
+            writer->errorNumber = errno;
+        }
+    }
+    writer->length = 0;
+}
+
+static inline uint8_t *HKJSONWriterReserve(HKJSONWriter *writer, size_t length) {
+    if (writer->length + length > writer->capacity) {
+        if (writer->fileDescriptor >= 0 && writer->capacity >= kHKJSONWriterFlushLength) {
+            HKJSONWriterFlush(writer);
+        }
+        if (writer->length + length > writer->capacity) {
+            size_t capacity = MAX(writer->capacity * 2, MAX(writer->length + length, 256));
+            writer->bytes = realloc(writer->bytes, capacity);
+            writer->capacity = capacity;
+        }
+    }
+    return writer->bytes + writer->length;
+}
+
+static inline void HKJSONWriteBytes(HKJSONWriter *writer, const void *bytes, size_t length) {
+    memcpy(HKJSONWriterReserve(writer, length), bytes, length);
+    writer->length += length;
+}
+
+static inline void HKJSONWriteByte(HKJSONWriter *writer, uint8_t byte) {
+    *HKJSONWriterReserve(writer, 1) = byte;
+    writer->length++;
+}
+
+#define HKJSONWriteLiteral(writer, literal) HKJSONWriteBytes(writer, literal, sizeof(literal) - 1)
+
+static void HKJSONWriteUnsignedLongLong(HKJSONWriter *writer, unsigned long long value, BOOL isNegative) {
+    char buffer[24];
+    char *cursor = buffer + sizeof(buffer);
+    do {
+        *--cursor = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    if (isNegative) {
+        *--cursor = '-';
+    }
+    HKJSONWriteBytes(writer, cursor, (size_t)(buffer + sizeof(buffer) - cursor));
+}
+
+static inline void HKJSONWriteLongLong(HKJSONWriter *writer, long long value) {
+    HKJSONWriteUnsignedLongLong(writer, value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value, value < 0);
+}
+
+// shortest representation which is read back to same value
+static void HKJSONWriteDouble(HKJSONWriter *writer, double value, BOOL isFloat) {
+    if (!isfinite(value)) {
+        HKJSONWriteLiteral(writer, "null");
+        return;
+    } else if (value == trunc(value) && fabs(value) < 1e15) {
+        HKJSONWriteLongLong(writer, (long long)value);
+        return;
+    }
+    
+    char buffer[32];
+    int length = 0;
+    for (int precision = isFloat ? 6 : 15; precision <= (isFloat ? 9 : 17); precision++) {
+        length = snprintf_l(buffer, sizeof(buffer), NULL, "%.*g", precision, value);
+        double result = strtod_l(buffer, NULL, NULL);
+        if (isFloat ? (float)result == (float)value : result == value) {
+            break;
+        }
+    }
+    HKJSONWriteBytes(writer, buffer, (size_t)length);
+}
+
+static void HKJSONWriteNumber(HKJSONWriter *writer, NSNumber *number) {
+    if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+        number.boolValue ? HKJSONWriteLiteral(writer, "true") : HKJSONWriteLiteral(writer, "false");
+        return;
+    }
+    
+    switch (number.objCType[0]) {
+        case 'f':
+            HKJSONWriteDouble(writer, number.floatValue, YES);
+            break;
+        case 'd':
+            HKJSONWriteDouble(writer, number.doubleValue, NO);
+            break;
+        case 'Q':
+            HKJSONWriteUnsignedLongLong(writer, number.unsignedLongLongValue, NO);
+            break;
+        default:
+            HKJSONWriteLongLong(writer, number.longLongValue);
+            break;
+    }
+}
+
+static void HKJSONWriteUTF8String(HKJSONWriter *writer, const char *bytes, size_t length) {
+    static const char hex[] = "0123456789abcdef";
+    
+    HKJSONWriteByte(writer, '"');
+    size_t start = 0;
+    for (size_t index = 0; index < length; index++) {
+        uint8_t character = (uint8_t)bytes[index];
+        if (character >= 0x20 && character != '"' && character != '\\') {
+            continue;
+        }
+        
+        HKJSONWriteBytes(writer, bytes + start, index - start);
+        start = index + 1;
+        switch (character) {
+            case '"':   HKJSONWriteLiteral(writer, "\\\"");  break;
+            case '\\':  HKJSONWriteLiteral(writer, "\\\\");  break;
+            case '\n':  HKJSONWriteLiteral(writer, "\\n");   break;
+            case '\r':  HKJSONWriteLiteral(writer, "\\r");   break;
+            case '\t':  HKJSONWriteLiteral(writer, "\\t");   break;
+            case '\b':  HKJSONWriteLiteral(writer, "\\b");   break;
+            case '\f':  HKJSONWriteLiteral(writer, "\\f");   break;
+            default: {
+                char escape[6] = { '\\', 'u', '0', '0', hex[character >> 4], hex[character & 0xF] };
+                HKJSONWriteBytes(writer, escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    HKJSONWriteBytes(writer, bytes + start, length - start);
+    HKJSONWriteByte(writer, '"');
+}
+
+/**
+ write data as Base64 string (encoded into writer buffer, no escape is needed)
+ */
+static void HKJSONWriteBase64(HKJSONWriter *writer, NSData *data) {
+    size_t length = HKModelBase64EncodedLength(data.length);
+    uint8_t *bytes = HKJSONWriterReserve(writer, length + 2);
+    bytes[0] = '"';
+    HKModelBase64Encode(data.bytes, data.length, (char *)bytes + 1);
+    bytes[length + 1] = '"';
+    writer->length += length + 2;
+}
+
+static void HKJSONWriteString(HKJSONWriter *writer, NSString *string) {
+    // ASCII string has C string pointer without copy
+    const char *UTF8String = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingUTF8);
+    if (UTF8String) {
+        size_t length = strlen(UTF8String);
+        if (length == string.length) {
+            HKJSONWriteUTF8String(writer, UTF8String, length);
+            return;
+        }
+    }
+    
+    NSUInteger maximumLength = [string maximumLengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    char buffer[256];
+    char *bytes = maximumLength <= sizeof(buffer) ? buffer : malloc(maximumLength);
+    NSUInteger length = 0;
+    [string getBytes:bytes maxLength:maximumLength usedLength:&length encoding:NSUTF8StringEncoding options:(NSStringEncodingConversionOptions)0 range:NSMakeRange(0, string.length) remainingRange:NULL];
+    HKJSONWriteUTF8String(writer, bytes, length);
+    if (bytes != buffer) {
+        free(bytes);
+    }
+}
+
+static inline BOOL HKJSONWriterEnter(HKJSONWriter *writer) {
+    if (++writer->depth > kHKJSONMaximumDepth) {
+        writer->error = writer->error ?: HKJSONErrorTooDeep;
+        return NO;
+    }
+    return YES;
+}
+
+static void HKJSONWriteObject(HKJSONWriter *writer, id object);
+
+/**
+ write elements into writer of each chunk concurrently and join them
+ */
+static void HKJSONWriteArrayConcurrently(HKJSONWriter *writer, NSArray *array) {
+    NSUInteger count = array.count;
+    NSUInteger chunkCount = HKModelConcurrentChunkCount(count);
+    NSInteger depth = writer->depth;
+    __unsafe_unretained id *values = (__unsafe_unretained id *)malloc(count * sizeof(id));
+    HKJSONWriter *chunks = calloc(chunkCount, sizeof(HKJSONWriter));
+    [array getObjects:values range:NSMakeRange(0, count)];
+    
+    HKModelPerformConcurrently(count, chunkCount, ^(NSUInteger chunk, NSRange range) {
+        HKJSONWriter *chunkWriter = &chunks[chunk];
+        HKJSONWriterInitialize(chunkWriter, -1);
+        chunkWriter->depth = depth;
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            if (index > range.location) {
+                HKJSONWriteByte(chunkWriter, ',');
+            }
+            HKJSONWriteObject(chunkWriter, values[index]);
+        }
+    });
+    
+    BOOL isFirst = YES;
+    HKJSONWriteByte(writer, '[');
+    for (NSUInteger chunk = 0; chunk < chunkCount; chunk++) {
+        HKJSONWriter *chunkWriter = &chunks[chunk];
+        writer->error = writer->error ?: chunkWriter->error;
+        if (chunkWriter->length && !writer->error) {
+            if (!isFirst) {
+                HKJSONWriteByte(writer, ',');
+            }
+            isFirst = NO;
+            HKJSONWriteBytes(writer, chunkWriter->bytes, chunkWriter->length);
+        }
+        free(chunkWriter->bytes);
+    }
+    HKJSONWriteByte(writer, ']');
+    
+    free(chunks);
+    free(values);
+}
+
+static void HKJSONWriteModel(HKJSONWriter *writer, HKModel *model) {
+    [model materialize];
+    HKModelPlan *plan = [HKModelPlan planWithClass:model.class];
+    if (plan.isCustomAllKeys || plan.isCustomSerializedObjectForKey) {
+        HKJSONWriteObject(writer, model.serializedObject);
+        return;
+    }
+    
+    const HKModelSlot *slots = plan.slots;
+    BOOL isFirst = YES;
+    HKJSONWriteByte(writer, '{');
+    for (NSUInteger index = 0; index < plan.numberOfSlots && !writer->error; index++) {
+        const HKModelSlot *slot = &slots[index];
+        id value = nil;
+        switch (slot->type) {
+            case HKModelSlotTypeUnsupported:
+            case HKModelSlotTypeStruct:
+                continue;
+            case HKModelSlotTypeObject:
+            case HKModelSlotTypeModel:
+                value = HKModelSlotGetObject(model, slot);
+                if (!value || (slot->type == HKModelSlotTypeObject && ![value conformsToProtocol:@protocol(HKModel)])) {
+                    continue;
+                }
+                break;
+            default:
+                break;
+        }
+        
+        if (!isFirst) {
+            HKJSONWriteByte(writer, ',');
+        }
+        isFirst = NO;
+        HKJSONWriteByte(writer, '"');
+        HKJSONWriteBytes(writer, slot->UTF8Key, slot->UTF8KeyLength);
+        HKJSONWriteLiteral(writer, "\":");
+        
+        switch (slot->type) {
+            case HKModelSlotTypeObject:
+            case HKModelSlotTypeModel:
+                slot->isBase64 && [value isKindOfClass:NSData.class] ? HKJSONWriteBase64(writer, value) : HKJSONWriteObject(writer, value);
+                break;
+            case HKModelSlotTypeBool:
+                HKModelSlotGetLongLong(model, slot) ? HKJSONWriteLiteral(writer, "true") : HKJSONWriteLiteral(writer, "false");
+                break;
+            case HKModelSlotTypeUnsignedLong:
+            case HKModelSlotTypeUnsignedLongLong:
+                HKJSONWriteUnsignedLongLong(writer, HKModelSlotGetUnsignedLongLong(model, slot), NO);
+                break;
+            case HKModelSlotTypeFloat:
+            case HKModelSlotTypeDouble:
+                HKJSONWriteDouble(writer, HKModelSlotGetDouble(model, slot), slot->type == HKModelSlotTypeFloat);
+                break;
+            default:
+                HKJSONWriteLongLong(writer, HKModelSlotGetLongLong(model, slot));
+                break;
+        }
+    }
+    HKJSONWriteByte(writer, '}');
+}
+
+/**
+ write object as serialized object (unsupported object is written as null)
+ */
+static void HKJSONWriteObject(HKJSONWriter *writer, id object) {
+    if (writer->error) {
+        return;
+    }
+    
+    if ([object isKindOfClass:NSString.class]) {
+        HKJSONWriteString(writer, object);
+    } else if ([object isKindOfClass:NSNumber.class]) {
+        HKJSONWriteNumber(writer, object);
+    } else if ([object isKindOfClass:HKModel.class]) {
+        if (HKJSONWriterEnter(writer)) {
+            HKJSONWriteModel(writer, object);
+        }
+        writer->depth--;
+    } else if ([object isKindOfClass:NSArray.class]) {
+        NSUInteger threshold = HKArray.concurrentThreshold;
+        if (HKJSONWriterEnter(writer)) {
+            if (threshold && ((NSArray *)object).count >= threshold) {
+                HKJSONWriteArrayConcurrently(writer, object);
+            } else {
+                BOOL isFirst = YES;
+                HKJSONWriteByte(writer, '[');
+                for (id value in (NSArray *)object) {
+                    if (!isFirst) {
+                        HKJSONWriteByte(writer, ',');
+                    }
+                    isFirst = NO;
+                    HKJSONWriteObject(writer, value);
+                }
+                HKJSONWriteByte(writer, ']');
+            }
+        }
+        writer->depth--;
+    } else if ([object isKindOfClass:NSDictionary.class]) {
+        if (HKJSONWriterEnter(writer)) {
+            __block BOOL isFirst = YES;
+            HKJSONWriteByte(writer, '{');
+            [(NSDictionary *)object enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+                if (!isFirst) {
+                    HKJSONWriteByte(writer, ',');
+                }
+                isFirst = NO;
+                HKJSONWriteString(writer, [key isKindOfClass:NSString.class] ? key : [key description]);
+                HKJSONWriteByte(writer, ':');
+                HKJSONWriteObject(writer, value);
+            }];
+            HKJSONWriteByte(writer, '}');
+        }
+        writer->depth--;
+    } else if ([object isKindOfClass:HKEnum.class]) {
+        [[object class] isSerializeToString] ? HKJSONWriteString(writer, ((HKEnum *)object).stringValue) : HKJSONWriteLongLong(writer, ((HKEnum *)object).value);
+    } else if ([object isKindOfClass:HKOption.class]) {
+        [[object class] isSerializeToString] ? HKJSONWriteString(writer, ((HKOption *)object).stringValue) : HKJSONWriteLongLong(writer, ((HKOption *)object).value);
+    } else if ([object isKindOfClass:NSURL.class]) {
+        HKJSONWriteString(writer, ((NSURL *)object).absoluteString);
+    } else if ([object isKindOfClass:NSData.class]) {
+        // same as modelWithSerializedObject: of NSData (UTF-8 string)
+        NSString *string = [[NSString alloc] initWithData:object encoding:NSUTF8StringEncoding];
+        string ? HKJSONWriteString(writer, string) : HKJSONWriteLiteral(writer, "null");
+    } else if ([object isKindOfClass:NSDate.class] && NSDate.serializedDateFormat == HKDateFormatISO8601) {
+        char buffer[kHKModelDateISO8601MaximumLength];
+        size_t length = HKModelDateFormatISO8601(((NSDate *)object).timeIntervalSince1970, NSDate.serializedTimeZone, buffer);
+        HKJSONWriteByte(writer, '"');
+        HKJSONWriteBytes(writer, buffer, length);
+        HKJSONWriteByte(writer, '"');
+    } else if ([object conformsToProtocol:@protocol(HKModel)]) {
+        id serializedObject = ((id<HKModel>)object).serializedObject;
+        serializedObject && serializedObject != object ? HKJSONWriteObject(writer, serializedObject) : HKJSONWriteLiteral(writer, "null");
+    } else {
+        HKJSONWriteLiteral(writer, "null");
+    }
+}
+
+/**
+ write object to writer, flush and make error
+ */
+static BOOL HKJSONWriteRoot(HKJSONWriter *writer, id object, NSError **error) {
+    HKJSONWriteObject(writer, object);
+    if (writer->fileDescriptor >= 0 && !writer->error) {
+        HKJSONWriterFlush(writer);
+    }
+    
+    if (writer->error || writer->errorNumber) {
+        if (error) {
+            *error = writer->error ? [NSError errorWithDomain:HKJSONErrorDomain code:writer->error userInfo:@{ NSLocalizedDescriptionKey : HKJSONErrorDescription(writer->error) }] : [NSError errorWithDomain:NSPOSIXErrorDomain code:writer->errorNumber userInfo:nil];
+        }
+        return NO;
+    }
+    return YES;
+}
+
+static NSData *HKJSONData(id object) {
+    HKJSONWriter writer;
+    HKJSONWriterInitialize(&writer, -1);
+    if (!HKJSONWriteRoot(&writer, object, NULL)) {
+        free(writer.bytes);
+        return nil;
+    }
+    return [NSData dataWithBytesNoCopy:writer.bytes length:writer.length freeWhenDone:YES];
+}
+
+static BOOL HKJSONWriteToData(id object, NSMutableData *data, NSError **error) {
+    HKJSONWriter writer;
+    HKJSONWriterInitialize(&writer, -1);
+    BOOL result = HKJSONWriteRoot(&writer, object, error);
+    if (result) {
+        [data appendBytes:writer.bytes length:writer.length];
+    }
+    free(writer.bytes);
+    return result;
+}
+
+static BOOL HKJSONWriteToFileDescriptor(id object, int fileDescriptor, NSError **error) {
+    HKJSONWriter writer;
+    HKJSONWriterInitialize(&writer, fileDescriptor);
+    BOOL result = HKJSONWriteRoot(&writer, object, error);
+    free(writer.bytes);
+    return result;
+}
+
+#pragma mark - HKModel
+@implementation HKModel (JSON)
+
++ (instancetype)modelWithJSONData:(NSData *)data error:(NSError * _Nullable __autoreleasing *)error {
+    return [self modelWithJSONBytes:data.bytes length:data.length error:error];
+}
+
++ (instancetype)modelWithJSONBytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable __autoreleasing *)error {
+    return HKJSONReadRoot(bytes, length, '{', HKJSONReadModel, self, error);
+}
+
+- (NSData *)JSONData {
+    return HKJSONData(self);
+}
+
+- (BOOL)writeJSONToData:(NSMutableData *)data error:(NSError * _Nullable __autoreleasing *)error {
+    return HKJSONWriteToData(self, data, error);
+}
+
+- (BOOL)writeJSONToFileDescriptor:(int)fileDescriptor error:(NSError * _Nullable __autoreleasing *)error {
+    return HKJSONWriteToFileDescriptor(self, fileDescriptor, error);
+}
+
+@end
+
+#pragma mark - HKArray
+@implementation HKArray (JSON)
+
++ (instancetype)modelWithJSONData:(NSData *)data error:(NSError * _Nullable __autoreleasing *)error {
+    return [self modelWithJSONBytes:data.bytes length:data.length error:error];
+}
+
++ (instancetype)modelWithJSONBytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable __autoreleasing *)error {
+    return HKJSONReadRoot(bytes, length, '[', HKJSONReadArray, self, error);
+}
+
+@end
+
+#pragma mark - NSArray
+@implementation NSArray (JSON)
+
+- (NSData *)JSONData {
+    return HKJSONData(self);
+}
+
+- (BOOL)writeJSONToData:(NSMutableData *)data error:(NSError * _Nullable __autoreleasing *)error {
+    return HKJSONWriteToData(self, data, error);
+}
+
+- (BOOL)writeJSONToFileDescriptor:(int)fileDescriptor error:(NSError * _Nullable __autoreleasing *)error {
+    return HKJSONWriteToFileDescriptor(self, fileDescriptor, error);
+}
+
+@end
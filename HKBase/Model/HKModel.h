@@ -75,6 +75,82 @@ NS_ASSUME_NONNULL_BEGIN
 @interface HKModel : NSObject
 <HKModel>
 
+/**
+ convert object properties on first access (default : NO)
+ modelWithSerializedObject: keeps dictionary and converts each object property (ex. nested model, HKArray) when it is read
+ number properties are converted immediately, not used if setSerializedObject:forKey: is overridden
+ */
+@property (class, nonatomic, readonly, getter=isLazyMaterialization) BOOL lazyMaterialization;
+/**
+ convert all properties not converted yet (lazy materialization)
+ */
+- (void)materialize;
+
+/**
+ NSData properties are serialized as Base64 string (default : NO)
+ decoded and encoded into single buffer without NSString, NSData is UTF-8 string of serialized object otherwise
+ */
+@property (class, nonatomic, readonly, getter=isBase64Data) BOOL base64Data;
+/**
+ keys of NSData properties serialized as Base64 string (default : nil, all NSData properties if isBase64Data)
+ */
+@property (class, nonatomic, readonly, nullable) NSSet<NSString *> *base64DataKeys;
+
+/**
+ keys of NSTimeInterval (double) properties decoded from ISO 8601 string (default : nil)
+ string of number is decoded as number first (ex. "20180823" is 20180823.0)
+ */
+@property (class, nonatomic, readonly, nullable) NSSet<NSString *> *timeIntervalDateKeys;
+
+/**
+ reset all properties to nil or zero for reuse (ex. HKModelPool)
+ subclass resetting additional state should call super
+ */
+- (void)prepareForReuse;
+
+/**
+ model is not changed after decoding (default : NO)
+ equal models are decoded as same instance in HKModelDecodeContext, not used with lazy materialization or change tracking
+ copy returns model itself (snapshot), use copyWithChanges: for changed model
+ changing model after copy or interning is undefined (setters assert unless NS_BLOCK_ASSERTIONS)
+ */
+@property (class, nonatomic, readonly, getter=isImmutable) BOOL immutable;
+/**
+ copy sharing all unchanged values (ex. nested models, arrays) with model, and change it in block
+ values are not copied even if attribute is copy, so shared nested values should be replaced instead of changed
+
+ @param changes block changing new model before returned (ex. ^(HKCardResponse *response) { response.header = header; })
+ @return new model
+ */
+- (instancetype)copyWithChanges:(nullable void (NS_NOESCAPE ^)(id model))changes;
+
+/**
+ record properties changed by setter (default : NO)
+ changes are recorded since initialized (ex. modelWithSerializedObject:) or resetChanges
+ decoding, copying and applySerializedPatch: are not recorded, struct properties are not tracked
+ */
+@property (class, nonatomic, readonly, getter=isChangeTracking) BOOL changeTracking;
+/**
+ keys of changed properties (empty if changeTracking is NO)
+ */
+@property (nonatomic, readonly) NSArray<NSString *> *changedKeys;
+/**
+ serialized object of changed properties only (nil if nothing is changed)
+ property changed to nil is NSNull
+ */
+@property (nonatomic, readonly, nullable) NSDictionary<NSString *, id> *serializedDelta;
+/**
+ clear changed properties
+ */
+- (void)resetChanges;
+/**
+ set properties of keys in partial serialized object (ex. serializedDelta of other model)
+ other properties are not changed, NSNull clears object property
+
+ @param serializedPatch partial serialized object
+ */
+- (void)applySerializedPatch:(NSDictionary<NSString *, id> *)serializedPatch;
+
 /**
  methods for subscript (ie.model[@"key"])
 
@@ -109,6 +185,38 @@ NS_ASSUME_NONNULL_BEGIN
 <HKModel>
 @end
 
+/**
+ format of serialized date
+
+ - HKDateFormatISO8601: ISO 8601 string (ex. 2018-08-23T12:34:56.789Z)
+ - HKDateFormatEpochSeconds: seconds since 1970 (number)
+ - HKDateFormatEpochMilliseconds: milliseconds since 1970 (number)
+ */
+typedef NS_ENUM(NSInteger, HKDateFormat) {
+    HKDateFormatISO8601 = 0,
+    HKDateFormatEpochSeconds,
+    HKDateFormatEpochMilliseconds,
+};
+
+/**
+ date is decoded from ISO 8601 string or epoch number without NSDateFormatter
+ NSTimeInterval (double) property is decoded from ISO 8601 string too if key is in HKModel.timeIntervalDateKeys
+ */
+@interface NSDate (HKModel)
+<HKModel>
+
+/**
+ format of serializedObject (default : HKDateFormatISO8601)
+ epoch number is decoded as milliseconds if HKDateFormatEpochMilliseconds, seconds otherwise
+ */
+@property (class, nonatomic, assign) HKDateFormat serializedDateFormat;
+/**
+ time zone of ISO 8601 serializedObject (default : nil, UTC as 'Z')
+ */
+@property (class, nonatomic, strong, nullable) NSTimeZone *serializedTimeZone;
+
+@end
+
 @interface NSDictionary (HKModel)
 <HKModel>
 @end
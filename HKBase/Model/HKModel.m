@@ -25,12 +25,30 @@
 #import "HKRuntimeUtility.h"
 #import "HKProperty.h"
 #import "HKInstanceVariable.h"
+#import "HKModelPlan.h"
+#import "HKArray.h"
+#import "HKModelLazyStorage.h"
+#import "HKModelChanges.h"
+#import "HKModelDecodeContext.h"
+#import "HKModelNumber.h"
+#import "HKModelDate.h"
+#import "HKModelDecodeSession.h"
+
+static NSString *const kHKModelCodingVersionKey = @"HKModel.codingVersion";     // not a property name
+static const NSInteger kHKModelCodingVersion = 1;                               // 1: numbers are encoded as typed values
 
 #define HKSerializedObject(value) ([value conformsToProtocol:@protocol(HKModel)] ? ((id<HKModel>)value).serializedObject : value)
 
 #pragma mark - model object
-@interface HKModel ()
+@interface HKModel () {
+    HKModelLazyStorage *_lazyStorage;
+    HKModelChanges *_changes;
+    NSUInteger _numberOfChangeSuppressions;     // setters are not recorded while decoding or patching
+    BOOL _frozen;                               // immutable model is shared by copy or intern table
+}
 
+- (void)HK_prepareChanges;
+- (void)HK_setValuesWithSerializedObject:(id)serializedObject plan:(HKModelPlan *)plan;
 - (void)HK_decodeWithCoder:(NSCoder *)decoder;
 - (void)HK_setSerializedObject:(id)serializedObject forKey:(NSString *)key byProperty:(HKProperty *)property;
 
@@ -38,25 +56,78 @@
 
 @implementation HKModel
 
+HKModelLazyStorage *HKModelGetLazyStorage(HKModel *model) {
+    return model->_lazyStorage;
+}
+
+void HKModelFreeze(HKModel *model) {
+    model->_frozen = YES;
+}
+
+void HKModelDidChangeSlot(HKModel *model, const HKModelSlot *slot) {
+    NSCAssert(!model->_frozen || model->_numberOfChangeSuppressions, @"%@ is changed after shared (immutable), use copyWithChanges:", model.class);
+    HKModelChanges *changes = model->_changes;
+    if (!changes || model->_numberOfChangeSuppressions) {
+        return;
+    }
+    
+    // wrapper of superclass passes slot of superclass plan (index is different)
+    HKModelPlan *plan = changes.plan;
+    if (slot->modelClass != plan.modelClass) {
+        slot = [plan slotForUTF8Key:slot->UTF8Key length:slot->UTF8KeyLength];
+    }
+    slot ? [changes markSlot:slot] : nil;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        [self HK_prepareChanges];
+    }
+    return self;
+}
+
 //NSSecureCoding
 - (instancetype)initWithCoder:(NSCoder *)decoder {
     self = [super init];
     if (self) {
+        [self HK_prepareChanges];
+        _numberOfChangeSuppressions++;
         [self HK_decodeWithCoder:decoder];
+        _numberOfChangeSuppressions--;
     }
     return self;
 }
 
 - (void)encodeWithCoder:(NSCoder *)coder {
-    Class class = self.class;
-    do {
-        for (HKProperty *property in class.properties) {
-            if (!property.dynamic && !property.readOnly) {
-                id object = [self objectForProperty:property];
-                object ? [coder encodeObject:object forKey:property.name] : nil;
-            }
+    [self materialize];
+    HKModelPlan *plan = [HKModelPlan planWithClass:self.class];
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        switch (slot->type) {
+            case HKModelSlotTypeBool:
+                [coder encodeBool:HKModelSlotGetLongLong(self, slot) != 0 forKey:slot->key];
+                break;
+            case HKModelSlotTypeUnsignedLong:
+            case HKModelSlotTypeUnsignedLongLong:
+                [coder encodeInt64:(int64_t)HKModelSlotGetUnsignedLongLong(self, slot) forKey:slot->key];
+                break;
+            case HKModelSlotTypeFloat:
+            case HKModelSlotTypeDouble:
+                [coder encodeDouble:HKModelSlotGetDouble(self, slot) forKey:slot->key];
+                break;
+            default:
+                if (HKModelSlotTypeIsNumber(slot->type)) {
+                    [coder encodeInt64:HKModelSlotGetLongLong(self, slot) forKey:slot->key];
+                } else {
+                    id object = [self objectForProperty:slot->property];
+                    object ? [coder encodeObject:object forKey:slot->key] : nil;
+                }
+                break;
         }
-    } while ([(class = class.superclass) isSubclassOfClass:HKModel.class]);
+    }
+    [coder encodeInteger:kHKModelCodingVersion forKey:kHKModelCodingVersionKey];
 }
 
 @dynamic supportsSecureCoding;
@@ -65,72 +136,244 @@
 }
 
 - (void)HK_decodeWithCoder:(NSCoder *)decoder {
-    Class class = self.class;
-    do {
-        for (HKProperty *property in class.properties) {
-            if (!property.dynamic && !property.readOnly) {
-                [self setObject:[decoder decodeObjectForKey:property.name] forProperty:property];
-            }
+    // numbers are encoded as object before version 1
+    BOOL isTyped = [decoder decodeIntegerForKey:kHKModelCodingVersionKey] >= 1;
+    HKModelPlan *plan = [HKModelPlan planWithClass:self.class];
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        if (!isTyped || !HKModelSlotTypeIsNumber(slot->type)) {
+            [self setObject:[decoder decodeObjectForKey:slot->key] forProperty:slot->property];
+            continue;
+        } else if (![decoder containsValueForKey:slot->key]) {
+            continue;
+        }
+        
+        switch (slot->type) {
+            case HKModelSlotTypeBool:
+                HKModelSlotSetLongLong(self, slot, [decoder decodeBoolForKey:slot->key]);
+                break;
+            case HKModelSlotTypeUnsignedLong:
+            case HKModelSlotTypeUnsignedLongLong:
+                HKModelSlotSetUnsignedLongLong(self, slot, (unsigned long long)[decoder decodeInt64ForKey:slot->key]);
+                break;
+            case HKModelSlotTypeFloat:
+            case HKModelSlotTypeDouble:
+                HKModelSlotSetDouble(self, slot, [decoder decodeDoubleForKey:slot->key]);
+                break;
+            default:
+                HKModelSlotSetLongLong(self, slot, [decoder decodeInt64ForKey:slot->key]);
+                break;
         }
-    } while ([(class = class.superclass) isSubclassOfClass:HKModel.class]);
+    }
 }
 
 // NSCopying
 - (instancetype)copyWithZone:(NSZone *)zone {
     Class class = self.class;
-    HKModel *result = [[class allocWithZone:zone] init];
-    
-    do {
-        for (HKProperty *property in class.properties) {
-            if (!property.dynamic && !property.readOnly) {
-                [result setObject:[self objectForProperty:property] forProperty:property];
-            }
-        }
-    } while ([(class = class.superclass) isSubclassOfClass:HKModel.class]);
+    // immutable model is snapshot, copy is shared
+    if (class.isImmutable) {
+        _frozen = YES;
+        return self;
+    }
     
+    [self materialize];
+    HKModel *result = [[class allocWithZone:zone] init];
+    result->_numberOfChangeSuppressions++;
+    [[HKModelPlan planWithClass:class] copyValuesFromModel:self toModel:result];
+    result->_numberOfChangeSuppressions--;
+    return result;
+}
+
+- (instancetype)copyWithChanges:(void (NS_NOESCAPE ^)(id))changes {
+    [self materialize];
+    Class class = self.class;
+    HKModel *result = [[class alloc] init];
+    result->_numberOfChangeSuppressions++;
+    [[HKModelPlan planWithClass:class] shareValuesFromModel:self toModel:result];
+    result->_numberOfChangeSuppressions--;
+    if (changes) {
+        changes(result);
+    }
     return result;
 }
 
 // HKModel
 + (instancetype)modelWithSerializedObject:(id)serializedObject {
-    Class class = self;
-    HKModel *result = [[class alloc] init];
+    HKModelPlan *plan = [HKModelPlan planWithClass:self];
+    HKModel *result = [[self alloc] init];
+    [result HK_setValuesWithSerializedObject:serializedObject plan:plan];
     
-    do {
-        for (HKProperty *property in class.properties) {
-            if (!property.dynamic && !property.readOnly) {
-                [result setSerializedObject:[serializedObject valueForKey:property.name] forKey:property.name];
-            }
+    HKModelDecodeContext *context = plan.isInternable ? HKModelDecodeContext.currentContext : nil;
+    return context ? [context internedModel:result] : result;
+}
+
+- (void)HK_setValuesWithSerializedObject:(id)serializedObject plan:(HKModelPlan *)plan {
+    BOOL isDictionary = [serializedObject isKindOfClass:NSDictionary.class];
+    BOOL isCustom = plan.isCustomSetSerializedObject;
+    BOOL isLazy = isDictionary && !isCustom && self.class.isLazyMaterialization;
+    if (isLazy) {
+        [HKModelLazyStorage prepareWithPlan:plan];
+        _lazyStorage = [[HKModelLazyStorage alloc] initWithSerializedObject:serializedObject plan:plan];
+    }
+    
+    _numberOfChangeSuppressions++;
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        if (isLazy && (slot->type == HKModelSlotTypeObject || slot->type == HKModelSlotTypeModel)) {
+            continue;
+        }
+        id value = isDictionary ? ((NSDictionary *)serializedObject)[slot->key] : [serializedObject valueForKey:slot->key];
+        isCustom ? [self setSerializedObject:value forKey:slot->key] : HKModelSlotSetSerializedObject(self, slot, value);
+    }
+    _numberOfChangeSuppressions--;
+}
+
+- (id)serializedObject {
+    [self materialize];
+    HKModelPlan *plan = [HKModelPlan planWithClass:self.class];
+    NSMutableDictionary *result = [NSMutableDictionary dictionaryWithCapacity:plan.numberOfSlots];
+    
+    if (plan.isCustomAllKeys) {
+        for (NSString *key in self.allKeys) {
+            result[key] = [self serializedObjectForKey:key];
+        }
+    } else {
+        BOOL isCustom = plan.isCustomSerializedObjectForKey;
+        const HKModelSlot *slots = plan.slots;
+        for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+            const HKModelSlot *slot = &slots[index];
+            result[slot->key] = isCustom ? [self serializedObjectForKey:slot->key] : HKModelSlotGetSerializedObject(self, slot);
         }
-    } while ([(class = class.superclass) isSubclassOfClass:HKModel.class]);
+    }
     
     return result;
 }
 
-- (id)serializedObject {
-    NSArray<NSString *> *allKeys = self.allKeys;
-    NSMutableDictionary *result = [NSMutableDictionary dictionaryWithCapacity:allKeys.count];
-    for (NSString *key in allKeys) {
-        result[key] = [self serializedObjectForKey:key];
+@dynamic lazyMaterialization;
++ (BOOL)isLazyMaterialization {
+    return NO;
+}
+
+- (void)materialize {
+    [_lazyStorage materializeModel:self];
+}
+
+@dynamic base64Data;
++ (BOOL)isBase64Data {
+    return NO;
+}
+
+@dynamic base64DataKeys;
++ (NSSet<NSString *> *)base64DataKeys {
+    return nil;
+}
+
+@dynamic timeIntervalDateKeys;
++ (NSSet<NSString *> *)timeIntervalDateKeys {
+    return nil;
+}
+
+- (void)prepareForReuse {
+    _lazyStorage = nil;
+    _frozen = NO;
+    [[HKModelPlan planWithClass:self.class] resetValuesOfModel:self];
+    [_changes reset];
+}
+
+@dynamic immutable;
++ (BOOL)isImmutable {
+    return NO;
+}
+
+@dynamic changeTracking;
++ (BOOL)isChangeTracking {
+    return NO;
+}
+
+- (NSArray<NSString *> *)changedKeys {
+    HKModelChanges *changes = _changes;
+    if (!changes.isChanged) {
+        return @[];
+    }
+    
+    NSMutableArray<NSString *> *result = [NSMutableArray array];
+    HKModelPlan *plan = changes.plan;
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        [changes isChangedSlot:slot] ? [result addObject:slot->key] : nil;
     }
     return result;
 }
 
-@dynamic allKeys;
-- (NSArray<NSString *> *)allKeys {
-    Class class = self.class;
-    NSMutableArray *result = [NSMutableArray array];
+- (NSDictionary<NSString *, id> *)serializedDelta {
+    HKModelChanges *changes = _changes;
+    if (!changes.isChanged) {
+        return nil;
+    }
     
-    do {
-        for (HKProperty *property in class.properties) {
-            if (!property.dynamic && !property.readOnly) {
-                [result addObject:property.name];
-            }
+    NSMutableDictionary<NSString *, id> *result = [NSMutableDictionary dictionary];
+    HKModelPlan *plan = changes.plan;
+    BOOL isCustom = plan.isCustomSerializedObjectForKey;
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        if ([changes isChangedSlot:slot]) {
+            [_lazyStorage materializeSlot:slot ofModel:self];
+            id value = isCustom ? [self serializedObjectForKey:slot->key] : HKModelSlotGetSerializedObject(self, slot);
+            result[slot->key] = value ?: NSNull.null;
         }
-    } while ([(class = class.superclass) isSubclassOfClass:HKModel.class]);
-
+    }
     return result;
+}
+
+- (void)resetChanges {
+    [_changes reset];
+}
 
+- (void)applySerializedPatch:(NSDictionary<NSString *, id> *)serializedPatch {
+    HKModelPlan *plan = [HKModelPlan planWithClass:self.class];
+    BOOL isCustom = plan.isCustomSetSerializedObject;
+    
+    _numberOfChangeSuppressions++;
+    for (NSString *key in serializedPatch) {
+        const HKModelSlot *slot = [key isKindOfClass:NSString.class] ? [plan slotForKey:key] : NULL;
+        if (!slot) {
+            continue;
+        }
+        
+        // pending value of lazy materialization is replaced by patch
+        [_lazyStorage discardSlot:slot];
+        id value = serializedPatch[key];
+        if (value == NSNull.null && (slot->type == HKModelSlotTypeObject || slot->type == HKModelSlotTypeModel)) {
+            isCustom ? [self setSerializedObject:nil forKey:key] : HKModelSlotSetObject(self, slot, nil);
+        } else {
+            isCustom ? [self setSerializedObject:value forKey:key] : HKModelSlotSetSerializedObject(self, slot, value);
+        }
+    }
+    _numberOfChangeSuppressions--;
+}
+
+@dynamic allKeys;
+- (NSArray<NSString *> *)allKeys {
+    return [HKModelPlan planWithClass:self.class].allKeys;
+}
+
+- (void)HK_prepareChanges {
+    Class class = self.class;
+    if (class.isChangeTracking) {
+        HKModelPlan *plan = [HKModelPlan planWithClass:class];
+        [HKModelChanges prepareWithPlan:plan];
+        _changes = [[HKModelChanges alloc] initWithPlan:plan];
+    }
+#if !defined(NS_BLOCK_ASSERTIONS)
+    // setters of immutable model assert after shared (not wrapped if assertions are disabled)
+    else if (class.isImmutable) {
+        [HKModelChanges prepareWithPlan:[HKModelPlan planWithClass:class]];
+    }
+#endif
 }
 
 - (void)HK_setSerializedObject:(id)serializedObject forKey:(NSString *)key byProperty:(HKProperty *)property {
@@ -153,12 +396,13 @@
                         NSUInteger size = 0;
                         NSGetSizeAndAlignment(objCType, &size, NULL);
                         
-                        void *buffer = malloc((size_t)size);
+                        size_t capacity = 0;
+                        void *buffer = HKModelArenaAllocate((size_t)size, &capacity);
                         [value getValue:buffer];
                         
                         [self setValue:buffer forInstanceVariable:variable];
                         
-                        free(buffer);
+                        HKModelArenaFree(buffer, capacity);
                     }
                 }
             }
@@ -167,10 +411,22 @@
 }
 
 - (void)setSerializedObject:(id)serializedObject forKey:(NSString *)key {
-    [self HK_setSerializedObject:serializedObject forKey:key byProperty:[HKProperty propertyWithClass:self.class name:key]];
+    const HKModelSlot *slot = [[HKModelPlan planWithClass:self.class] slotForKey:key];
+    if (slot) {
+        HKModelSlotSetSerializedObject(self, slot, serializedObject);
+    } else {
+        // readonly or dynamic properties are not in plan
+        [self HK_setSerializedObject:serializedObject forKey:key byProperty:[HKProperty propertyWithClass:self.class name:key]];
+    }
 }
 
 - (id)serializedObjectForKey:(NSString *)key {
+    const HKModelSlot *slot = [[HKModelPlan planWithClass:self.class] slotForKey:key];
+    if (slot) {
+        [_lazyStorage materializeSlot:slot ofModel:self];
+        return HKModelSlotGetSerializedObject(self, slot);
+    }
+    
     id result = nil;
     
     HKProperty *property = [HKProperty propertyWithClass:self.class name:key];
@@ -210,7 +466,8 @@
     } else if ([serializedObject isKindOfClass:NSData.class]) {
         result = [[NSString alloc] initWithData:serializedObject encoding:NSUTF8StringEncoding];
     }
-    return result;
+    HKModelDecodeContext *context = result ? HKModelDecodeContext.currentContext : nil;
+    return context ? [context internedString:result] : result;
 }
 
 - (id)serializedObject {
@@ -223,7 +480,20 @@
 }
 
 - (unsigned long long)unsignedLongLongValue {
-    return strtoull(self.UTF8String, NULL, 0);
+    // octal (ex. 017) and hexadecimal (ex. 0x1F) are parsed as strtoull base 0
+    const char *bytes = self.UTF8String;
+    const char *cursor = bytes;
+    while (cursor && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r')) {
+        cursor++;
+    }
+    cursor = cursor && (*cursor == '+' || *cursor == '-') ? cursor + 1 : cursor;
+    if (cursor && cursor[0] == '0' && (cursor[1] == 'x' || cursor[1] == 'X' || (cursor[1] >= '0' && cursor[1] <= '9'))) {
+        return strtoull(bytes, NULL, 0);
+    }
+    
+    HKModelNumber number;
+    HKModelNumberParseString(self, &number);
+    return HKModelNumberUnsignedLongLongValue(&number);
 }
 
 - (unsigned short)unsignedShortValue {
@@ -244,9 +514,14 @@
     if ([serializedObject isKindOfClass:NSNumber.class]) {
         result = [serializedObject copy];
     } else if ([serializedObject isKindOfClass:NSString.class]) {
-        result = @(((NSString *)serializedObject).doubleValue);
+        // integer string is not converted to double (ex. 64-bit identifier)
+        HKModelNumber number;
+        HKModelNumberParseString(serializedObject, &number);
+        result = HKModelNumberObject(&number);
     } else if ([serializedObject isKindOfClass:NSData.class]) {
-        result = @([[NSString alloc] initWithData:serializedObject encoding:NSUTF8StringEncoding].doubleValue);
+        HKModelNumber number;
+        HKModelNumberParse(((NSData *)serializedObject).bytes, ((NSData *)serializedObject).length, &number);
+        result = HKModelNumberObject(&number);
     }
     return result;
 }
@@ -264,7 +539,8 @@
     if (![serializedObject isKindOfClass:NSNumber.class]) {
         NSString *URLString = [NSString modelWithSerializedObject:serializedObject];
         if (URLString.length) {
-            result = [NSURL URLWithString:URLString];
+            HKModelDecodeContext *context = HKModelDecodeContext.currentContext;
+            result = context ? [context internedURLWithString:URLString] : [NSURL URLWithString:URLString];
         }
     }
     return result;
@@ -296,6 +572,67 @@
 
 @end
 
+static HKDateFormat HKSerializedDateFormat = HKDateFormatISO8601;
+static NSTimeZone *HKSerializedTimeZone = nil;
+
+@implementation NSDate (HKModel)
+
+@dynamic serializedDateFormat;
++ (HKDateFormat)serializedDateFormat {
+    return HKSerializedDateFormat;
+}
+
++ (void)setSerializedDateFormat:(HKDateFormat)serializedDateFormat {
+    HKSerializedDateFormat = serializedDateFormat;
+}
+
+@dynamic serializedTimeZone;
++ (NSTimeZone *)serializedTimeZone {
+    return HKSerializedTimeZone;
+}
+
++ (void)setSerializedTimeZone:(NSTimeZone *)serializedTimeZone {
+    HKSerializedTimeZone = serializedTimeZone;
+}
+
++ (instancetype)modelWithSerializedObject:(id)serializedObject {
+    NSDate *result = nil;
+    if ([serializedObject isKindOfClass:NSDate.class]) {
+        result = serializedObject;
+    } else if ([serializedObject isKindOfClass:NSString.class]) {
+        NSTimeInterval timeInterval = 0;
+        if (HKModelDateParseISO8601String(serializedObject, &timeInterval)) {
+            result = [self dateWithTimeIntervalSince1970:timeInterval];
+        } else {
+            // epoch in string (whole string, ex. "12abc" is not date)
+            HKModelNumber number;
+            const char *bytes = ((NSString *)serializedObject).UTF8String;
+            NSUInteger length = bytes ? strlen(bytes) : 0;
+            result = length && HKModelNumberParse(bytes, length, &number) == length ? [self dateWithTimeIntervalSince1970:HKModelDateTimeIntervalWithEpoch(number.real)] : nil;
+        }
+    } else if ([serializedObject isKindOfClass:NSNumber.class]) {
+        result = [self dateWithTimeIntervalSince1970:HKModelDateTimeIntervalWithEpoch(((NSNumber *)serializedObject).doubleValue)];
+    }
+    return result;
+}
+
+- (id)serializedObject {
+    NSTimeInterval timeInterval = self.timeIntervalSince1970;
+    switch (HKSerializedDateFormat) {
+        case HKDateFormatEpochSeconds:
+            return @(timeInterval);
+        case HKDateFormatEpochMilliseconds:
+            return @(llround(timeInterval * 1000.0));
+        default: {
+            char buffer[kHKModelDateISO8601MaximumLength];
+            size_t length = HKModelDateFormatISO8601(timeInterval, HKSerializedTimeZone, buffer);
+            return [[NSString alloc] initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
+        }
+    }
+}
+
+@end
+
 @implementation NSDictionary (HKModel)
 
 + (instancetype)modelWithSerializedObject:(id)serializedObject {
@@ -341,9 +678,16 @@
 
 - (id)serializedObject {
     NSMutableArray *result = [NSMutableArray arrayWithCapacity:self.count];
-    for (id value in self) {
-        id object = HKSerializedObject(value);
-        object ? [result addObject:object] : nil;
+    NSUInteger threshold = HKArray.concurrentThreshold;
+    if (threshold && self.count >= threshold) {
+        HKModelTransformObjectsConcurrently(self, result, ^id(id value) {
+            return HKSerializedObject(value);
+        });
+    } else {
+        for (id value in self) {
+            id object = HKSerializedObject(value);
+            object ? [result addObject:object] : nil;
+        }
     }
     return result;
 }
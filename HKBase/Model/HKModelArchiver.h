@@ -0,0 +1,175 @@
+//
+//  HKModelArchiver.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModel.h"
+#import "HKArray.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ error domain of model archive
+ */
+OBJC_EXTERN NSString *const HKModelArchiveErrorDomain;
+
+/**
+ error code in HKModelArchiveErrorDomain
+
+ - HKModelArchiveErrorInvalidHeader: not model archive or unsupported version
+ - HKModelArchiveErrorUnexpectedEnd: archive is terminated in value
+ - HKModelArchiveErrorInvalidValue: unknown tag or invalid value
+ - HKModelArchiveErrorTooDeep: nesting is deeper than limit
+ */
+typedef NS_ENUM(NSInteger, HKModelArchiveError) {
+    HKModelArchiveErrorInvalidHeader = 1,
+    HKModelArchiveErrorUnexpectedEnd,
+    HKModelArchiveErrorInvalidValue,
+    HKModelArchiveErrorTooDeep,
+};
+
+/**
+ compact binary archiver of model
+ property layout of each class is written once in schema (class name, property names)
+ values are tagged (zigzag varint for integer, inline UTF-8 for string, enum and option as integer)
+ other objects conforms NSSecureCoding are archived with NSKeyedArchiver (decoded securely as property class or property list class)
+ */
+@interface HKModelArchiver : NSObject
+
+/**
+ encode value (model, array, dictionary, string, number ...)
+ models deeper than limit (ex. cycle) are encoded as null
+
+ @param object object for encode
+ */
+- (void)encodeObject:(nullable id)object;
+
+/**
+ encoded values (without schema)
+ */
+@property (nonatomic, readonly) NSData *encodedData;
+/**
+ length of encoded values
+ */
+@property (nonatomic, readonly) NSUInteger encodedLength;
+/**
+ schema of all classes in encoded values
+ */
+@property (nonatomic, readonly) NSData *schemaData;
+/**
+ archive (header, schema and encoded values)
+ */
+@property (nonatomic, readonly) NSData *archivedData;
+
+/**
+ discard encoded values (schema is kept)
+ */
+- (void)resetEncodedData;
+
+@end
+
+/**
+ unarchiver of HKModelArchiver
+ properties are matched by name, added or removed properties between versions are ignored
+ */
+@interface HKModelUnarchiver : NSObject
+
+/**
+ unarchive object from archivedData of HKModelArchiver
+
+ @param objectClass expected class (ex. model class or HKArray class)
+ @param data archived data
+ @param error error (in HKModelArchiveErrorDomain)
+ @return unarchived object
+ */
++ (nullable id)unarchiveObjectOfClass:(nullable Class)objectClass fromData:(NSData *)data error:(NSError * _Nullable * _Nullable)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+/**
+ initialize with schemaData of HKModelArchiver
+
+ @param bytes schema bytes
+ @param length length of bytes
+ @param error error (in HKModelArchiveErrorDomain)
+ @return unarchiver
+ */
+- (nullable instancetype)initWithSchemaBytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ data containing decoded bytes (ex. memory mapped file)
+ strings and data in this data are decoded without copy and retain it (set before decoding)
+ */
+@property (nonatomic, strong, nullable) NSData *referencedData;
+
+/**
+ decode one value from encodedData of HKModelArchiver
+
+ @param objectClass expected class (ex. model class or HKArray class)
+ @param bytes encoded bytes of value
+ @param length length of bytes
+ @param error error (in HKModelArchiveErrorDomain)
+ @return decoded object
+ */
+- (nullable id)decodeObjectOfClass:(nullable Class)objectClass bytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable * _Nullable)error;
+
+@end
+
+@interface HKModel (Archive)
+
+/**
+ archived data of model (HKModelArchiver)
+ */
+@property (nonatomic, readonly) NSData *archivedData;
+/**
+ initialize model from archived data
+
+ @param data archived data (HKModelArchiver)
+ @param error error (in HKModelArchiveErrorDomain)
+ @return model object
+ */
++ (nullable instancetype)modelWithArchivedData:(NSData *)data error:(NSError * _Nullable * _Nullable)error;
+
+@end
+
+@interface HKArray<ObjectType> (Archive)
+
+/**
+ initialize model array from archived data
+
+ @param data archived data (HKModelArchiver)
+ @param error error (in HKModelArchiveErrorDomain)
+ @return model array
+ */
++ (nullable instancetype)modelWithArchivedData:(NSData *)data error:(NSError * _Nullable * _Nullable)error;
+
+@end
+
+@interface NSArray (Archive)
+
+/**
+ archived data of array (HKModelArchiver)
+ */
+@property (nonatomic, readonly) NSData *archivedData;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,1020 @@
+//
+//  HKModelArchiver.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelArchiver.h"
+#import "HKModelPlan.h"
+#import "HKModelDecodeContext.h"
+#import "HKEnum.h"
+#import "HKOption.h"
+
+#import <pthread.h>
+
+NSString *const HKModelArchiveErrorDomain = @"HKModelArchiveErrorDomain";
+
+static const uint8_t kHKModelArchiveMagic[4] = { 'H', 'K', 'M', 'A' };
+static const uint64_t kHKModelArchiveVersion = 1;
+static const NSInteger kHKModelArchiveMaximumDepth = 512;
+
+/**
+ tag of value
+ */
+typedef NS_ENUM(uint8_t, HKArchiveTag) {
+    HKArchiveTagNull = 0,
+    HKArchiveTagFalse,
+    HKArchiveTagTrue,
+    HKArchiveTagInteger,            // zigzag varint
+    HKArchiveTagUnsignedInteger,    // varint
+    HKArchiveTagFloat,              // 4 bytes (little endian)
+    HKArchiveTagDouble,             // 8 bytes (little endian)
+    HKArchiveTagString,             // varint length + UTF-8
+    HKArchiveTagData,               // varint length + bytes
+    HKArchiveTagArray,              // varint count + values
+    HKArchiveTagDictionary,         // varint count + (string key + value)
+    HKArchiveTagModel,              // varint schema index + values of fields in schema
+    HKArchiveTagCoded,              // varint length + NSKeyedArchiver data
+};
+
+static inline uint64_t HKArchiveZigZagEncode(long long value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static inline long long HKArchiveZigZagDecode(uint64_t value) {
+    return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+#pragma mark - keyed archive of other objects
+static NSData *HKArchiveCodedData(id<NSSecureCoding> object) {
+    if (@available(iOS 11.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+        return [NSKeyedArchiver archivedDataWithRootObject:object requiringSecureCoding:YES error:NULL];
+    }
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    NSMutableData *data = [NSMutableData data];
+    NSKeyedArchiver *archiver = [[NSKeyedArchiver alloc] initForWritingWithMutableData:data];
+    archiver.requiresSecureCoding = YES;
+    [archiver encodeObject:object forKey:NSKeyedArchiveRootObjectKey];
+    [archiver finishEncoding];
+#pragma GCC diagnostic pop
+    return data;
+}
+
+// property class of slot and property list classes are allowed (nested in array or dictionary : property list classes only)
+static id HKArchiveCodedObject(NSData *data, __unsafe_unretained Class expectedClass) {
+    static NSSet<Class> *propertyListClasses = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        propertyListClasses = [NSSet setWithObjects:NSString.class, NSNumber.class, NSData.class, NSDate.class, NSURL.class, NSUUID.class, NSNull.class, NSValue.class, NSArray.class, NSDictionary.class, NSSet.class, nil];
+    });
+    NSSet<Class> *classes = [expectedClass conformsToProtocol:@protocol(NSSecureCoding)] ? [propertyListClasses setByAddingObject:expectedClass] : propertyListClasses;
+    
+    NSKeyedUnarchiver *unarchiver = nil;
+    if (@available(iOS 11.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+        unarchiver = [[NSKeyedUnarchiver alloc] initForReadingFromData:data error:NULL];
+    } else {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+        unarchiver = [[NSKeyedUnarchiver alloc] initForReadingWithData:data];
+#pragma GCC diagnostic pop
+        unarchiver.requiresSecureCoding = YES;
+    }
+    id result = [unarchiver decodeObjectOfClasses:classes forKey:NSKeyedArchiveRootObjectKey];
+    [unarchiver finishDecoding];
+    return result;
+}
+
+#pragma mark - archiver
+@interface HKModelArchiver () {
+    uint8_t *_bytes;
+    size_t _length;
+    size_t _capacity;
+    NSInteger _depth;
+    
+    NSMutableArray<HKModelPlan *> *_plans;
+    CFMutableDictionaryRef _schemaIndexes;     // Class -> index of schema
+}
+
+- (void)HK_encodeModel:(HKModel *)model;
+- (NSUInteger)HK_schemaIndexOfClass:(Class)modelClass;
+
+@end
+
+@implementation HKModelArchiver
+
+static inline uint8_t *HKArchiverReserve(HKModelArchiver *archiver, size_t length) {
+    if (archiver->_length + length > archiver->_capacity) {
+        size_t capacity = MAX(archiver->_capacity * 2, MAX(archiver->_length + length, 256));
+        archiver->_bytes = realloc(archiver->_bytes, capacity);
+        archiver->_capacity = capacity;
+    }
+    return archiver->_bytes + archiver->_length;
+}
+
+static inline void HKArchiverWriteBytes(HKModelArchiver *archiver, const void *bytes, size_t length) {
+    memcpy(HKArchiverReserve(archiver, length), bytes, length);
+    archiver->_length += length;
+}
+
+static inline void HKArchiverWriteByte(HKModelArchiver *archiver, uint8_t byte) {
+    *HKArchiverReserve(archiver, 1) = byte;
+    archiver->_length++;
+}
+
+static inline void HKArchiverWriteVarint(HKModelArchiver *archiver, uint64_t value) {
+    uint8_t *output = HKArchiverReserve(archiver, 10);
+    size_t length = 0;
+    while (value >= 0x80) {
+        output[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    output[length++] = (uint8_t)value;
+    archiver->_length += length;
+}
+
+static inline void HKArchiverWriteInteger(HKModelArchiver *archiver, long long value) {
+    HKArchiverWriteByte(archiver, HKArchiveTagInteger);
+    HKArchiverWriteVarint(archiver, HKArchiveZigZagEncode(value));
+}
+
+static inline void HKArchiverWriteUnsignedInteger(HKModelArchiver *archiver, unsigned long long value) {
+    if (value <= LLONG_MAX) {
+        HKArchiverWriteInteger(archiver, (long long)value);
+    } else {
+        HKArchiverWriteByte(archiver, HKArchiveTagUnsignedInteger);
+        HKArchiverWriteVarint(archiver, value);
+    }
+}
+
+static inline void HKArchiverWriteFloat(HKModelArchiver *archiver, float value) {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = CFSwapInt32HostToLittle(bits);
+    HKArchiverWriteByte(archiver, HKArchiveTagFloat);
+    HKArchiverWriteBytes(archiver, &bits, sizeof(bits));
+}
+
+static inline void HKArchiverWriteDouble(HKModelArchiver *archiver, double value) {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = CFSwapInt64HostToLittle(bits);
+    HKArchiverWriteByte(archiver, HKArchiveTagDouble);
+    HKArchiverWriteBytes(archiver, &bits, sizeof(bits));
+}
+
+static inline void HKArchiverWriteLengthBytes(HKModelArchiver *archiver, HKArchiveTag tag, const void *bytes, size_t length) {
+    HKArchiverWriteByte(archiver, tag);
+    HKArchiverWriteVarint(archiver, length);
+    HKArchiverWriteBytes(archiver, bytes, length);
+}
+
+static void HKArchiverWriteString(HKModelArchiver *archiver, NSString *string) {
+    NSUInteger maximumLength = [string maximumLengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    char buffer[256];
+    char *bytes = maximumLength <= sizeof(buffer) ? buffer : malloc(maximumLength);
+    NSUInteger length = 0;
+    [string getBytes:bytes maxLength:maximumLength usedLength:&length encoding:NSUTF8StringEncoding options:(NSStringEncodingConversionOptions)0 range:NSMakeRange(0, string.length) remainingRange:NULL];
+    HKArchiverWriteLengthBytes(archiver, HKArchiveTagString, bytes, length);
+    if (bytes != buffer) {
+        free(bytes);
+    }
+}
+
+static void HKArchiverWriteNumber(HKModelArchiver *archiver, NSNumber *number) {
+    if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+        HKArchiverWriteByte(archiver, number.boolValue ? HKArchiveTagTrue : HKArchiveTagFalse);
+        return;
+    }
+    
+    switch (number.objCType[0]) {
+        case 'f':
+            HKArchiverWriteFloat(archiver, number.floatValue);
+            break;
+        case 'd':
+            HKArchiverWriteDouble(archiver, number.doubleValue);
+            break;
+        case 'Q':
+            HKArchiverWriteUnsignedInteger(archiver, number.unsignedLongLongValue);
+            break;
+        default:
+            HKArchiverWriteInteger(archiver, number.longLongValue);
+            break;
+    }
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _plans = [NSMutableArray array];
+        _schemaIndexes = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_bytes);
+    CFRelease(_schemaIndexes);
+}
+
+- (void)encodeObject:(id)object {
+    NSData *data = nil;
+    if (!object || object == NSNull.null) {
+        HKArchiverWriteByte(self, HKArchiveTagNull);
+    } else if ([object isKindOfClass:NSString.class]) {
+        HKArchiverWriteString(self, object);
+    } else if ([object isKindOfClass:NSNumber.class]) {
+        HKArchiverWriteNumber(self, object);
+    } else if ([object isKindOfClass:HKModel.class]) {
+        [self HK_encodeModel:object];
+    } else if ([object isKindOfClass:HKEnum.class]) {
+        HKArchiverWriteInteger(self, ((HKEnum *)object).value);
+    } else if ([object isKindOfClass:HKOption.class]) {
+        HKArchiverWriteInteger(self, ((HKOption *)object).value);
+    } else if ([object isKindOfClass:NSURL.class]) {
+        HKArchiverWriteString(self, ((NSURL *)object).absoluteString);
+    } else if ([object isKindOfClass:NSData.class]) {
+        HKArchiverWriteLengthBytes(self, HKArchiveTagData, ((NSData *)object).bytes, ((NSData *)object).length);
+    } else if ([object isKindOfClass:NSDate.class]) {
+        // seconds since 1970 regardless of NSDate.serializedDateFormat
+        HKArchiverWriteDouble(self, ((NSDate *)object).timeIntervalSince1970);
+    } else if ([object isKindOfClass:NSArray.class]) {
+        if (++_depth > kHKModelArchiveMaximumDepth) {
+            HKArchiverWriteByte(self, HKArchiveTagNull);
+        } else {
+            HKArchiverWriteByte(self, HKArchiveTagArray);
+            HKArchiverWriteVarint(self, ((NSArray *)object).count);
+            for (id value in (NSArray *)object) {
+                [self encodeObject:value];
+            }
+        }
+        _depth--;
+    } else if ([object isKindOfClass:NSDictionary.class]) {
+        if (++_depth > kHKModelArchiveMaximumDepth) {
+            HKArchiverWriteByte(self, HKArchiveTagNull);
+        } else {
+            HKArchiverWriteByte(self, HKArchiveTagDictionary);
+            HKArchiverWriteVarint(self, ((NSDictionary *)object).count);
+            [(NSDictionary *)object enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+                HKArchiverWriteString(self, [key isKindOfClass:NSString.class] ? key : [key description]);
+                [self encodeObject:value];
+            }];
+        }
+        _depth--;
+    } else if ([object conformsToProtocol:@protocol(NSSecureCoding)] && (data = HKArchiveCodedData(object))) {
+        HKArchiverWriteLengthBytes(self, HKArchiveTagCoded, data.bytes, data.length);
+    } else {
+        HKArchiverWriteByte(self, HKArchiveTagNull);
+    }
+}
+
+- (NSData *)encodedData {
+    return [NSData dataWithBytes:_bytes length:_length];
+}
+
+- (NSData *)schemaData {
+    HKModelArchiver *archiver = [[HKModelArchiver alloc] init];
+    HKArchiverWriteVarint(archiver, _plans.count);
+    for (HKModelPlan *plan in _plans) {
+        const char *className = class_getName(plan.modelClass);
+        HKArchiverWriteVarint(archiver, strlen(className));
+        HKArchiverWriteBytes(archiver, className, strlen(className));
+        
+        HKArchiverWriteVarint(archiver, plan.numberOfSlots);
+        const HKModelSlot *slots = plan.slots;
+        for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+            HKArchiverWriteVarint(archiver, slots[index].UTF8KeyLength);
+            HKArchiverWriteBytes(archiver, slots[index].UTF8Key, slots[index].UTF8KeyLength);
+        }
+    }
+    return archiver.encodedData;
+}
+
+- (NSData *)archivedData {
+    NSData *schemaData = self.schemaData;
+    NSMutableData *result = [NSMutableData dataWithCapacity:sizeof(kHKModelArchiveMagic) + 1 + schemaData.length + _length];
+    uint8_t version = (uint8_t)kHKModelArchiveVersion;
+    [result appendBytes:kHKModelArchiveMagic length:sizeof(kHKModelArchiveMagic)];
+    [result appendBytes:&version length:sizeof(version)];
+    [result appendData:schemaData];
+    [result appendBytes:_bytes length:_length];
+    return result;
+}
+
+- (NSUInteger)encodedLength {
+    return _length;
+}
+
+- (void)resetEncodedData {
+    _length = 0;
+}
+
+#pragma mark - private methods
+- (void)HK_encodeModel:(HKModel *)model {
+    if (++_depth > kHKModelArchiveMaximumDepth) {
+        HKArchiverWriteByte(self, HKArchiveTagNull);
+        _depth--;
+        return;
+    }
+    
+    [model materialize];
+    HKModelPlan *plan = [HKModelPlan planWithClass:model.class];
+    HKArchiverWriteByte(self, HKArchiveTagModel);
+    HKArchiverWriteVarint(self, [self HK_schemaIndexOfClass:plan.modelClass]);
+    
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        switch (slot->type) {
+            case HKModelSlotTypeObject:
+            case HKModelSlotTypeModel:
+                [self encodeObject:HKModelSlotGetObject(model, slot)];
+                break;
+            case HKModelSlotTypeBool:
+                HKArchiverWriteByte(self, HKModelSlotGetLongLong(model, slot) ? HKArchiveTagTrue : HKArchiveTagFalse);
+                break;
+            case HKModelSlotTypeUnsignedLong:
+            case HKModelSlotTypeUnsignedLongLong:
+                HKArchiverWriteUnsignedInteger(self, HKModelSlotGetUnsignedLongLong(model, slot));
+                break;
+            case HKModelSlotTypeFloat:
+                HKArchiverWriteFloat(self, (float)HKModelSlotGetDouble(model, slot));
+                break;
+            case HKModelSlotTypeDouble:
+                HKArchiverWriteDouble(self, HKModelSlotGetDouble(model, slot));
+                break;
+            case HKModelSlotTypeStruct:
+                if (slot->offset >= 0) {
+                    HKArchiverWriteLengthBytes(self, HKArchiveTagData, (const uint8_t *)(__bridge void *)model + slot->offset, slot->size);
+                } else {
+                    HKArchiverWriteByte(self, HKArchiveTagNull);
+                }
+                break;
+            case HKModelSlotTypeUnsupported:
+                HKArchiverWriteByte(self, HKArchiveTagNull);
+                break;
+            default:
+                HKArchiverWriteInteger(self, HKModelSlotGetLongLong(model, slot));
+                break;
+        }
+    }
+    _depth--;
+}
+
+- (NSUInteger)HK_schemaIndexOfClass:(Class)modelClass {
+    const void *value = NULL;
+    if (CFDictionaryGetValueIfPresent(_schemaIndexes, (__bridge const void *)modelClass, &value)) {
+        return (NSUInteger)value;
+    }
+    
+    NSUInteger result = _plans.count;
+    [_plans addObject:[HKModelPlan planWithClass:modelClass]];
+    CFDictionarySetValue(_schemaIndexes, (__bridge const void *)modelClass, (const void *)result);
+    return result;
+}
+
+@end
+
+#pragma mark - unarchiver
+/**
+ schema of class in archive
+ */
+@interface HKArchiveSchema : NSObject
+
+@property (nonatomic, copy) NSString *className;
+@property (nonatomic, copy) NSArray<NSString *> *fieldNames;
+
+@end
+
+@implementation HKArchiveSchema
+@end
+
+typedef struct _HKArchiveReader {
+    const uint8_t *start;
+    const uint8_t *cursor;
+    const uint8_t *end;
+    NSInteger depth;
+    HKModelArchiveError error;
+    __unsafe_unretained HKModelUnarchiver *unarchiver;
+    __unsafe_unretained NSArray<HKArchiveSchema *> *schemas;
+    __unsafe_unretained NSData *referencedData;
+    CFAllocatorRef referencedDeallocator;
+    __unsafe_unretained HKModelDecodeContext *context;    // intern table (nil if not in context)
+} HKArchiveReader;
+
+@interface HKModelUnarchiver () {
+    CFAllocatorRef _referencedDeallocator;   // retains referencedData while no-copy strings are alive
+    pthread_mutex_t _mappingsLock;
+    NSMutableDictionary<NSString *, NSData *> *_mappings;   // "index:class" -> slot pointers of fields
+}
+
+@property (nonatomic, copy) NSArray<HKArchiveSchema *> *schemas;
+
+- (instancetype)HK_initWithReader:(HKArchiveReader *)reader;
+- (CFAllocatorRef)HK_referencedDeallocator;
+- (const HKModelSlot * const *)HK_slotsOfSchemaAtIndex:(NSUInteger)index expectedClass:(Class)expectedClass modelClass:(Class *)modelClass;
+
+@end
+
+static void HKArchiveReaderInitialize(HKArchiveReader *reader, const void *bytes, NSUInteger length, HKModelUnarchiver *unarchiver) {
+    memset(reader, 0, sizeof(HKArchiveReader));
+    reader->start = bytes;
+    reader->cursor = bytes;
+    reader->end = reader->start + length;
+    reader->unarchiver = unarchiver;
+    reader->schemas = unarchiver.schemas;
+    reader->context = HKModelDecodeContext.currentContext;
+    
+    NSData *referencedData = unarchiver.referencedData;
+    const uint8_t *referencedBytes = referencedData.bytes;
+    if (referencedBytes && reader->start >= referencedBytes && reader->end <= referencedBytes + referencedData.length) {
+        reader->referencedData = referencedData;
+        reader->referencedDeallocator = [unarchiver HK_referencedDeallocator];
+    }
+}
+
+static inline void HKArchiveFail(HKArchiveReader *reader, HKModelArchiveError error) {
+    reader->error = reader->error ?: error;
+}
+
+static inline BOOL HKArchiveReadByte(HKArchiveReader *reader, uint8_t *byte) {
+    if (reader->cursor >= reader->end) {
+        HKArchiveFail(reader, HKModelArchiveErrorUnexpectedEnd);
+        return NO;
+    }
+    *byte = *reader->cursor++;
+    return YES;
+}
+
+static inline BOOL HKArchiveReadVarint(HKArchiveReader *reader, uint64_t *value) {
+    uint64_t result = 0;
+    for (unsigned int shift = 0; shift < 64 && reader->cursor < reader->end; shift += 7) {
+        uint8_t byte = *reader->cursor++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return YES;
+        }
+    }
+    HKArchiveFail(reader, reader->cursor < reader->end ? HKModelArchiveErrorInvalidValue : HKModelArchiveErrorUnexpectedEnd);
+    return NO;
+}
+
+// varint length + bytes
+static inline BOOL HKArchiveReadBytes(HKArchiveReader *reader, const uint8_t **bytes, size_t *length) {
+    uint64_t value = 0;
+    if (!HKArchiveReadVarint(reader, &value)) {
+        return NO;
+    } else if (value > (uint64_t)(reader->end - reader->cursor)) {
+        HKArchiveFail(reader, HKModelArchiveErrorUnexpectedEnd);
+        return NO;
+    }
+    *bytes = reader->cursor;
+    *length = (size_t)value;
+    reader->cursor += value;
+    return YES;
+}
+
+static inline BOOL HKArchiveReadFixed(HKArchiveReader *reader, void *value, size_t length) {
+    if ((size_t)(reader->end - reader->cursor) < length) {
+        HKArchiveFail(reader, HKModelArchiveErrorUnexpectedEnd);
+        return NO;
+    }
+    memcpy(value, reader->cursor, length);
+    reader->cursor += length;
+    return YES;
+}
+
+static NSString *HKArchiveReadString(HKArchiveReader *reader) {
+    const uint8_t *bytes = NULL;
+    size_t length = 0;
+    if (!HKArchiveReadBytes(reader, &bytes, &length)) {
+        return nil;
+    }
+    NSString *result = nil;
+    if (reader->context) {
+        result = [reader->context internedStringWithUTF8Bytes:(const char *)bytes length:length];
+    } else if (reader->referencedDeallocator) {
+        result = (__bridge_transfer NSString *)CFStringCreateWithBytesNoCopy(kCFAllocatorDefault, bytes, length, kCFStringEncodingUTF8, false, reader->referencedDeallocator);
+    } else {
+        result = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    }
+    if (!result) {
+        HKArchiveFail(reader, HKModelArchiveErrorInvalidValue);
+    }
+    return result;
+}
+
+static NSData *HKArchiveDataWithBytes(HKArchiveReader *reader, const uint8_t *bytes, size_t length) {
+    NSData *referencedData = reader->referencedData;
+    if (!referencedData) {
+        return [NSData dataWithBytes:bytes length:length];
+    }
+    return [[NSData alloc] initWithBytesNoCopy:(void *)bytes length:length deallocator:^(void *bytes, NSUInteger length) {
+        [referencedData self];
+    }];
+}
+
+static void HKArchiveSkipValue(HKArchiveReader *reader);
+
+static void HKArchiveSkipValueOfTag(HKArchiveReader *reader, uint8_t tag) {
+    uint64_t value = 0;
+    const uint8_t *bytes = NULL;
+    size_t length = 0;
+    switch (tag) {
+        case HKArchiveTagNull:
+        case HKArchiveTagFalse:
+        case HKArchiveTagTrue:
+            break;
+        case HKArchiveTagInteger:
+        case HKArchiveTagUnsignedInteger:
+            HKArchiveReadVarint(reader, &value);
+            break;
+        case HKArchiveTagFloat:
+            HKArchiveReadFixed(reader, &value, sizeof(uint32_t));
+            break;
+        case HKArchiveTagDouble:
+            HKArchiveReadFixed(reader, &value, sizeof(uint64_t));
+            break;
+        case HKArchiveTagString:
+        case HKArchiveTagData:
+        case HKArchiveTagCoded:
+            HKArchiveReadBytes(reader, &bytes, &length);
+            break;
+        case HKArchiveTagArray:
+        case HKArchiveTagDictionary:
+            if (++reader->depth > kHKModelArchiveMaximumDepth) {
+                HKArchiveFail(reader, HKModelArchiveErrorTooDeep);
+            } else if (HKArchiveReadVarint(reader, &value)) {
+                for (uint64_t index = 0; index < value && !reader->error; index++) {
+                    tag == HKArchiveTagDictionary ? HKArchiveReadBytes(reader, &bytes, &length) : NO;
+                    HKArchiveSkipValue(reader);
+                }
+            }
+            reader->depth--;
+            break;
+        case HKArchiveTagModel: {
+            if (++reader->depth > kHKModelArchiveMaximumDepth) {
+                HKArchiveFail(reader, HKModelArchiveErrorTooDeep);
+            } else if (HKArchiveReadVarint(reader, &value)) {
+                NSArray<HKArchiveSchema *> *schemas = reader->schemas;
+                if (value >= schemas.count) {
+                    HKArchiveFail(reader, HKModelArchiveErrorInvalidValue);
+                } else {
+                    NSUInteger numberOfFields = schemas[(NSUInteger)value].fieldNames.count;
+                    for (NSUInteger index = 0; index < numberOfFields && !reader->error; index++) {
+                        HKArchiveSkipValue(reader);
+                    }
+                }
+            }
+            reader->depth--;
+            break;
+        }
+        default:
+            HKArchiveFail(reader, HKModelArchiveErrorInvalidValue);
+            break;
+    }
+}
+
+static void HKArchiveSkipValue(HKArchiveReader *reader) {
+    uint8_t tag = 0;
+    if (HKArchiveReadByte(reader, &tag)) {
+        HKArchiveSkipValueOfTag(reader, tag);
+    }
+}
+
+static id HKArchiveReadObject(HKArchiveReader *reader, __unsafe_unretained Class expectedClass);
+static id HKArchiveReadObjectOfTag(HKArchiveReader *reader, uint8_t tag, __unsafe_unretained Class expectedClass);
+
+static id HKArchiveReadModel(HKArchiveReader *reader, __unsafe_unretained Class expectedClass) {
+    uint64_t schemaIndex = 0;
+    if (!HKArchiveReadVarint(reader, &schemaIndex)) {
+        return nil;
+    }
+    
+    HKModelUnarchiver *unarchiver = reader->unarchiver;
+    NSArray<HKArchiveSchema *> *schemas = reader->schemas;
+    if (schemaIndex >= schemas.count) {
+        HKArchiveFail(reader, HKModelArchiveErrorInvalidValue);
+        return nil;
+    }
+    if (++reader->depth > kHKModelArchiveMaximumDepth) {
+        HKArchiveFail(reader, HKModelArchiveErrorTooDeep);
+        return nil;
+    }
+    
+    NSUInteger numberOfFields = schemas[(NSUInteger)schemaIndex].fieldNames.count;
+    Class modelClass = Nil;
+    const HKModelSlot * const *slots = [unarchiver HK_slotsOfSchemaAtIndex:(NSUInteger)schemaIndex expectedClass:expectedClass modelClass:&modelClass];
+    HKModel *result = modelClass ? [[modelClass alloc] init] : nil;
+    
+    for (NSUInteger index = 0; index < numberOfFields && !reader->error; index++) {
+        const HKModelSlot *slot = result ? slots[index] : NULL;
+        uint8_t tag = 0;
+        if (!HKArchiveReadByte(reader, &tag)) {
+            break;
+        } else if (!slot || tag == HKArchiveTagNull) {
+            HKArchiveSkipValueOfTag(reader, tag);
+            continue;
+        }
+        
+        // numbers are set without boxing
+        uint64_t value = 0;
+        if (HKModelSlotTypeIsNumber(slot->type) || slot->classKind == HKModelSlotClassKindEnum || slot->classKind == HKModelSlotClassKindOption) {
+            BOOL isNumber = slot->type != HKModelSlotTypeModel;
+            switch (tag) {
+                case HKArchiveTagFalse:
+                case HKArchiveTagTrue:
+                    if (isNumber) {
+                        HKModelSlotSetLongLong(result, slot, tag == HKArchiveTagTrue);
+                        continue;
+                    }
+                    break;
+                case HKArchiveTagInteger:
+                    if (!HKArchiveReadVarint(reader, &value)) {
+                        continue;
+                    } else if (isNumber) {
+                        HKModelSlotSetLongLong(result, slot, HKArchiveZigZagDecode(value));
+                    } else {
+                        NSInteger integer = (NSInteger)HKArchiveZigZagDecode(value);
+                        HKModelSlotSetObject(result, slot, slot->classKind == HKModelSlotClassKindEnum ? [slot->propertyClass enumWithValue:integer] : [slot->propertyClass optionWithValue:integer]);
+                    }
+                    continue;
+                case HKArchiveTagUnsignedInteger:
+                    if (isNumber && HKArchiveReadVarint(reader, &value)) {
+                        HKModelSlotSetUnsignedLongLong(result, slot, value);
+                        continue;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (reader->error) {
+            break;
+        }
+        
+        if (slot->type == HKModelSlotTypeStruct) {
+            const uint8_t *bytes = NULL;
+            size_t length = 0;
+            if (tag != HKArchiveTagData) {
+                HKArchiveSkipValueOfTag(reader, tag);
+            } else if (HKArchiveReadBytes(reader, &bytes, &length) && length == slot->size) {
+                HKModelSlotSetSerializedObject(result, slot, [NSValue value:bytes withObjCType:slot->objCType]);
+            }
+            continue;
+        }
+        
+        id object = HKArchiveReadObjectOfTag(reader, tag, slot->propertyClass);
+        if (!object || object == NSNull.null) {
+            continue;
+        } else if (slot->type == HKModelSlotTypeObject || [object isKindOfClass:slot->propertyClass] || (slot->classKind == HKModelSlotClassKindArray && [object isKindOfClass:NSArray.class])) {
+            // model array is already converted by HKArchiveReadObjectOfTag
+            HKModelSlotSetObject(result, slot, object);
+        } else if (slot->classKind == HKModelSlotClassKindDate && [object isKindOfClass:NSNumber.class]) {
+            HKModelSlotSetObject(result, slot, [NSDate dateWithTimeIntervalSince1970:((NSNumber *)object).doubleValue]);
+        } else {
+            HKModelSlotSetSerializedObject(result, slot, object);
+        }
+    }
+    reader->depth--;
+    
+    if (reader->error) {
+        return nil;
+    }
+    return result && reader->context && [HKModelPlan planWithClass:modelClass].isInternable ? [reader->context internedModel:result] : result;
+}
+
+static id HKArchiveReadObjectOfTag(HKArchiveReader *reader, uint8_t tag, __unsafe_unretained Class expectedClass) {
+    uint64_t value = 0;
+    const uint8_t *bytes = NULL;
+    size_t length = 0;
+    switch (tag) {
+        case HKArchiveTagNull:
+            return NSNull.null;
+        case HKArchiveTagFalse:
+            return @NO;
+        case HKArchiveTagTrue:
+            return @YES;
+        case HKArchiveTagInteger:
+            return HKArchiveReadVarint(reader, &value) ? @(HKArchiveZigZagDecode(value)) : nil;
+        case HKArchiveTagUnsignedInteger:
+            return HKArchiveReadVarint(reader, &value) ? @((unsigned long long)value) : nil;
+        case HKArchiveTagFloat: {
+            uint32_t bits = 0;
+            float result = 0;
+            if (!HKArchiveReadFixed(reader, &bits, sizeof(bits))) {
+                return nil;
+            }
+            bits = CFSwapInt32LittleToHost(bits);
+            memcpy(&result, &bits, sizeof(result));
+            return @(result);
+        }
+        case HKArchiveTagDouble: {
+            uint64_t bits = 0;
+            double result = 0;
+            if (!HKArchiveReadFixed(reader, &bits, sizeof(bits))) {
+                return nil;
+            }
+            bits = CFSwapInt64LittleToHost(bits);
+            memcpy(&result, &bits, sizeof(result));
+            return @(result);
+        }
+        case HKArchiveTagString:
+            return HKArchiveReadString(reader);
+        case HKArchiveTagData:
+            return HKArchiveReadBytes(reader, &bytes, &length) ? HKArchiveDataWithBytes(reader, bytes, length) : nil;
+        case HKArchiveTagArray: {
+            if (!HKArchiveReadVarint(reader, &value)) {
+                return nil;
+            } else if (++reader->depth > kHKModelArchiveMaximumDepth) {
+                HKArchiveFail(reader, HKModelArchiveErrorTooDeep);
+                return nil;
+            }
+            
+            BOOL isModelArray = [expectedClass isSubclassOfClass:HKArray.class];
+            Class objectClass = isModelArray ? [expectedClass objectClass] : Nil;
+            BOOL isConvertible = [objectClass conformsToProtocol:@protocol(HKModel)];
+            BOOL isDateArray = [objectClass isSubclassOfClass:NSDate.class];
+            NSMutableArray *result = isModelArray ? [expectedClass array] : [NSMutableArray array];
+            for (uint64_t index = 0; index < value; index++) {
+                id object = HKArchiveReadObject(reader, objectClass);
+                if (reader->error) {
+                    return nil;
+                } else if (isModelArray) {
+                    // same as modelWithSerializedObject: of HKArray (nil is dropped)
+                    object = object == NSNull.null ? nil : object;
+                    // date is archived as seconds since 1970
+                    object = isDateArray && [object isKindOfClass:NSNumber.class] ? [NSDate dateWithTimeIntervalSince1970:((NSNumber *)object).doubleValue] : object;
+                    object = object && isConvertible && ![object isKindOfClass:objectClass] ? [objectClass modelWithSerializedObject:object] : object;
+                }
+                object ? [result addObject:object] : nil;
+            }
+            reader->depth--;
+            return result;
+        }
+        case HKArchiveTagDictionary: {
+            if (!HKArchiveReadVarint(reader, &value)) {
+                return nil;
+            } else if (++reader->depth > kHKModelArchiveMaximumDepth) {
+                HKArchiveFail(reader, HKModelArchiveErrorTooDeep);
+                return nil;
+            }
+            
+            NSMutableDictionary *result = [NSMutableDictionary dictionary];
+            for (uint64_t index = 0; index < value; index++) {
+                NSString *key = HKArchiveReadString(reader);
+                id object = key ? HKArchiveReadObject(reader, Nil) : nil;
+                if (reader->error) {
+                    return nil;
+                }
+                result[key] = object;
+            }
+            reader->depth--;
+            return result;
+        }
+        case HKArchiveTagModel:
+            return HKArchiveReadModel(reader, expectedClass);
+        case HKArchiveTagCoded: {
+            if (!HKArchiveReadBytes(reader, &bytes, &length)) {
+                return nil;
+            }
+            id result = nil;
+            @try {
+                result = HKArchiveCodedObject([NSData dataWithBytesNoCopy:(void *)bytes length:length freeWhenDone:NO], expectedClass);
+            } @catch (NSException *exception) {
+                HKArchiveFail(reader, HKModelArchiveErrorInvalidValue);
+            }
+            return result ?: NSNull.null;
+        }
+        default:
+            HKArchiveFail(reader, HKModelArchiveErrorInvalidValue);
+            return nil;
+    }
+}
+
+static id HKArchiveReadObject(HKArchiveReader *reader, __unsafe_unretained Class expectedClass) {
+    uint8_t tag = 0;
+    return HKArchiveReadByte(reader, &tag) ? HKArchiveReadObjectOfTag(reader, tag, expectedClass) : nil;
+}
+
+static NSError *HKArchiveError(HKArchiveReader *reader) {
+    static NSString *descriptions[] = {
+        [HKModelArchiveErrorInvalidHeader] = @"invalid header",
+        [HKModelArchiveErrorUnexpectedEnd] = @"unexpected end of data",
+        [HKModelArchiveErrorInvalidValue] = @"invalid value",
+        [HKModelArchiveErrorTooDeep] = @"too deep nesting",
+    };
+    NSString *description = [NSString stringWithFormat:@"%@ at offset %lu", descriptions[reader->error], (unsigned long)(reader->cursor - reader->start)];
+    return [NSError errorWithDomain:HKModelArchiveErrorDomain code:reader->error userInfo:@{ NSLocalizedDescriptionKey : description }];
+}
+
+@implementation HKModelUnarchiver
+
++ (id)unarchiveObjectOfClass:(Class)objectClass fromData:(NSData *)data error:(NSError * _Nullable __autoreleasing *)error {
+    HKArchiveReader reader;
+    HKArchiveReaderInitialize(&reader, data.bytes, data.length, nil);
+    
+    uint8_t magic[sizeof(kHKModelArchiveMagic)] = { 0 };
+    uint8_t version = 0;
+    if (!HKArchiveReadFixed(&reader, magic, sizeof(magic)) || memcmp(magic, kHKModelArchiveMagic, sizeof(magic)) != 0 || !HKArchiveReadByte(&reader, &version) || version != kHKModelArchiveVersion) {
+        reader.error = HKModelArchiveErrorInvalidHeader;
+    }
+    
+    HKModelUnarchiver *unarchiver = reader.error ? nil : [[self alloc] HK_initWithReader:&reader];
+    reader.unarchiver = unarchiver;
+    reader.schemas = unarchiver.schemas;
+    id result = unarchiver ? HKArchiveReadObject(&reader, objectClass) : nil;
+    
+    if (reader.error) {
+        error ? *error = HKArchiveError(&reader) : nil;
+        return nil;
+    }
+    return result == NSNull.null ? nil : result;
+}
+
+- (instancetype)initWithSchemaBytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable __autoreleasing *)error {
+    HKArchiveReader reader;
+    HKArchiveReaderInitialize(&reader, bytes, length, nil);
+    self = [self HK_initWithReader:&reader];
+    if (!self) {
+        error ? *error = HKArchiveError(&reader) : nil;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_referencedDeallocator) {
+        CFRelease(_referencedDeallocator);
+    }
+    pthread_mutex_destroy(&_mappingsLock);
+}
+
+- (void)setReferencedData:(NSData *)referencedData {
+    pthread_mutex_lock(&_mappingsLock);
+    _referencedData = referencedData;
+    if (_referencedDeallocator) {
+        CFRelease(_referencedDeallocator);
+        _referencedDeallocator = NULL;
+    }
+    pthread_mutex_unlock(&_mappingsLock);
+}
+
+- (id)decodeObjectOfClass:(Class)objectClass bytes:(const void *)bytes length:(NSUInteger)length error:(NSError * _Nullable __autoreleasing *)error {
+    HKArchiveReader reader;
+    HKArchiveReaderInitialize(&reader, bytes, length, self);
+    id result = HKArchiveReadObject(&reader, objectClass);
+    
+    if (reader.error) {
+        error ? *error = HKArchiveError(&reader) : nil;
+        return nil;
+    }
+    return result == NSNull.null ? nil : result;
+}
+
+#pragma mark - private methods
+static void *HKReferencedAllocate(CFIndex allocSize, CFOptionFlags hint, void *info) {
+    return NULL;
+}
+
+static void HKReferencedDeallocate(void *ptr, void *info) {
+    // bytes are owned by referenced data
+}
+
+- (CFAllocatorRef)HK_referencedDeallocator {
+    pthread_mutex_lock(&_mappingsLock);
+    if (!_referencedDeallocator && _referencedData) {
+        CFAllocatorContext context = {
+            .version = 0,
+            .info = (__bridge void *)_referencedData,
+            .retain = CFRetain,
+            .release = CFRelease,
+            .allocate = HKReferencedAllocate,
+            .deallocate = HKReferencedDeallocate,
+        };
+        _referencedDeallocator = CFAllocatorCreate(kCFAllocatorDefault, &context);
+    }
+    CFAllocatorRef result = _referencedDeallocator;
+    pthread_mutex_unlock(&_mappingsLock);
+    return result;
+}
+
+- (instancetype)HK_initWithReader:(HKArchiveReader *)reader {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_mappingsLock, NULL);
+        _mappings = [NSMutableDictionary dictionary];
+        
+        uint64_t numberOfSchemas = 0;
+        if (!HKArchiveReadVarint(reader, &numberOfSchemas)) {
+            return nil;
+        }
+        NSMutableArray<HKArchiveSchema *> *schemas = [NSMutableArray array];
+        for (uint64_t index = 0; index < numberOfSchemas; index++) {
+            HKArchiveSchema *schema = [[HKArchiveSchema alloc] init];
+            schema.className = HKArchiveReadString(reader);
+            
+            uint64_t numberOfFields = 0;
+            if (!schema.className || !HKArchiveReadVarint(reader, &numberOfFields)) {
+                return nil;
+            }
+            NSMutableArray<NSString *> *fieldNames = [NSMutableArray array];
+            for (uint64_t field = 0; field < numberOfFields; field++) {
+                NSString *fieldName = HKArchiveReadString(reader);
+                if (!fieldName) {
+                    return nil;
+                }
+                [fieldNames addObject:fieldName];
+            }
+            schema.fieldNames = fieldNames;
+            [schemas addObject:schema];
+        }
+        _schemas = [schemas copy];
+    }
+    return self;
+}
+
+// slots of current class for fields of schema (NULL for removed property), class is resolved by name or expected class
+- (const HKModelSlot * const *)HK_slotsOfSchemaAtIndex:(NSUInteger)index expectedClass:(Class)expectedClass modelClass:(Class *)modelClass {
+    HKArchiveSchema *schema = _schemas[index];
+    Class class = NSClassFromString(schema.className);
+    if (![class isSubclassOfClass:HKModel.class] || (expectedClass && ![class isSubclassOfClass:expectedClass])) {
+        class = [expectedClass isSubclassOfClass:HKModel.class] ? expectedClass : Nil;
+    }
+    *modelClass = class;
+    if (!class) {
+        return NULL;
+    }
+    
+    NSString *key = [NSString stringWithFormat:@"%lu:%s", (unsigned long)index, class_getName(class)];
+    pthread_mutex_lock(&_mappingsLock);
+    NSData *mapping = _mappings[key];
+    if (!mapping) {
+        HKModelPlan *plan = [HKModelPlan planWithClass:class];
+        NSMutableData *slots = [NSMutableData dataWithLength:MAX(schema.fieldNames.count, 1) * sizeof(const HKModelSlot *)];
+        const HKModelSlot **pointers = slots.mutableBytes;
+        [schema.fieldNames enumerateObjectsUsingBlock:^(NSString *fieldName, NSUInteger field, BOOL *stop) {
+            pointers[field] = [plan slotForKey:fieldName];
+        }];
+        _mappings[key] = mapping = slots;
+    }
+    pthread_mutex_unlock(&_mappingsLock);
+    
+    return mapping.bytes;
+}
+
+@end
+
+#pragma mark - HKModel
+@implementation HKModel (Archive)
+
+- (NSData *)archivedData {
+    HKModelArchiver *archiver = [[HKModelArchiver alloc] init];
+    [archiver encodeObject:self];
+    return archiver.archivedData;
+}
+
++ (instancetype)modelWithArchivedData:(NSData *)data error:(NSError * _Nullable __autoreleasing *)error {
+    id result = [HKModelUnarchiver unarchiveObjectOfClass:self fromData:data error:error];
+    return [result isKindOfClass:self] ? result : nil;
+}
+
+@end
+
+#pragma mark - HKArray
+@implementation HKArray (Archive)
+
++ (instancetype)modelWithArchivedData:(NSData *)data error:(NSError * _Nullable __autoreleasing *)error {
+    id result = [HKModelUnarchiver unarchiveObjectOfClass:self fromData:data error:error];
+    return [result isKindOfClass:NSArray.class] ? result : nil;
+}
+
+@end
+
+#pragma mark - NSArray
+@implementation NSArray (Archive)
+
+- (NSData *)archivedData {
+    HKModelArchiver *archiver = [[HKModelArchiver alloc] init];
+    [archiver encodeObject:self];
+    return archiver.archivedData;
+}
+
+@end
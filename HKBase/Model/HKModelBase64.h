@@ -0,0 +1,93 @@
+//
+//  HKModelBase64.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ length of Base64 text of bytes (with padding)
+
+ @param length length of bytes
+ @return length of text
+ */
+NS_INLINE size_t HKModelBase64EncodedLength(size_t length) {
+    return (length + 2) / 3 * 4;
+}
+/**
+ maximum length of bytes decoded from Base64 text
+
+ @param length length of text
+ @return maximum length of bytes
+ */
+NS_INLINE size_t HKModelBase64DecodedMaximumLength(size_t length) {
+    return (length + 3) / 4 * 3;
+}
+
+/**
+ encode bytes to Base64 text (standard alphabet with padding)
+ 64 characters are encoded at once with NEON on arm64
+
+ @param bytes bytes
+ @param length length of bytes
+ @param buffer buffer of HKModelBase64EncodedLength(length) (not null terminated)
+ @return length of text
+ */
+OBJC_EXTERN size_t HKModelBase64Encode(const void *bytes, size_t length, char *buffer);
+/**
+ decode Base64 text to bytes
+ standard and URL safe alphabets are allowed, padding is optional and whitespace (ex. line break of MIME) is skipped
+ 64 characters are decoded at once with NEON on arm64
+
+ @param text text (not null terminated)
+ @param length length of text
+ @param buffer buffer of HKModelBase64DecodedMaximumLength(length)
+ @param decodedLength length of decoded bytes
+ @return text is valid Base64
+ */
+OBJC_EXTERN BOOL HKModelBase64Decode(const char *text, size_t length, void *buffer, size_t *decodedLength);
+
+/**
+ data decoded from Base64 text into single buffer
+
+ @param text text (not null terminated)
+ @param length length of text
+ @return data (nil if text is not valid Base64)
+ */
+OBJC_EXTERN NSData * _Nullable HKModelBase64DataWithBytes(const char *text, size_t length);
+/**
+ data decoded from Base64 string (bytes of ASCII string are used without copy)
+
+ @param string Base64 string
+ @return data (nil if string is not valid Base64)
+ */
+OBJC_EXTERN NSData * _Nullable HKModelBase64DataWithString(NSString *string);
+/**
+ Base64 string of data encoded into single buffer
+
+ @param data data
+ @return Base64 string
+ */
+OBJC_EXTERN NSString *HKModelBase64StringWithData(NSData *data);
+
+NS_ASSUME_NONNULL_END
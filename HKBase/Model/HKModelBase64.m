@@ -0,0 +1,253 @@
+//
+//  HKModelBase64.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelBase64.h"
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#import <arm_neon.h>
+#define HK_BASE64_NEON 1
+#endif
+
+static const uint8_t kHKBase64Whitespace = 0xFE;
+static const uint8_t kHKBase64Padding = 0xFD;
+
+static const char HKBase64EncodeTable[64] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// value of character (0xFE: whitespace, 0xFD: padding, 0xFF: invalid), '-' and '_' are URL safe alphabet
+static const uint8_t HKBase64DecodeTable[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0x3E, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+size_t HKModelBase64Encode(const void *bytes, size_t length, char *buffer) {
+    const uint8_t *input = bytes;
+    char *output = buffer;
+    
+#if HK_BASE64_NEON
+    // 48 bytes to 64 characters (deinterleaved load, table lookup of 6 bit values, interleaved store)
+    const uint8x16x4_t table = vld1q_u8_x4((const uint8_t *)HKBase64EncodeTable);
+    const uint8x16_t mask = vdupq_n_u8(0x3F);
+    while (length >= 48) {
+        uint8x16x3_t in = vld3q_u8(input);
+        uint8x16x4_t indexes;
+        indexes.val[0] = vshrq_n_u8(in.val[0], 2);
+        indexes.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask);
+        indexes.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask);
+        indexes.val[3] = vandq_u8(in.val[2], mask);
+        
+        uint8x16x4_t out;
+        out.val[0] = vqtbl4q_u8(table, indexes.val[0]);
+        out.val[1] = vqtbl4q_u8(table, indexes.val[1]);
+        out.val[2] = vqtbl4q_u8(table, indexes.val[2]);
+        out.val[3] = vqtbl4q_u8(table, indexes.val[3]);
+        vst4q_u8((uint8_t *)output, out);
+        
+        input += 48;
+        output += 64;
+        length -= 48;
+    }
+#endif
+    
+    while (length >= 3) {
+        uint32_t word = ((uint32_t)input[0] << 16) | ((uint32_t)input[1] << 8) | input[2];
+        output[0] = HKBase64EncodeTable[word >> 18];
+        output[1] = HKBase64EncodeTable[(word >> 12) & 0x3F];
+        output[2] = HKBase64EncodeTable[(word >> 6) & 0x3F];
+        output[3] = HKBase64EncodeTable[word & 0x3F];
+        input += 3;
+        output += 4;
+        length -= 3;
+    }
+    
+    if (length > 0) {
+        uint32_t word = ((uint32_t)input[0] << 16) | (length > 1 ? (uint32_t)input[1] << 8 : 0);
+        output[0] = HKBase64EncodeTable[word >> 18];
+        output[1] = HKBase64EncodeTable[(word >> 12) & 0x3F];
+        output[2] = length > 1 ? HKBase64EncodeTable[(word >> 6) & 0x3F] : '=';
+        output[3] = '=';
+        output += 4;
+    }
+    
+    return (size_t)(output - buffer);
+}
+
+#if HK_BASE64_NEON
+// values of 16 characters (characters over 0x7F are 0, checked by caller)
+static inline uint8x16_t HKBase64LookupNEON(uint8x16_t characters, uint8x16x4_t lowTable, uint8x16x4_t highTable) {
+    uint8x16_t values = vqtbl4q_u8(lowTable, characters);
+    return vqtbx4q_u8(values, highTable, vsubq_u8(characters, vdupq_n_u8(64)));
+}
+#endif
+
+BOOL HKModelBase64Decode(const char *text, size_t length, void *buffer, size_t *decodedLength) {
+    const uint8_t *cursor = (const uint8_t *)text;
+    const uint8_t *end = cursor + length;
+    uint8_t *output = buffer;
+    uint32_t quad = 0;
+    NSUInteger numberOfValues = 0;     // values in quad
+    BOOL isPadded = NO;
+    
+#if HK_BASE64_NEON
+    const uint8x16x4_t lowTable = vld1q_u8_x4(HKBase64DecodeTable);
+    const uint8x16x4_t highTable = vld1q_u8_x4(HKBase64DecodeTable + 64);
+#endif
+    
+    while (cursor < end) {
+#if HK_BASE64_NEON
+        // 64 characters to 48 bytes, block with whitespace, padding or invalid character is decoded by scalar loop
+        while (numberOfValues == 0 && end - cursor >= 64) {
+            uint8x16x4_t in = vld4q_u8(cursor);
+            uint8x16_t a = HKBase64LookupNEON(in.val[0], lowTable, highTable);
+            uint8x16_t b = HKBase64LookupNEON(in.val[1], lowTable, highTable);
+            uint8x16_t c = HKBase64LookupNEON(in.val[2], lowTable, highTable);
+            uint8x16_t d = HKBase64LookupNEON(in.val[3], lowTable, highTable);
+            uint8x16_t characters = vorrq_u8(vorrq_u8(in.val[0], in.val[1]), vorrq_u8(in.val[2], in.val[3]));
+            uint8x16_t values = vorrq_u8(vorrq_u8(a, b), vorrq_u8(c, d));
+            if (vmaxvq_u8(vorrq_u8(values, vandq_u8(characters, vdupq_n_u8(0x80)))) > 0x3F) {
+                break;
+            }
+            
+            uint8x16x3_t out;
+            out.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+            out.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+            out.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+            vst3q_u8(output, out);
+            cursor += 64;
+            output += 48;
+        }
+#endif
+        
+        // whole quads of valid characters
+        while (numberOfValues == 0 && end - cursor >= 4) {
+            uint32_t a = HKBase64DecodeTable[cursor[0]];
+            uint32_t b = HKBase64DecodeTable[cursor[1]];
+            uint32_t c = HKBase64DecodeTable[cursor[2]];
+            uint32_t d = HKBase64DecodeTable[cursor[3]];
+            if ((a | b | c | d) > 0x3F) {
+                break;
+            }
+            uint32_t word = (a << 18) | (b << 12) | (c << 6) | d;
+            output[0] = (uint8_t)(word >> 16);
+            output[1] = (uint8_t)(word >> 8);
+            output[2] = (uint8_t)word;
+            cursor += 4;
+            output += 3;
+        }
+        if (cursor >= end) {
+            break;
+        }
+        
+        // single character (whitespace, padding or tail)
+        uint8_t value = HKBase64DecodeTable[*cursor++];
+        if (value <= 0x3F) {
+            quad = (quad << 6) | value;
+            if (++numberOfValues == 4) {
+                output[0] = (uint8_t)(quad >> 16);
+                output[1] = (uint8_t)(quad >> 8);
+                output[2] = (uint8_t)quad;
+                output += 3;
+                quad = 0;
+                numberOfValues = 0;
+            }
+        } else if (value == kHKBase64Padding) {
+            isPadded = YES;
+            break;
+        } else if (value != kHKBase64Whitespace) {
+            return NO;
+        }
+    }
+    
+    // only padding and whitespace are allowed after padding
+    while (isPadded && cursor < end) {
+        uint8_t value = HKBase64DecodeTable[*cursor++];
+        if (value != kHKBase64Padding && value != kHKBase64Whitespace) {
+            return NO;
+        }
+    }
+    
+    switch (numberOfValues) {
+        case 1:
+            return NO;
+        case 2:
+            *output++ = (uint8_t)(quad >> 4);
+            break;
+        case 3:
+            *output++ = (uint8_t)(quad >> 10);
+            *output++ = (uint8_t)(quad >> 2);
+            break;
+        default:
+            break;
+    }
+    
+    *decodedLength = (size_t)(output - (uint8_t *)buffer);
+    return YES;
+}
+
+#pragma mark - data
+NSData *HKModelBase64DataWithBytes(const char *text, size_t length) {
+    size_t capacity = HKModelBase64DecodedMaximumLength(length);
+    uint8_t *buffer = malloc(MAX(capacity, 1));
+    size_t decodedLength = 0;
+    if (!HKModelBase64Decode(text, length, buffer, &decodedLength)) {
+        free(buffer);
+        return nil;
+    }
+    return [NSData dataWithBytesNoCopy:buffer length:decodedLength freeWhenDone:YES];
+}
+
+NSData *HKModelBase64DataWithString(NSString *string) {
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    const char *bytes = CFStringGetCStringPtr(cfString, kCFStringEncodingASCII);
+    if (bytes) {
+        return HKModelBase64DataWithBytes(bytes, strlen(bytes));
+    }
+    
+    // non ASCII characters are replaced and rejected
+    CFIndex length = CFStringGetLength(cfString);
+    char *text = malloc(MAX((size_t)length, 1));
+    CFIndex usedLength = 0;
+    CFStringGetBytes(cfString, CFRangeMake(0, length), kCFStringEncodingASCII, '?', false, (UInt8 *)text, length, &usedLength);
+    NSData *result = HKModelBase64DataWithBytes(text, (size_t)usedLength);
+    free(text);
+    return result;
+}
+
+NSString *HKModelBase64StringWithData(NSData *data) {
+    size_t length = HKModelBase64EncodedLength(data.length);
+    char *buffer = malloc(MAX(length, 1));
+    HKModelBase64Encode(data.bytes, data.length, buffer);
+    return [[NSString alloc] initWithBytesNoCopy:buffer length:length encoding:NSASCIIStringEncoding freeWhenDone:YES];
+}
@@ -0,0 +1,99 @@
+//
+//  HKModelChanges.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModelPlan.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class HKModel;
+
+/**
+ changed properties of model (HKModel.isChangeTracking)
+ bitset of slot indexes, set by wrapped setters
+ */
+@interface HKModelChanges : NSObject
+
+/**
+ prepare class for change tracking (wrap setters of object and number properties once)
+ wrapper calls IMP of class at preparing time (chained with lazy materialization)
+
+ @param plan plan of model class
+ */
++ (void)prepareWithPlan:(HKModelPlan *)plan;
+
+- (instancetype)init NS_UNAVAILABLE;
+/**
+ empty changes
+
+ @param plan plan of model class
+ @return changes
+ */
+- (instancetype)initWithPlan:(HKModelPlan *)plan NS_DESIGNATED_INITIALIZER;
+
+/**
+ plan of model class
+ */
+@property (nonatomic, readonly) HKModelPlan *plan;
+/**
+ any slot is changed
+ */
+@property (nonatomic, readonly, getter=isChanged) BOOL changed;
+
+/**
+ mark slot as changed
+
+ @param slot slot of plan
+ */
+- (void)markSlot:(const HKModelSlot *)slot;
+/**
+ slot is changed
+
+ @param slot slot of plan
+ @return YES if changed
+ */
+- (BOOL)isChangedSlot:(const HKModelSlot *)slot;
+/**
+ clear all marks
+ */
+- (void)reset;
+
+@end
+
+/**
+ setter of model is called (defined in HKModel.m)
+ ignored while model is decoded or patched
+
+ @param model model object
+ @param slot slot of setter (slot of superclass plan is matched by key)
+ */
+OBJC_EXTERN void HKModelDidChangeSlot(HKModel *model, const HKModelSlot *slot);
+/**
+ immutable model is shared (defined in HKModel.m)
+ setter asserts after frozen unless assertions are disabled (NS_BLOCK_ASSERTIONS)
+
+ @param model model object
+ */
+OBJC_EXTERN void HKModelFreeze(HKModel *model);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,164 @@
+//
+//  HKModelChanges.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelChanges.h"
+#import "HKModel.h"
+#import "HKMethod.h"
+
+#import <objc/runtime.h>
+#import <pthread.h>
+
+static pthread_mutex_t HKModelChangesClassesLock = PTHREAD_MUTEX_INITIALIZER;
+static CFMutableSetRef HKModelChangesClasses = NULL;
+
+#define HKChangesSetterMethod(type) [HKMethod methodWithSelector:setter block:^(HKModel *model, type value) { \
+    ((void (*)(id, SEL, type))implementation)(model, setter, value); \
+    HKModelDidChangeSlot(model, slot); \
+}]
+
+@interface HKModelChanges () {
+    uint64_t *_bits;
+    NSUInteger _numberOfWords;
+}
+
+@end
+
+@implementation HKModelChanges
+
++ (void)prepareWithPlan:(HKModelPlan *)plan {
+    Class modelClass = plan.modelClass;
+    
+    pthread_mutex_lock(&HKModelChangesClassesLock);
+    if (!HKModelChangesClasses) {
+        HKModelChangesClasses = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    }
+    if (CFSetContainsValue(HKModelChangesClasses, (__bridge const void *)modelClass)) {
+        pthread_mutex_unlock(&HKModelChangesClassesLock);
+        return;
+    }
+    
+    // struct and unsupported properties are not tracked
+    // wrapper calls current IMP of class (ex. setter wrapped by lazy materialization)
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        SEL setter = slot->setter;
+        IMP implementation = (setter && class_respondsToSelector(modelClass, setter)) ? class_getMethodImplementation(modelClass, setter) : NULL;
+        if (!implementation) {
+            continue;
+        }
+        
+        HKMethod *method = nil;
+        switch (slot->type) {
+            case HKModelSlotTypeObject:
+            case HKModelSlotTypeModel:
+                method = HKChangesSetterMethod(id);
+                break;
+            case HKModelSlotTypeBool:
+                method = HKChangesSetterMethod(bool);
+                break;
+            case HKModelSlotTypeChar:
+                method = HKChangesSetterMethod(char);
+                break;
+            case HKModelSlotTypeUnsignedChar:
+                method = HKChangesSetterMethod(unsigned char);
+                break;
+            case HKModelSlotTypeShort:
+                method = HKChangesSetterMethod(short);
+                break;
+            case HKModelSlotTypeUnsignedShort:
+                method = HKChangesSetterMethod(unsigned short);
+                break;
+            case HKModelSlotTypeInt:
+                method = HKChangesSetterMethod(int);
+                break;
+            case HKModelSlotTypeUnsignedInt:
+                method = HKChangesSetterMethod(unsigned int);
+                break;
+            case HKModelSlotTypeLong:
+                method = HKChangesSetterMethod(long);
+                break;
+            case HKModelSlotTypeUnsignedLong:
+                method = HKChangesSetterMethod(unsigned long);
+                break;
+            case HKModelSlotTypeLongLong:
+                method = HKChangesSetterMethod(long long);
+                break;
+            case HKModelSlotTypeUnsignedLongLong:
+                method = HKChangesSetterMethod(unsigned long long);
+                break;
+            case HKModelSlotTypeFloat:
+                method = HKChangesSetterMethod(float);
+                break;
+            case HKModelSlotTypeDouble:
+                method = HKChangesSetterMethod(double);
+                break;
+            default:
+                break;
+        }
+        if (method) {
+            [modelClass replaceInstanceMethod:method];
+            HKModelPlanRegisterWrapperImplementation(method.implementation, implementation);
+        }
+    }
+    
+    CFSetAddValue(HKModelChangesClasses, (__bridge const void *)modelClass);
+    pthread_mutex_unlock(&HKModelChangesClassesLock);
+}
+
+- (instancetype)initWithPlan:(HKModelPlan *)plan {
+    self = [super init];
+    if (self) {
+        _plan = plan;
+        _numberOfWords = MAX((plan.numberOfSlots + 63) / 64, 1);
+        _bits = calloc(_numberOfWords, sizeof(uint64_t));
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_bits);
+}
+
+- (BOOL)isChanged {
+    for (NSUInteger index = 0; index < _numberOfWords; index++) {
+        if (_bits[index]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (void)markSlot:(const HKModelSlot *)slot {
+    _bits[slot->index / 64] |= (uint64_t)1 << (slot->index % 64);
+}
+
+- (BOOL)isChangedSlot:(const HKModelSlot *)slot {
+    return (_bits[slot->index / 64] & ((uint64_t)1 << (slot->index % 64))) != 0;
+}
+
+- (void)reset {
+    memset(_bits, 0, _numberOfWords * sizeof(uint64_t));
+}
+
+@end
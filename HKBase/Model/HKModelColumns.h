@@ -0,0 +1,193 @@
+//
+//  HKModelColumns.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ storage type of column
+
+ - HKModelColumnTypeInteger: integer and bool properties (int64_t values, unsigned values are stored as bit pattern)
+ - HKModelColumnTypeDouble: float and double properties (double values)
+ - HKModelColumnTypeCode: HKEnum and HKOption properties (uint32_t code of distinct object, 0 is nil)
+ - HKModelColumnTypeString: NSString properties (UTF-8 bytes and offset table)
+ - HKModelColumnTypeObject: other object and struct properties (objects)
+ */
+typedef NS_ENUM(NSInteger, HKModelColumnType) {
+    HKModelColumnTypeInteger = 0,
+    HKModelColumnTypeDouble,
+    HKModelColumnTypeCode,
+    HKModelColumnTypeString,
+    HKModelColumnTypeObject,
+};
+
+/**
+ values of one property in contiguous memory (immutable)
+ */
+@interface HKModelColumn : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ property name
+ */
+@property (nonatomic, readonly) NSString *key;
+/**
+ storage type
+ */
+@property (nonatomic, readonly) HKModelColumnType type;
+/**
+ number of values
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ values of HKModelColumnTypeInteger (NULL for other type)
+ */
+@property (nonatomic, readonly, nullable) const int64_t *integers;
+/**
+ values of HKModelColumnTypeDouble (NULL for other type)
+ */
+@property (nonatomic, readonly, nullable) const double *doubles;
+/**
+ values of HKModelColumnTypeCode (NULL for other type)
+ */
+@property (nonatomic, readonly, nullable) const uint32_t *codes;
+/**
+ distinct objects of HKModelColumnTypeCode (object of code is codeObjects[code - 1])
+ */
+@property (nonatomic, readonly, nullable) NSArray *codeObjects;
+/**
+ UTF-8 bytes of HKModelColumnTypeString (NULL for other type)
+ string at index is bytes in [offsets[index], offsets[index + 1])
+ */
+@property (nonatomic, readonly, nullable) const char *UTF8Bytes;
+/**
+ offsets of HKModelColumnTypeString (count + 1 values, NULL for other type)
+ */
+@property (nonatomic, readonly, nullable) const uint64_t *offsets;
+
+/**
+ value is nil (HKModelColumnTypeCode, HKModelColumnTypeString and HKModelColumnTypeObject)
+
+ @param index index of value
+ @return YES if nil
+ */
+- (BOOL)isNilAtIndex:(NSUInteger)index;
+/**
+ value as object (number -> NSNumber, string -> NSString, struct -> NSValue)
+
+ @param index index of value
+ @return object
+ */
+- (nullable id)objectAtIndex:(NSUInteger)index;
+- (nullable id)objectAtIndexedSubscript:(NSUInteger)index;
+
+/**
+ code of object (HKModelColumnTypeCode)
+
+ @param object object
+ @return code (0 for nil, NSNotFound if object is not in column)
+ */
+- (NSUInteger)codeOfObject:(nullable id)object;
+
+/**
+ count values equal to object, compared without boxing (ex. code, UTF-8 bytes)
+
+ @param object object (NSNumber for number column)
+ @return number of values
+ */
+- (NSUInteger)countOfObject:(nullable id)object;
+/**
+ indexes of values equal to object, compared without boxing
+
+ @param object object (NSNumber for number column)
+ @return indexes
+ */
+- (NSIndexSet *)indexesOfObject:(nullable id)object;
+
+@end
+
+/**
+ columnar representation of models (struct of arrays)
+ each property of model class is stored in column, model of row is made on demand
+ ex. [[columns columnForKey:@"brand"] countOfObject:HKBrand.Master]
+ */
+@interface HKModelColumns<ObjectType : HKModel *> : NSObject
+
+/**
+ columns of models
+
+ @param models models (kind of modelClass)
+ @param modelClass class of models
+ @return columns
+ */
++ (instancetype)columnsWithModels:(NSArray<ObjectType> *)models modelClass:(Class)modelClass;
+/**
+ columns of serialized objects (ex. JSON array)
+ rows are decoded in small batches, so all models do not exist at once
+
+ @param serializedObject array of serialized object
+ @param modelClass class of models
+ @return columns (nil if serializedObject is not array)
+ */
++ (nullable instancetype)columnsWithSerializedObject:(id)serializedObject modelClass:(Class)modelClass;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ class of models
+ */
+@property (nonatomic, unsafe_unretained, readonly) Class modelClass;
+/**
+ number of rows
+ */
+@property (nonatomic, readonly) NSUInteger count;
+/**
+ columns (same order as slots of HKModelPlan, unsupported properties are excluded)
+ */
+@property (nonatomic, readonly) NSArray<HKModelColumn *> *columns;
+
+/**
+ column of property
+
+ @param key property name
+ @return column (nil if property is not in columns)
+ */
+- (nullable HKModelColumn *)columnForKey:(NSString *)key;
+- (nullable HKModelColumn *)objectForKeyedSubscript:(NSString *)key;
+
+/**
+ model of row (new instance for each call, changes are not written to columns)
+
+ @param index index of row
+ @return model
+ */
+- (ObjectType)modelAtIndex:(NSUInteger)index;
+- (ObjectType)objectAtIndexedSubscript:(NSUInteger)index;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,490 @@
+//
+//  HKModelColumns.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelColumns.h"
+#import "HKModelPlan.h"
+
+static const NSUInteger kHKModelColumnsBatchCount = 1024;  // rows decoded at once by columnsWithSerializedObject:
+
+static HKModelColumnType HKModelColumnTypeOfSlot(const HKModelSlot *slot, BOOL *isSupported) {
+    *isSupported = YES;
+    switch (slot->type) {
+        case HKModelSlotTypeUnsupported:
+            *isSupported = NO;
+            return HKModelColumnTypeObject;
+        case HKModelSlotTypeFloat:
+        case HKModelSlotTypeDouble:
+            return HKModelColumnTypeDouble;
+        case HKModelSlotTypeObject:
+        case HKModelSlotTypeStruct:
+            return HKModelColumnTypeObject;
+        case HKModelSlotTypeModel:
+            switch (slot->classKind) {
+                case HKModelSlotClassKindEnum:
+                case HKModelSlotClassKindOption:
+                    return HKModelColumnTypeCode;
+                case HKModelSlotClassKindString:
+                    return HKModelColumnTypeString;
+                default:
+                    return HKModelColumnTypeObject;
+            }
+        default:
+            return HKModelColumnTypeInteger;
+    }
+}
+
+NS_INLINE BOOL HKModelSlotIsUnsigned(const HKModelSlot *slot) {
+    return slot->type == HKModelSlotTypeUnsignedLong || slot->type == HKModelSlotTypeUnsignedLongLong;
+}
+
+#pragma mark - column
+@interface HKModelColumn () {
+    const HKModelSlot *_slot;       // owned by cached plan
+    NSUInteger _capacity;
+    
+    int64_t *_integers;
+    double *_doubles;
+    
+    uint32_t *_codes;
+    CFMutableDictionaryRef _codeTable;  // object -> code
+    NSMutableArray *_codeObjects;
+    
+    char *_UTF8Bytes;
+    size_t _UTF8Length;
+    size_t _UTF8Capacity;
+    uint64_t *_offsets;
+    uint64_t *_nils;                // bitset of nil strings
+    
+    __strong id *_objects;
+}
+
+- (instancetype)HK_initWithSlot:(const HKModelSlot *)slot type:(HKModelColumnType)type capacity:(NSUInteger)capacity;
+- (void)HK_setValueOfModel:(id)model atIndex:(NSUInteger)index;
+- (void)HK_setValueAtIndex:(NSUInteger)index toModel:(id)model;
+- (void)HK_setCount:(NSUInteger)count;
+- (NSUInteger)HK_matchObject:(id)object indexes:(NSMutableIndexSet *)indexes;
+
+@end
+
+@implementation HKModelColumn
+
+- (instancetype)HK_initWithSlot:(const HKModelSlot *)slot type:(HKModelColumnType)type capacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        _slot = slot;
+        _key = slot->key;
+        _type = type;
+        _capacity = MAX(capacity, 1);
+        
+        switch (type) {
+            case HKModelColumnTypeInteger:
+                _integers = calloc(_capacity, sizeof(int64_t));
+                break;
+            case HKModelColumnTypeDouble:
+                _doubles = calloc(_capacity, sizeof(double));
+                break;
+            case HKModelColumnTypeCode:
+                _codes = calloc(_capacity, sizeof(uint32_t));
+                _codeTable = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+                _codeObjects = [NSMutableArray array];
+                break;
+            case HKModelColumnTypeString:
+                _offsets = calloc(_capacity + 1, sizeof(uint64_t));
+                _nils = calloc((_capacity + 63) / 64, sizeof(uint64_t));
+                break;
+            case HKModelColumnTypeObject:
+                _objects = (__strong id *)calloc(_capacity, sizeof(id));
+                break;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_integers);
+    free(_doubles);
+    free(_codes);
+    _codeTable ? CFRelease(_codeTable) : (void)0;
+    free(_UTF8Bytes);
+    free(_offsets);
+    free(_nils);
+    if (_objects) {
+        for (NSUInteger index = 0; index < _capacity; index++) {
+            _objects[index] = nil;
+        }
+        free(_objects);
+    }
+}
+
+- (NSArray *)codeObjects {
+    return _codeObjects;
+}
+
+#pragma mark build
+// values are set in order of index
+- (void)HK_setValueOfModel:(id)model atIndex:(NSUInteger)index {
+    const HKModelSlot *slot = _slot;
+    switch (_type) {
+        case HKModelColumnTypeInteger:
+            _integers[index] = HKModelSlotIsUnsigned(slot) ? (int64_t)HKModelSlotGetUnsignedLongLong(model, slot) : (int64_t)HKModelSlotGetLongLong(model, slot);
+            break;
+        case HKModelColumnTypeDouble:
+            _doubles[index] = HKModelSlotGetDouble(model, slot);
+            break;
+        case HKModelColumnTypeCode: {
+            id object = HKModelSlotGetObject(model, slot);
+            uint32_t code = 0;
+            if (object) {
+                const void *value = NULL;
+                if (CFDictionaryGetValueIfPresent(_codeTable, (__bridge const void *)object, &value)) {
+                    code = (uint32_t)(uintptr_t)value;
+                } else {
+                    [_codeObjects addObject:object];
+                    code = (uint32_t)_codeObjects.count;
+                    CFDictionarySetValue(_codeTable, (__bridge const void *)object, (const void *)(uintptr_t)code);
+                }
+            }
+            _codes[index] = code;
+            break;
+        }
+        case HKModelColumnTypeString: {
+            NSString *string = HKModelSlotGetObject(model, slot);
+            if (![string isKindOfClass:NSString.class]) {
+                _nils[index / 64] |= (uint64_t)1 << (index % 64);
+            } else {
+                NSUInteger maximumLength = [string maximumLengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+                if (_UTF8Length + maximumLength > _UTF8Capacity) {
+                    _UTF8Capacity = MAX(_UTF8Capacity * 2, _UTF8Length + maximumLength);
+                    _UTF8Bytes = realloc(_UTF8Bytes, _UTF8Capacity);
+                }
+                NSUInteger usedLength = 0;
+                [string getBytes:_UTF8Bytes + _UTF8Length maxLength:maximumLength usedLength:&usedLength encoding:NSUTF8StringEncoding options:(NSStringEncodingConversionOptions)0 range:NSMakeRange(0, string.length) remainingRange:NULL];
+                _UTF8Length += usedLength;
+            }
+            _offsets[index + 1] = _UTF8Length;
+            break;
+        }
+        case HKModelColumnTypeObject:
+            _objects[index] = HKModelSlotGetObject(model, slot);
+            break;
+    }
+}
+
+- (void)HK_setCount:(NSUInteger)count {
+    _count = count;
+    if (_codeTable) {
+        CFRelease(_codeTable);
+        _codeTable = NULL;
+    }
+}
+
+#pragma mark access
+- (const int64_t *)integers {
+    return _integers;
+}
+
+- (const double *)doubles {
+    return _doubles;
+}
+
+- (const uint32_t *)codes {
+    return _codes;
+}
+
+- (const char *)UTF8Bytes {
+    return _type == HKModelColumnTypeString ? (_UTF8Bytes ?: "") : NULL;
+}
+
+- (const uint64_t *)offsets {
+    return _offsets;
+}
+
+- (BOOL)isNilAtIndex:(NSUInteger)index {
+    switch (_type) {
+        case HKModelColumnTypeCode:
+            return _codes[index] == 0;
+        case HKModelColumnTypeString:
+            return (_nils[index / 64] & ((uint64_t)1 << (index % 64))) != 0;
+        case HKModelColumnTypeObject:
+            return _objects[index] == nil;
+        default:
+            return NO;
+    }
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    if (index >= _count) {
+        return nil;
+    }
+    
+    switch (_type) {
+        case HKModelColumnTypeInteger:
+            return HKModelSlotIsUnsigned(_slot) ? @((unsigned long long)_integers[index]) : @(_integers[index]);
+        case HKModelColumnTypeDouble:
+            return @(_doubles[index]);
+        case HKModelColumnTypeCode:
+            return _codes[index] ? _codeObjects[_codes[index] - 1] : nil;
+        case HKModelColumnTypeString:
+            if ([self isNilAtIndex:index]) {
+                return nil;
+            }
+            return [[NSString alloc] initWithBytes:_UTF8Bytes + _offsets[index] length:(NSUInteger)(_offsets[index + 1] - _offsets[index]) encoding:NSUTF8StringEncoding];
+        case HKModelColumnTypeObject:
+            return _objects[index];
+    }
+    return nil;
+}
+
+- (id)objectAtIndexedSubscript:(NSUInteger)index {
+    return [self objectAtIndex:index];
+}
+
+- (void)HK_setValueAtIndex:(NSUInteger)index toModel:(id)model {
+    const HKModelSlot *slot = _slot;
+    switch (_type) {
+        case HKModelColumnTypeInteger:
+            HKModelSlotIsUnsigned(slot) ? HKModelSlotSetUnsignedLongLong(model, slot, (unsigned long long)_integers[index]) : HKModelSlotSetLongLong(model, slot, _integers[index]);
+            break;
+        case HKModelColumnTypeDouble:
+            HKModelSlotSetDouble(model, slot, _doubles[index]);
+            break;
+        case HKModelColumnTypeCode:
+        case HKModelColumnTypeString: {
+            id object = [self objectAtIndex:index];
+            object ? HKModelSlotSetObject(model, slot, object) : nil;
+            break;
+        }
+        case HKModelColumnTypeObject:
+            if (_objects[index]) {
+                slot->type == HKModelSlotTypeStruct ? HKModelSlotSetSerializedObject(model, slot, _objects[index]) : HKModelSlotSetObject(model, slot, _objects[index]);
+            }
+            break;
+    }
+}
+
+#pragma mark scan
+- (NSUInteger)codeOfObject:(id)object {
+    if (!object) {
+        return 0;
+    }
+    NSUInteger index = [_codeObjects indexOfObject:object];
+    return index == NSNotFound ? NSNotFound : index + 1;
+}
+
+- (NSUInteger)countOfObject:(id)object {
+    return [self HK_matchObject:object indexes:nil];
+}
+
+- (NSIndexSet *)indexesOfObject:(id)object {
+    NSMutableIndexSet *result = [NSMutableIndexSet indexSet];
+    [self HK_matchObject:object indexes:result];
+    return result;
+}
+
+// count-only loops are branchless (vectorizable)
+#define HKColumnMatch(condition) \
+if (indexes) { \
+    for (NSUInteger index = 0; index < count; index++) { \
+        if (condition) { \
+            [indexes addIndex:index]; \
+            result++; \
+        } \
+    } \
+} else { \
+    for (NSUInteger index = 0; index < count; index++) { \
+        result += (condition) ? 1 : 0; \
+    } \
+}
+
+- (NSUInteger)HK_matchObject:(id)object indexes:(NSMutableIndexSet *)indexes {
+    NSUInteger count = _count;
+    NSUInteger result = 0;
+    switch (_type) {
+        case HKModelColumnTypeInteger: {
+            if (![object isKindOfClass:NSNumber.class]) {
+                break;
+            }
+            const int64_t *values = _integers;
+            int64_t value = HKModelSlotIsUnsigned(_slot) ? (int64_t)((NSNumber *)object).unsignedLongLongValue : ((NSNumber *)object).longLongValue;
+            HKColumnMatch(values[index] == value);
+            break;
+        }
+        case HKModelColumnTypeDouble: {
+            if (![object isKindOfClass:NSNumber.class]) {
+                break;
+            }
+            const double *values = _doubles;
+            double value = ((NSNumber *)object).doubleValue;
+            HKColumnMatch(values[index] == value);
+            break;
+        }
+        case HKModelColumnTypeCode: {
+            NSUInteger code = [self codeOfObject:object];
+            if (code == NSNotFound) {
+                break;
+            }
+            const uint32_t *values = _codes;
+            uint32_t value = (uint32_t)code;
+            HKColumnMatch(values[index] == value);
+            break;
+        }
+        case HKModelColumnTypeString: {
+            if (!object) {
+                HKColumnMatch([self isNilAtIndex:index]);
+                break;
+            } else if (![object isKindOfClass:NSString.class]) {
+                break;
+            }
+            NSData *data = [(NSString *)object dataUsingEncoding:NSUTF8StringEncoding];
+            const void *bytes = data.bytes;
+            uint64_t length = data.length;
+            const char *UTF8Bytes = self.UTF8Bytes;
+            const uint64_t *offsets = _offsets;
+            HKColumnMatch(offsets[index + 1] - offsets[index] == length && !memcmp(UTF8Bytes + offsets[index], bytes, (size_t)length) && (length || ![self isNilAtIndex:index]));
+            break;
+        }
+        case HKModelColumnTypeObject: {
+            __strong id *values = _objects;
+            HKColumnMatch(values[index] == object || [values[index] isEqual:object]);
+            break;
+        }
+    }
+    return result;
+}
+
+#undef HKColumnMatch
+
+@end
+
+#pragma mark - columns
+@interface HKModelColumns () {
+    HKModelPlan *_plan;
+    NSDictionary<NSString *, HKModelColumn *> *_columnsByKey;
+}
+
+- (instancetype)HK_initWithModelClass:(Class)modelClass capacity:(NSUInteger)capacity;
+- (void)HK_setModels:(NSArray *)models atIndex:(NSUInteger)index;
+- (void)HK_setCount:(NSUInteger)count;
+
+@end
+
+@implementation HKModelColumns
+
++ (instancetype)columnsWithModels:(NSArray *)models modelClass:(Class)modelClass {
+    HKModelColumns *result = [[self alloc] HK_initWithModelClass:modelClass capacity:models.count];
+    [result HK_setModels:models atIndex:0];
+    [result HK_setCount:models.count];
+    return result;
+}
+
++ (instancetype)columnsWithSerializedObject:(id)serializedObject modelClass:(Class)modelClass {
+    if (![serializedObject isKindOfClass:NSArray.class]) {
+        return nil;
+    }
+    
+    NSArray *objects = serializedObject;
+    NSUInteger count = objects.count;
+    HKModelColumns *result = [[self alloc] HK_initWithModelClass:modelClass capacity:count];
+    NSUInteger numberOfRows = 0;
+    for (NSUInteger location = 0; location < count; location += kHKModelColumnsBatchCount) {
+        @autoreleasepool {
+            NSMutableArray *models = [NSMutableArray arrayWithCapacity:kHKModelColumnsBatchCount];
+            for (NSUInteger index = location; index < MIN(location + kHKModelColumnsBatchCount, count); index++) {
+                id model = [modelClass modelWithSerializedObject:objects[index]];
+                model ? [models addObject:model] : nil;
+            }
+            [result HK_setModels:models atIndex:numberOfRows];
+            numberOfRows += models.count;
+        }
+    }
+    [result HK_setCount:numberOfRows];
+    return result;
+}
+
+- (instancetype)HK_initWithModelClass:(Class)modelClass capacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        _modelClass = modelClass;
+        _plan = [HKModelPlan planWithClass:modelClass];
+        
+        NSMutableArray<HKModelColumn *> *columns = [NSMutableArray arrayWithCapacity:_plan.numberOfSlots];
+        NSMutableDictionary<NSString *, HKModelColumn *> *columnsByKey = [NSMutableDictionary dictionaryWithCapacity:_plan.numberOfSlots];
+        const HKModelSlot *slots = _plan.slots;
+        for (NSUInteger index = 0; index < _plan.numberOfSlots; index++) {
+            BOOL isSupported = NO;
+            HKModelColumnType type = HKModelColumnTypeOfSlot(&slots[index], &isSupported);
+            if (isSupported) {
+                HKModelColumn *column = [[HKModelColumn alloc] HK_initWithSlot:&slots[index] type:type capacity:capacity];
+                [columns addObject:column];
+                columnsByKey[column.key] = column;
+            }
+        }
+        _columns = [columns copy];
+        _columnsByKey = [columnsByKey copy];
+    }
+    return self;
+}
+
+// column by column for sequential write
+- (void)HK_setModels:(NSArray *)models atIndex:(NSUInteger)index {
+    [models makeObjectsPerformSelector:@selector(materialize)];
+    for (HKModelColumn *column in _columns) {
+        NSUInteger row = index;
+        for (id model in models) {
+            [column HK_setValueOfModel:model atIndex:row++];
+        }
+    }
+}
+
+- (void)HK_setCount:(NSUInteger)count {
+    _count = count;
+    for (HKModelColumn *column in _columns) {
+        [column HK_setCount:count];
+    }
+}
+
+- (HKModelColumn *)columnForKey:(NSString *)key {
+    return _columnsByKey[key];
+}
+
+- (HKModelColumn *)objectForKeyedSubscript:(NSString *)key {
+    return [self columnForKey:key];
+}
+
+- (id)modelAtIndex:(NSUInteger)index {
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"index %lu beyond bounds [0 .. %lu]", (unsigned long)index, (unsigned long)_count];
+    }
+    
+    HKModel *result = [[_modelClass alloc] init];
+    for (HKModelColumn *column in _columns) {
+        [column HK_setValueAtIndex:index toModel:result];
+    }
+    return result;
+}
+
+- (id)objectAtIndexedSubscript:(NSUInteger)index {
+    return [self modelAtIndex:index];
+}
+
+@end
@@ -0,0 +1,71 @@
+//
+//  HKModelDate.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ maximum length of ISO 8601 text (ex. -292277022657-01-27T08:29:52.000+14:00)
+ */
+static const size_t kHKModelDateISO8601MaximumLength = 48;
+
+/**
+ parse ISO 8601 date without NSDateFormatter
+ extended (2018-08-23T12:34:56.789+09:00) and basic (20180823T123456Z) formats, date only and space separator are allowed
+ time without offset is UTC
+
+ @param bytes bytes of text (not null terminated)
+ @param length length of bytes
+ @param timeInterval seconds since 1970
+ @return text is valid date
+ */
+OBJC_EXTERN BOOL HKModelDateParseISO8601(const char *bytes, NSUInteger length, NSTimeInterval *timeInterval);
+/**
+ parse ISO 8601 date of string without allocation
+
+ @param string string (ex. "2018-08-23T12:34:56Z")
+ @param timeInterval seconds since 1970
+ @return string is valid date
+ */
+OBJC_EXTERN BOOL HKModelDateParseISO8601String(NSString *string, NSTimeInterval *timeInterval);
+/**
+ format ISO 8601 date with milliseconds (fraction is omitted if zero)
+ offset of time zone is cached until next daylight saving time transition
+
+ @param timeInterval seconds since 1970
+ @param timeZone time zone of text (nil: UTC as 'Z')
+ @param buffer buffer of kHKModelDateISO8601MaximumLength
+ @return length of text (not null terminated)
+ */
+OBJC_EXTERN size_t HKModelDateFormatISO8601(NSTimeInterval timeInterval, NSTimeZone * _Nullable timeZone, char *buffer);
+
+/**
+ seconds since 1970 of serialized epoch number (milliseconds if NSDate.serializedDateFormat is HKDateFormatEpochMilliseconds)
+
+ @param epoch serialized number
+ @return seconds since 1970
+ */
+OBJC_EXTERN NSTimeInterval HKModelDateTimeIntervalWithEpoch(double epoch);
+
+NS_ASSUME_NONNULL_END
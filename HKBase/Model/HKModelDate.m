@@ -0,0 +1,270 @@
+//
+//  HKModelDate.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelDate.h"
+#import "HKModel.h"
+#import <pthread.h>
+
+static const NSInteger kHKModelDateSecondsPerDay = 86400;
+
+// offset of time zone is same until next transition (most recent one is cached)
+static pthread_mutex_t HKModelDateOffsetLock = PTHREAD_MUTEX_INITIALIZER;
+static NSTimeZone *HKModelDateOffsetTimeZone = nil;
+static NSInteger HKModelDateOffset = 0;
+static NSTimeInterval HKModelDateOffsetStart = 0;
+static NSTimeInterval HKModelDateOffsetEnd = 0;
+
+#pragma mark - civil date
+// days since 1970-01-01 of proleptic Gregorian date
+static long long HKDaysFromCivil(long long year, int month, int day) {
+    year -= month <= 2;
+    long long era = (year >= 0 ? year : year - 399) / 400;
+    long long yearOfEra = year - era * 400;
+    long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+static void HKCivilFromDays(long long days, long long *year, int *month, int *day) {
+    days += 719468;
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    long long dayOfEra = days - era * 146097;
+    long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long long monthOfYear = (5 * dayOfYear + 2) / 153;
+    *day = (int)(dayOfYear - (153 * monthOfYear + 2) / 5 + 1);
+    *month = (int)(monthOfYear < 10 ? monthOfYear + 3 : monthOfYear - 9);
+    *year = yearOfEra + era * 400 + (*month <= 2);
+}
+
+static inline BOOL HKIsLeapYear(long long year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static inline int HKDaysInMonth(long long year, int month) {
+    static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return month == 2 && HKIsLeapYear(year) ? 29 : days[month - 1];
+}
+
+#pragma mark - parse
+// fixed count of digits
+static inline BOOL HKReadDigits(const char **cursor, const char *end, int count, int *value) {
+    const char *position = *cursor;
+    if (end - position < count) {
+        return NO;
+    }
+    int result = 0;
+    for (int index = 0; index < count; index++) {
+        char character = position[index];
+        if (character < '0' || character > '9') {
+            return NO;
+        }
+        result = result * 10 + (character - '0');
+    }
+    *cursor = position + count;
+    *value = result;
+    return YES;
+}
+
+static inline BOOL HKConsume(const char **cursor, const char *end, char character) {
+    if (*cursor < end && **cursor == character) {
+        (*cursor)++;
+        return YES;
+    }
+    return NO;
+}
+
+BOOL HKModelDateParseISO8601(const char *bytes, NSUInteger length, NSTimeInterval *timeInterval) {
+    const char *cursor = bytes;
+    const char *end = bytes + length;
+    
+    int year = 0, month = 0, day = 0;
+    if (!HKReadDigits(&cursor, end, 4, &year)) {
+        return NO;
+    }
+    BOOL isExtended = HKConsume(&cursor, end, '-');
+    if (!HKReadDigits(&cursor, end, 2, &month) || (isExtended && !HKConsume(&cursor, end, '-')) || !HKReadDigits(&cursor, end, 2, &day)) {
+        return NO;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > HKDaysInMonth(year, month)) {
+        return NO;
+    }
+    
+    int hour = 0, minute = 0, second = 0;
+    double fraction = 0;
+    NSInteger offset = 0;
+    if (cursor < end && (*cursor == 'T' || *cursor == 't' || *cursor == ' ')) {
+        cursor++;
+        if (!HKReadDigits(&cursor, end, 2, &hour)) {
+            return NO;
+        }
+        BOOL hasColon = HKConsume(&cursor, end, ':');
+        if (!HKReadDigits(&cursor, end, 2, &minute)) {
+            return NO;
+        }
+        // seconds are optional
+        if ((hasColon && HKConsume(&cursor, end, ':')) || (!hasColon && cursor < end && *cursor >= '0' && *cursor <= '9')) {
+            if (!HKReadDigits(&cursor, end, 2, &second)) {
+                return NO;
+            }
+            if (cursor < end && (*cursor == '.' || *cursor == ',')) {
+                cursor++;
+                const char *start = cursor;
+                long long digits = 0;
+                long long scale = 1;
+                // nanoseconds at most
+                for (; cursor < end && *cursor >= '0' && *cursor <= '9'; cursor++) {
+                    if (scale < 1000000000LL) {
+                        digits = digits * 10 + (*cursor - '0');
+                        scale *= 10;
+                    }
+                }
+                if (cursor == start) {
+                    return NO;
+                }
+                fraction = (double)digits / (double)scale;
+            }
+        }
+        if (hour > 24 || minute > 59 || second > 60 || (hour == 24 && (minute || second || fraction > 0))) {
+            return NO;
+        }
+        
+        if (cursor < end && (*cursor == 'Z' || *cursor == 'z')) {
+            cursor++;
+        } else if (cursor < end && (*cursor == '+' || *cursor == '-')) {
+            BOOL isNegative = *cursor++ == '-';
+            int offsetHour = 0, offsetMinute = 0;
+            if (!HKReadDigits(&cursor, end, 2, &offsetHour)) {
+                return NO;
+            }
+            if (HKConsume(&cursor, end, ':') ? !HKReadDigits(&cursor, end, 2, &offsetMinute) : (cursor < end && !HKReadDigits(&cursor, end, 2, &offsetMinute))) {
+                return NO;
+            }
+            if (offsetHour > 23 || offsetMinute > 59) {
+                return NO;
+            }
+            offset = (offsetHour * 3600 + offsetMinute * 60) * (isNegative ? -1 : 1);
+        }
+    }
+    if (cursor != end) {
+        return NO;
+    }
+    
+    long long seconds = HKDaysFromCivil(year, month, day) * kHKModelDateSecondsPerDay + hour * 3600 + minute * 60 + second - offset;
+    *timeInterval = (NSTimeInterval)seconds + fraction;
+    return YES;
+}
+
+BOOL HKModelDateParseISO8601String(NSString *string, NSTimeInterval *timeInterval) {
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    CFIndex length = CFStringGetLength(cfString);
+    // shortest is 20180823, longer text is not date
+    if (length < 8 || length > (CFIndex)kHKModelDateISO8601MaximumLength) {
+        return NO;
+    }
+    const char *bytes = CFStringGetCStringPtr(cfString, kCFStringEncodingASCII);
+    if (bytes) {
+        return HKModelDateParseISO8601(bytes, (NSUInteger)length, timeInterval);
+    }
+    char buffer[kHKModelDateISO8601MaximumLength];
+    CFIndex usedLength = 0;
+    CFStringGetBytes(cfString, CFRangeMake(0, length), kCFStringEncodingASCII, '?', false, (UInt8 *)buffer, sizeof(buffer), &usedLength);
+    return HKModelDateParseISO8601(buffer, (NSUInteger)usedLength, timeInterval);
+}
+
+#pragma mark - format
+static NSInteger HKModelDateOffsetOfTimeZone(NSTimeZone *timeZone, NSTimeInterval timeInterval) {
+    pthread_mutex_lock(&HKModelDateOffsetLock);
+    if (timeZone != HKModelDateOffsetTimeZone || timeInterval < HKModelDateOffsetStart || timeInterval >= HKModelDateOffsetEnd) {
+        NSDate *date = [NSDate dateWithTimeIntervalSince1970:timeInterval];
+        NSDate *transition = [timeZone nextDaylightSavingTimeTransitionAfterDate:date];
+        HKModelDateOffsetTimeZone = timeZone;
+        HKModelDateOffset = [timeZone secondsFromGMTForDate:date];
+        HKModelDateOffsetStart = timeInterval;
+        HKModelDateOffsetEnd = transition ? transition.timeIntervalSince1970 : INFINITY;
+    }
+    NSInteger result = HKModelDateOffset;
+    pthread_mutex_unlock(&HKModelDateOffsetLock);
+    return result;
+}
+
+static inline char *HKWriteDigits(char *cursor, long long value, int count) {
+    for (int index = count - 1; index >= 0; index--) {
+        cursor[index] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    return cursor + count;
+}
+
+size_t HKModelDateFormatISO8601(NSTimeInterval timeInterval, NSTimeZone *timeZone, char *buffer) {
+    NSInteger offset = timeZone ? HKModelDateOffsetOfTimeZone(timeZone, timeInterval) : 0;
+    long long milliseconds = llround(timeInterval * 1000.0) + (long long)offset * 1000;
+    long long seconds = milliseconds >= 0 ? milliseconds / 1000 : -((-milliseconds + 999) / 1000);
+    int millisecond = (int)(milliseconds - seconds * 1000);
+    long long days = seconds >= 0 ? seconds / kHKModelDateSecondsPerDay : -((-seconds + kHKModelDateSecondsPerDay - 1) / kHKModelDateSecondsPerDay);
+    long long secondOfDay = seconds - days * kHKModelDateSecondsPerDay;
+    
+    long long year = 0;
+    int month = 0, day = 0;
+    HKCivilFromDays(days, &year, &month, &day);
+    
+    char *cursor = buffer;
+    if (year < 0) {
+        *cursor++ = '-';
+        year = -year;
+    }
+    int numberOfYearDigits = 4;
+    for (long long limit = 10000; year >= limit && numberOfYearDigits < 18; limit *= 10) {
+        numberOfYearDigits++;
+    }
+    cursor = HKWriteDigits(cursor, year, numberOfYearDigits);
+    *cursor++ = '-';
+    cursor = HKWriteDigits(cursor, month, 2);
+    *cursor++ = '-';
+    cursor = HKWriteDigits(cursor, day, 2);
+    *cursor++ = 'T';
+    cursor = HKWriteDigits(cursor, secondOfDay / 3600, 2);
+    *cursor++ = ':';
+    cursor = HKWriteDigits(cursor, secondOfDay / 60 % 60, 2);
+    *cursor++ = ':';
+    cursor = HKWriteDigits(cursor, secondOfDay % 60, 2);
+    if (millisecond) {
+        *cursor++ = '.';
+        cursor = HKWriteDigits(cursor, millisecond, 3);
+    }
+    
+    if (!timeZone) {
+        *cursor++ = 'Z';
+    } else {
+        *cursor++ = offset < 0 ? '-' : '+';
+        NSInteger absoluteOffset = offset < 0 ? -offset : offset;
+        cursor = HKWriteDigits(cursor, absoluteOffset / 3600, 2);
+        *cursor++ = ':';
+        cursor = HKWriteDigits(cursor, absoluteOffset / 60 % 60, 2);
+    }
+    return (size_t)(cursor - buffer);
+}
+
+NSTimeInterval HKModelDateTimeIntervalWithEpoch(double epoch) {
+    return NSDate.serializedDateFormat == HKDateFormatEpochMilliseconds ? epoch / 1000.0 : epoch;
+}
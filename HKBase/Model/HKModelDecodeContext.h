@@ -0,0 +1,96 @@
+//
+//  HKModelDecodeContext.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ shared values of decoding (intern table)
+ while performing block, equal strings and URLs are decoded as same instance,
+ and equal models of immutable class (HKModel.isImmutable) are decoded as same instance
+ context can be used for one decoding or kept for long-lived session (thread safe)
+ 
+ [context performBlock:^{
+    response = [HKCardResponse modelWithJSONData:data error:&error];
+ }];
+ */
+@interface HKModelDecodeContext : NSObject
+
+/**
+ context of current thread (performing block)
+ */
+@property (class, nonatomic, readonly, nullable) HKModelDecodeContext *currentContext;
+
+/**
+ perform block with context as current context of thread
+ concurrent decoding in block (ex. HKArray.concurrentThreshold) uses context too
+
+ @param block block for decode
+ */
+- (void)performBlock:(void (NS_NOESCAPE ^)(void))block;
+
+/**
+ interned string
+
+ @param string string
+ @return interned string equal to string
+ */
+- (NSString *)internedString:(NSString *)string;
+/**
+ interned string of UTF-8 bytes (string is not allocated if already interned)
+
+ @param bytes UTF-8 bytes (not null terminated)
+ @param length length of bytes
+ @return interned string (nil if bytes are not valid UTF-8)
+ */
+- (nullable NSString *)internedStringWithUTF8Bytes:(const char *)bytes length:(NSUInteger)length;
+/**
+ interned URL of string
+
+ @param URLString string of URL
+ @return interned URL (nil if string is not valid URL)
+ */
+- (nullable NSURL *)internedURLWithString:(NSString *)URLString;
+/**
+ interned model (compared by all properties)
+ properties of model should not be changed after interned (setters assert unless NS_BLOCK_ASSERTIONS)
+
+ @param model model of immutable class
+ @return interned model equal to model
+ */
+- (__kindof HKModel *)internedModel:(HKModel *)model;
+
+/**
+ number of interned strings, URLs and models
+ */
+@property (nonatomic, readonly) NSUInteger count;
+/**
+ remove all interned values (ex. end of session)
+ */
+- (void)removeAllObjects;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,299 @@
+//
+//  HKModelDecodeContext.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelDecodeContext.h"
+#import "HKModelPlan.h"
+#import "HKModelChanges.h"
+
+#import <pthread.h>
+
+static __thread void *HKCurrentDecodeContext = NULL;    // unretained, context is alive while performing block
+static const NSUInteger kHKUTF8StringTableMinimumCapacity = 64;
+
+/**
+ interned string by UTF-8 bytes (bytes are copied, string is retained by string set)
+ */
+typedef struct _HKUTF8StringEntry {
+    NSUInteger hash;
+    NSUInteger length;
+    char *bytes;                            // NULL if entry is empty
+    __unsafe_unretained NSString *string;
+} HKUTF8StringEntry;
+
+static inline NSUInteger HKHashUTF8Bytes(const char *bytes, NSUInteger length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (NSUInteger index = 0; index < length; index++) {
+        hash ^= (uint8_t)bytes[index];
+        hash *= 1099511628211ull;
+    }
+    return (NSUInteger)hash;
+}
+
+#pragma mark - structural equality of model
+static CFHashCode HKModelStructuralHash(const void *value) {
+    __unsafe_unretained HKModel *model = (__bridge HKModel *)value;
+    HKModelPlan *plan = [HKModelPlan planWithClass:model.class];
+    CFHashCode result = (CFHashCode)plan.modelClass;
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        CFHashCode hash = 0;
+        switch (slot->type) {
+            case HKModelSlotTypeUnsupported:
+                continue;
+            case HKModelSlotTypeFloat:
+            case HKModelSlotTypeDouble: {
+                // bits of double (0.0 == -0.0)
+                double real = HKModelSlotGetDouble(model, slot);
+                uint64_t bits = 0;
+                if (real != 0) {
+                    memcpy(&bits, &real, sizeof(bits));
+                }
+                hash = (CFHashCode)(bits ^ (bits >> 32));
+                break;
+            }
+            default:
+                hash = HKModelSlotTypeIsNumber(slot->type) ? (CFHashCode)HKModelSlotGetUnsignedLongLong(model, slot) : [HKModelSlotGetObject(model, slot) hash];
+                break;
+        }
+        result = result * 31 + hash;
+    }
+    return result;
+}
+
+static Boolean HKModelStructuralEqual(const void *lhs, const void *rhs) {
+    __unsafe_unretained HKModel *model = (__bridge HKModel *)lhs;
+    __unsafe_unretained HKModel *other = (__bridge HKModel *)rhs;
+    if (model == other) {
+        return true;
+    } else if (model.class != other.class) {
+        return false;
+    }
+    
+    HKModelPlan *plan = [HKModelPlan planWithClass:model.class];
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        switch (slot->type) {
+            case HKModelSlotTypeUnsupported:
+                break;
+            case HKModelSlotTypeFloat:
+            case HKModelSlotTypeDouble:
+                if (HKModelSlotGetDouble(model, slot) != HKModelSlotGetDouble(other, slot)) {
+                    return false;
+                }
+                break;
+            default:
+                if (HKModelSlotTypeIsNumber(slot->type)) {
+                    if (HKModelSlotGetUnsignedLongLong(model, slot) != HKModelSlotGetUnsignedLongLong(other, slot)) {
+                        return false;
+                    }
+                } else {
+                    id value = HKModelSlotGetObject(model, slot);
+                    id otherValue = HKModelSlotGetObject(other, slot);
+                    if (value != otherValue && ![value isEqual:otherValue]) {
+                        return false;
+                    }
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+#pragma mark - decode context
+@interface HKModelDecodeContext () {
+    pthread_mutex_t _lock;
+    CFMutableSetRef _strings;
+    CFMutableDictionaryRef _URLs;   // string -> URL
+    CFMutableSetRef _models;
+    
+    HKUTF8StringEntry *_UTF8Strings;    // open addressing table (linear probing) of strings by UTF-8 bytes
+    NSUInteger _UTF8StringsMask;
+    NSUInteger _numberOfUTF8Strings;
+}
+
+- (void)HK_removeAllUTF8Strings;
+- (void)HK_addUTF8StringEntry:(HKUTF8StringEntry)entry;
+
+@end
+
+@implementation HKModelDecodeContext
+
++ (HKModelDecodeContext *)currentContext {
+    return (__bridge HKModelDecodeContext *)HKCurrentDecodeContext;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+        _strings = CFSetCreateMutable(kCFAllocatorDefault, 0, &kCFTypeSetCallBacks);
+        _URLs = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks);
+        
+        CFSetCallBacks callBacks = kCFTypeSetCallBacks;
+        callBacks.hash = HKModelStructuralHash;
+        callBacks.equal = HKModelStructuralEqual;
+        _models = CFSetCreateMutable(kCFAllocatorDefault, 0, &callBacks);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self HK_removeAllUTF8Strings];
+    CFRelease(_strings);
+    CFRelease(_URLs);
+    CFRelease(_models);
+    pthread_mutex_destroy(&_lock);
+}
+
+- (void)performBlock:(void (NS_NOESCAPE ^)(void))block {
+    void *previous = HKCurrentDecodeContext;
+    HKCurrentDecodeContext = (__bridge void *)self;
+    @try {
+        block();
+    } @finally {
+        HKCurrentDecodeContext = previous;
+    }
+}
+
+- (NSString *)internedString:(NSString *)string {
+    pthread_mutex_lock(&_lock);
+    NSString *result = (__bridge NSString *)CFSetGetValue(_strings, (__bridge const void *)string);
+    if (!result) {
+        result = [string copy];
+        CFSetAddValue(_strings, (__bridge const void *)result);
+    }
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+- (NSString *)internedStringWithUTF8Bytes:(const char *)bytes length:(NSUInteger)length {
+    // lookup by bytes, string is allocated only if not interned
+    NSUInteger hash = HKHashUTF8Bytes(bytes, length);
+    pthread_mutex_lock(&_lock);
+    if (_UTF8Strings) {
+        for (NSUInteger position = hash & _UTF8StringsMask; _UTF8Strings[position].bytes; position = (position + 1) & _UTF8StringsMask) {
+            HKUTF8StringEntry *entry = &_UTF8Strings[position];
+            if (entry->hash == hash && entry->length == length && memcmp(entry->bytes, bytes, length) == 0) {
+                NSString *result = entry->string;
+                pthread_mutex_unlock(&_lock);
+                return result;
+            }
+        }
+    }
+    
+    NSString *result = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    if (result) {
+        // same string as internedString:
+        NSString *interned = (__bridge NSString *)CFSetGetValue(_strings, (__bridge const void *)result);
+        interned ? (result = interned) : CFSetAddValue(_strings, (__bridge const void *)result);
+        
+        HKUTF8StringEntry entry = { hash, length, malloc(MAX(length, 1)), result };
+        memcpy(entry.bytes, bytes, length);
+        [self HK_addUTF8StringEntry:entry];
+    }
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+- (NSURL *)internedURLWithString:(NSString *)URLString {
+    pthread_mutex_lock(&_lock);
+    NSURL *result = (__bridge NSURL *)CFDictionaryGetValue(_URLs, (__bridge const void *)URLString);
+    if (!result) {
+        result = [NSURL URLWithString:URLString];
+        result ? CFDictionarySetValue(_URLs, (__bridge const void *)[URLString copy], (__bridge const void *)result) : nil;
+    }
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+- (HKModel *)internedModel:(HKModel *)model {
+    pthread_mutex_lock(&_lock);
+    HKModel *result = (__bridge HKModel *)CFSetGetValue(_models, (__bridge const void *)model);
+    if (!result) {
+        result = model;
+        CFSetAddValue(_models, (__bridge const void *)result);
+        HKModelFreeze(result);
+    }
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+- (NSUInteger)count {
+    pthread_mutex_lock(&_lock);
+    NSUInteger result = (NSUInteger)(CFSetGetCount(_strings) + CFDictionaryGetCount(_URLs) + CFSetGetCount(_models));
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+- (void)removeAllObjects {
+    pthread_mutex_lock(&_lock);
+    CFSetRemoveAllValues(_strings);
+    CFDictionaryRemoveAllValues(_URLs);
+    CFSetRemoveAllValues(_models);
+    [self HK_removeAllUTF8Strings];
+    pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark - private methods
+
+// table is grown at 3/4 load (locked by caller)
+- (void)HK_addUTF8StringEntry:(HKUTF8StringEntry)entry {
+    NSUInteger capacity = _UTF8Strings ? _UTF8StringsMask + 1 : 0;
+    if ((_numberOfUTF8Strings + 1) * 4 > capacity * 3) {
+        NSUInteger newCapacity = MAX(capacity * 2, kHKUTF8StringTableMinimumCapacity);
+        HKUTF8StringEntry *entries = calloc(newCapacity, sizeof(HKUTF8StringEntry));
+        for (NSUInteger index = 0; index < capacity; index++) {
+            if (_UTF8Strings[index].bytes) {
+                NSUInteger position = _UTF8Strings[index].hash & (newCapacity - 1);
+                while (entries[position].bytes) {
+                    position = (position + 1) & (newCapacity - 1);
+                }
+                entries[position] = _UTF8Strings[index];
+            }
+        }
+        free(_UTF8Strings);
+        _UTF8Strings = entries;
+        _UTF8StringsMask = newCapacity - 1;
+    }
+    
+    NSUInteger position = entry.hash & _UTF8StringsMask;
+    while (_UTF8Strings[position].bytes) {
+        position = (position + 1) & _UTF8StringsMask;
+    }
+    _UTF8Strings[position] = entry;
+    _numberOfUTF8Strings++;
+}
+
+- (void)HK_removeAllUTF8Strings {
+    for (NSUInteger index = 0; _UTF8Strings && index <= _UTF8StringsMask; index++) {
+        free(_UTF8Strings[index].bytes);
+    }
+    free(_UTF8Strings);
+    _UTF8Strings = NULL;
+    _UTF8StringsMask = 0;
+    _numberOfUTF8Strings = 0;
+}
+
+@end
@@ -0,0 +1,83 @@
+//
+//  HKModelDecodeSession.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ scope of batch decoding
+ block is performed in autorelease pool, and transient buffers of decoding (ex. string and struct staging buffers)
+ are returned to arena of session and reused by next decoding instead of malloc and free
+ 
+ HKModelDecodeSession *session = [[HKModelDecodeSession alloc] init];
+ for (NSData *data in chunks) {
+    [session performBlock:^{
+        [self processCards:[HKArray modelWithJSONData:data error:NULL]];
+    }];
+ }
+ */
+@interface HKModelDecodeSession : NSObject
+
+/**
+ session of current thread (performing block)
+ concurrent decoding on other threads (ex. HKArray.concurrentThreshold) does not use session
+ */
+@property (class, nonatomic, readonly, nullable) HKModelDecodeSession *currentSession;
+
+/**
+ perform block in autorelease pool with session as current session of thread
+
+ @param block block for decode
+ */
+- (void)performBlock:(void (NS_NOESCAPE ^)(void))block;
+
+/**
+ number of buffers kept in arena
+ */
+@property (nonatomic, readonly) NSUInteger numberOfBuffers;
+/**
+ free all buffers kept in arena
+ */
+- (void)removeAllBuffers;
+
+@end
+
+/**
+ allocate transient buffer (from arena of current session, malloc if there is no session)
+ buffer can be grown by realloc
+
+ @param length minimum length
+ @param capacity length of buffer (not less than length)
+ @return buffer (NULL if length is 0 and there is no buffer in arena)
+ */
+OBJC_EXTERN void * _Nullable HKModelArenaAllocate(size_t length, size_t *capacity);
+/**
+ release transient buffer (to arena of current session, free if there is no session or arena is full)
+
+ @param buffer buffer from HKModelArenaAllocate
+ @param capacity length of buffer
+ */
+OBJC_EXTERN void HKModelArenaFree(void * _Nullable buffer, size_t capacity);
+
+NS_ASSUME_NONNULL_END
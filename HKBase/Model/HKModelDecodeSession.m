@@ -0,0 +1,159 @@
+//
+//  HKModelDecodeSession.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelDecodeSession.h"
+#import <pthread.h>
+
+static const NSUInteger kHKModelArenaNumberOfBuffers = 8;               // buffers kept in arena
+static const size_t kHKModelArenaMaximumCapacity = 4 * 1024 * 1024;     // larger buffers are freed
+
+static __thread void *HKCurrentDecodeSession = NULL;  // unretained, valid while performing block
+
+typedef struct _HKModelArenaBuffer {
+    void *bytes;
+    size_t capacity;
+} HKModelArenaBuffer;
+
+@interface HKModelDecodeSession () {
+    pthread_mutex_t _lock;
+    HKModelArenaBuffer _buffers[kHKModelArenaNumberOfBuffers];
+    NSUInteger _numberOfBuffers;
+}
+
+- (void *)HK_allocateLength:(size_t)length capacity:(size_t *)capacity;
+- (BOOL)HK_keepBuffer:(void *)buffer capacity:(size_t)capacity;
+
+@end
+
+@implementation HKModelDecodeSession
+
++ (HKModelDecodeSession *)currentSession {
+    return (__bridge HKModelDecodeSession *)HKCurrentDecodeSession;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self removeAllBuffers];
+    pthread_mutex_destroy(&_lock);
+}
+
+- (void)performBlock:(void (NS_NOESCAPE ^)(void))block {
+    void *previous = HKCurrentDecodeSession;
+    HKCurrentDecodeSession = (__bridge void *)self;
+    @try {
+        @autoreleasepool {
+            block();
+        }
+    } @finally {
+        HKCurrentDecodeSession = previous;
+    }
+}
+
+- (NSUInteger)numberOfBuffers {
+    pthread_mutex_lock(&_lock);
+    NSUInteger result = _numberOfBuffers;
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+- (void)removeAllBuffers {
+    pthread_mutex_lock(&_lock);
+    for (NSUInteger index = 0; index < _numberOfBuffers; index++) {
+        free(_buffers[index].bytes);
+    }
+    _numberOfBuffers = 0;
+    pthread_mutex_unlock(&_lock);
+}
+
+// smallest buffer not less than length, or largest buffer grown by realloc
+- (void *)HK_allocateLength:(size_t)length capacity:(size_t *)capacity {
+    pthread_mutex_lock(&_lock);
+    NSInteger found = -1;
+    NSInteger largest = -1;
+    for (NSUInteger index = 0; index < _numberOfBuffers; index++) {
+        size_t bufferCapacity = _buffers[index].capacity;
+        if (bufferCapacity >= length && (found < 0 || bufferCapacity < _buffers[found].capacity)) {
+            found = (NSInteger)index;
+        }
+        if (largest < 0 || bufferCapacity > _buffers[largest].capacity) {
+            largest = (NSInteger)index;
+        }
+    }
+    // any buffer is enough for length 0, largest one avoids growing later
+    NSInteger index = length == 0 ? largest : (found >= 0 ? found : largest);
+    HKModelArenaBuffer buffer = { NULL, 0 };
+    if (index >= 0) {
+        buffer = _buffers[index];
+        _buffers[index] = _buffers[--_numberOfBuffers];
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    if (buffer.capacity < length) {
+        buffer.bytes = realloc(buffer.bytes, length);
+        buffer.capacity = length;
+    }
+    *capacity = buffer.capacity;
+    return buffer.bytes;
+}
+
+- (BOOL)HK_keepBuffer:(void *)buffer capacity:(size_t)capacity {
+    if (capacity > kHKModelArenaMaximumCapacity) {
+        return NO;
+    }
+    pthread_mutex_lock(&_lock);
+    BOOL result = _numberOfBuffers < kHKModelArenaNumberOfBuffers;
+    if (result) {
+        _buffers[_numberOfBuffers++] = (HKModelArenaBuffer){ buffer, capacity };
+    }
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+@end
+
+#pragma mark - arena
+void *HKModelArenaAllocate(size_t length, size_t *capacity) {
+    HKModelDecodeSession *session = (__bridge HKModelDecodeSession *)HKCurrentDecodeSession;
+    if (session) {
+        return [session HK_allocateLength:length capacity:capacity];
+    }
+    *capacity = length;
+    return length > 0 ? malloc(length) : NULL;
+}
+
+void HKModelArenaFree(void *buffer, size_t capacity) {
+    if (!buffer) {
+        return;
+    }
+    HKModelDecodeSession *session = (__bridge HKModelDecodeSession *)HKCurrentDecodeSession;
+    if (![session HK_keepBuffer:buffer capacity:capacity]) {
+        free(buffer);
+    }
+}
@@ -0,0 +1,90 @@
+//
+//  HKModelLazyStorage.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModelPlan.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class HKModel;
+
+/**
+ source of lazy materialization (HKModel.isLazyMaterialization)
+ keeps serialized object and converts each object property on first access
+ */
+@interface HKModelLazyStorage : NSObject
+
+/**
+ prepare class for lazy materialization (wrap getters and setters of object properties once)
+
+ @param plan plan of model class
+ */
++ (void)prepareWithPlan:(HKModelPlan *)plan;
+
+- (instancetype)init NS_UNAVAILABLE;
+/**
+ storage for serialized object
+ number and struct properties should be set by caller, object properties are pending
+
+ @param serializedObject serialized object (dictionary)
+ @param plan plan of model class
+ @return storage (nil if there is no pending property)
+ */
+- (nullable instancetype)initWithSerializedObject:(NSDictionary *)serializedObject plan:(HKModelPlan *)plan NS_DESIGNATED_INITIALIZER;
+
+/**
+ all properties are converted
+ */
+@property (nonatomic, readonly, getter=isMaterialized) BOOL materialized;
+
+/**
+ convert property if pending
+
+ @param slot slot of property
+ @param model model object
+ */
+- (void)materializeSlot:(const HKModelSlot *)slot ofModel:(id)model;
+/**
+ discard pending property (property is set by setter)
+
+ @param slot slot of property
+ */
+- (void)discardSlot:(const HKModelSlot *)slot;
+/**
+ convert all pending properties
+
+ @param model model object
+ */
+- (void)materializeModel:(id)model;
+
+@end
+
+/**
+ lazy storage of model (defined in HKModel.m)
+
+ @param model model object
+ @return lazy storage (nil if model is not decoded lazily)
+ */
+OBJC_EXTERN HKModelLazyStorage * _Nullable HKModelGetLazyStorage(HKModel *model);
+
+NS_ASSUME_NONNULL_END
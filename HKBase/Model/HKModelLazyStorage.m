@@ -0,0 +1,195 @@
+//
+//  HKModelLazyStorage.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelLazyStorage.h"
+#import "HKModel.h"
+#import "HKMethod.h"
+
+#import <objc/runtime.h>
+#import <pthread.h>
+#import <stdatomic.h>
+
+static pthread_mutex_t HKModelLazyClassesLock = PTHREAD_MUTEX_INITIALIZER;
+static CFMutableSetRef HKModelLazyClasses = NULL;
+
+@interface HKModelLazyStorage () {
+    HKModelPlan *_plan;
+    NSDictionary *_serializedObject;
+    BOOL *_pendings;
+    atomic_ulong _numberOfPendings;
+    pthread_mutex_t _mutex;
+}
+
+- (void)HK_didMaterializeSlot;
+- (const HKModelSlot *)HK_slotOfPlan:(const HKModelSlot *)slot;
+
+@end
+
+@implementation HKModelLazyStorage
+
++ (void)prepareWithPlan:(HKModelPlan *)plan {
+    Class modelClass = plan.modelClass;
+    
+    pthread_mutex_lock(&HKModelLazyClassesLock);
+    if (!HKModelLazyClasses) {
+        HKModelLazyClasses = CFSetCreateMutable(kCFAllocatorDefault, 0, NULL);
+    }
+    if (CFSetContainsValue(HKModelLazyClasses, (__bridge const void *)modelClass)) {
+        pthread_mutex_unlock(&HKModelLazyClassesLock);
+        return;
+    }
+    
+    // IMPs in plan are resolved before wrapping, decoding with plan does not pass through wrapper
+    // wrapper calls current IMP of class (ex. setter wrapped by change tracking)
+    const HKModelSlot *slots = plan.slots;
+    for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+        const HKModelSlot *slot = &slots[index];
+        if ((slot->type != HKModelSlotTypeObject && slot->type != HKModelSlotTypeModel) || !slot->getterImplementation || !slot->setterImplementation) {
+            continue;
+        }
+        
+        IMP getterImplementation = class_getMethodImplementation(modelClass, slot->getter);
+        SEL getter = slot->getter;
+        HKMethod *getterMethod = [HKMethod methodWithSelector:getter block:^id(HKModel *model) {
+            [HKModelGetLazyStorage(model) materializeSlot:slot ofModel:model];
+            return ((id (*)(id, SEL))getterImplementation)(model, getter);
+        }];
+        [modelClass replaceInstanceMethod:getterMethod];
+        HKModelPlanRegisterWrapperImplementation(getterMethod.implementation, getterImplementation);
+        
+        IMP setterImplementation = class_getMethodImplementation(modelClass, slot->setter);
+        SEL setter = slot->setter;
+        HKMethod *setterMethod = [HKMethod methodWithSelector:setter block:^(HKModel *model, id object) {
+            [HKModelGetLazyStorage(model) discardSlot:slot];
+            ((void (*)(id, SEL, id))setterImplementation)(model, setter, object);
+        }];
+        [modelClass replaceInstanceMethod:setterMethod];
+        HKModelPlanRegisterWrapperImplementation(setterMethod.implementation, setterImplementation);
+    }
+    
+    CFSetAddValue(HKModelLazyClasses, (__bridge const void *)modelClass);
+    pthread_mutex_unlock(&HKModelLazyClassesLock);
+}
+
+- (instancetype)initWithSerializedObject:(NSDictionary *)serializedObject plan:(HKModelPlan *)plan {
+    self = [super init];
+    if (self) {
+        _plan = plan;
+        _pendings = calloc(MAX(plan.numberOfSlots, 1), sizeof(BOOL));
+        
+        NSUInteger numberOfPendings = 0;
+        const HKModelSlot *slots = plan.slots;
+        for (NSUInteger index = 0; index < plan.numberOfSlots; index++) {
+            const HKModelSlot *slot = &slots[index];
+            if ((slot->type == HKModelSlotTypeObject || slot->type == HKModelSlotTypeModel) && serializedObject[slot->key]) {
+                _pendings[index] = YES;
+                numberOfPendings++;
+            }
+        }
+        if (!numberOfPendings) {
+            free(_pendings);
+            _pendings = NULL;
+            return nil;
+        }
+        
+        _serializedObject = serializedObject;
+        atomic_init(&_numberOfPendings, numberOfPendings);
+        
+        pthread_mutexattr_t attribute;
+        pthread_mutexattr_init(&attribute);
+        pthread_mutexattr_settype(&attribute, PTHREAD_MUTEX_RECURSIVE); // setter in conversion calls discardSlot:
+        pthread_mutex_init(&_mutex, &attribute);
+        pthread_mutexattr_destroy(&attribute);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_pendings) {
+        free(_pendings);
+        pthread_mutex_destroy(&_mutex);
+    }
+}
+
+- (BOOL)isMaterialized {
+    return atomic_load_explicit(&_numberOfPendings, memory_order_acquire) == 0;
+}
+
+- (void)materializeSlot:(const HKModelSlot *)slot ofModel:(id)model {
+    if (self.isMaterialized || !(slot = [self HK_slotOfPlan:slot])) {
+        return;
+    }
+    
+    pthread_mutex_lock(&_mutex);
+    if (_pendings[slot->index]) {
+        _pendings[slot->index] = NO;
+        HKModelSlotSetSerializedObject(model, slot, _serializedObject[slot->key]);
+        [self HK_didMaterializeSlot];
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)discardSlot:(const HKModelSlot *)slot {
+    if (self.isMaterialized || !(slot = [self HK_slotOfPlan:slot])) {
+        return;
+    }
+    
+    pthread_mutex_lock(&_mutex);
+    if (_pendings[slot->index]) {
+        _pendings[slot->index] = NO;
+        [self HK_didMaterializeSlot];
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+- (void)materializeModel:(id)model {
+    if (self.isMaterialized) {
+        return;
+    }
+    
+    pthread_mutex_lock(&_mutex);
+    const HKModelSlot *slots = _plan.slots;
+    for (NSUInteger index = 0; index < _plan.numberOfSlots; index++) {
+        if (_pendings[index]) {
+            _pendings[index] = NO;
+            HKModelSlotSetSerializedObject(model, &slots[index], _serializedObject[slots[index].key]);
+            [self HK_didMaterializeSlot];
+        }
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+#pragma mark - private methods
+// wrapper of superclass passes slot of superclass plan (index is different)
+- (const HKModelSlot *)HK_slotOfPlan:(const HKModelSlot *)slot {
+    return slot->modelClass == _plan.modelClass ? slot : [_plan slotForUTF8Key:slot->UTF8Key length:slot->UTF8KeyLength];
+}
+
+// release serialized object after last conversion (called in lock)
+- (void)HK_didMaterializeSlot {
+    if (atomic_fetch_sub_explicit(&_numberOfPendings, 1, memory_order_acq_rel) == 1) {
+        _serializedObject = nil;
+    }
+}
+
+@end
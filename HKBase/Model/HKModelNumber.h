@@ -0,0 +1,72 @@
+//
+//  HKModelNumber.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ parsed number (ex. number in string of JSON)
+ integer is exact if isInteger, real is nearest double of text
+ */
+typedef struct _HKModelNumber {
+    BOOL isInteger;                 // no fraction or exponent, and absolute value is not overflowed
+    BOOL isNegative;
+    unsigned long long integer;     // absolute value (isInteger only)
+    double real;
+} HKModelNumber;
+
+/**
+ parse number at front of bytes without allocation (as strtod, trailing characters are ignored)
+ leading whitespace, sign, fraction, exponent and hexadecimal integer (0x) are allowed
+ digits are converted 8 at once, and real is exact without strtod for 19 or less significant digits with small exponent
+
+ @param bytes bytes of text (not null terminated)
+ @param length length of bytes
+ @param number parsed number (zero if there is no number)
+ @return parsed length (0 if there is no number)
+ */
+OBJC_EXTERN NSUInteger HKModelNumberParse(const char *bytes, NSUInteger length, HKModelNumber *number);
+/**
+ parse number at front of string without allocation
+
+ @param string string (ex. "12345678901234567890")
+ @param number parsed number (zero if there is no number)
+ @return string has number
+ */
+OBJC_EXTERN BOOL HKModelNumberParseString(NSString *string, HKModelNumber *number);
+
+/**
+ long long value of number (clamped if overflowed)
+ */
+OBJC_EXTERN long long HKModelNumberLongLongValue(const HKModelNumber *number);
+/**
+ unsigned long long value of number (clamped if overflowed, negative integer is wrapped as strtoull)
+ */
+OBJC_EXTERN unsigned long long HKModelNumberUnsignedLongLongValue(const HKModelNumber *number);
+/**
+ number object (long long, unsigned long long for large integer, double otherwise)
+ */
+OBJC_EXTERN NSNumber *HKModelNumberObject(const HKModelNumber *number);
+
+NS_ASSUME_NONNULL_END
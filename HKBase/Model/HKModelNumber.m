@@ -0,0 +1,286 @@
+//
+//  HKModelNumber.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelNumber.h"
+#import "HKModelPlan.h"
+#import "HKModelDecodeSession.h"
+#import <xlocale.h>
+
+static const int kHKModelNumberMaximumDigits = 19;              // significant digits of unsigned long long mantissa
+static const unsigned long long kHKModelNumberExactMantissa = 1ULL << 53;
+
+// powers of 10 exactly representable in double
+static const double HKModelNumberPowersOf10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+typedef struct _HKModelNumberMantissa {
+    unsigned long long value;
+    int numberOfDigits;     // significant digits in value
+    int exponent;           // decimal exponent of value
+    BOOL isTruncated;       // non zero digits are dropped
+} HKModelNumberMantissa;
+
+static inline BOOL HKIsDigit(char character) {
+    return character >= '0' && character <= '9';
+}
+
+static inline BOOL HKIsHexDigit(char character) {
+    return HKIsDigit(character) || ((character | 0x20) >= 'a' && (character | 0x20) <= 'f');
+}
+
+// 8 ASCII digits in little endian word (SWAR)
+static inline BOOL HKIsEightDigits(uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+static inline uint32_t HKEightDigitsValue(uint64_t word) {
+    word -= 0x3030303030303030ULL;
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FFULL) * 0x000F424000000064ULL) + (((word >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32;
+    return (uint32_t)word;
+}
+
+/**
+ read digits into mantissa (8 digits at once while mantissa is small)
+ */
+static const char *HKModelNumberReadDigits(const char *cursor, const char *end, HKModelNumberMantissa *mantissa, BOOL isFraction) {
+    // leading zeros are not significant
+    if (mantissa->value == 0) {
+        while (cursor < end && *cursor == '0') {
+            cursor++;
+            mantissa->exponent -= isFraction ? 1 : 0;
+        }
+    }
+#if __LITTLE_ENDIAN__
+    while (end - cursor >= 8 && mantissa->numberOfDigits + 8 <= kHKModelNumberMaximumDigits) {
+        uint64_t word;
+        memcpy(&word, cursor, sizeof(word));
+        if (!HKIsEightDigits(word)) {
+            break;
+        }
+        mantissa->value = mantissa->value * 100000000ULL + HKEightDigitsValue(word);
+        mantissa->numberOfDigits += mantissa->value ? 8 : 0;
+        mantissa->exponent -= isFraction ? 8 : 0;
+        cursor += 8;
+    }
+#endif
+    while (cursor < end && HKIsDigit(*cursor)) {
+        unsigned int digit = (unsigned int)(*cursor++ - '0');
+        if (mantissa->numberOfDigits < kHKModelNumberMaximumDigits) {
+            mantissa->value = mantissa->value * 10 + digit;
+            mantissa->numberOfDigits += mantissa->value ? 1 : 0;
+            mantissa->exponent -= isFraction ? 1 : 0;
+        } else {
+            mantissa->isTruncated = mantissa->isTruncated || digit != 0;
+            mantissa->exponent += isFraction ? 0 : 1;
+        }
+    }
+    return cursor;
+}
+
+// exact integer of digits, NO if overflowed (more than 19 digits)
+static BOOL HKModelNumberReadInteger(const char *cursor, const char *end, unsigned long long *integer) {
+    unsigned long long value = 0;
+    for (; cursor < end; cursor++) {
+        unsigned int digit = (unsigned int)(*cursor - '0');
+        if (value > (ULLONG_MAX - digit) / 10) {
+            return NO;
+        }
+        value = value * 10 + digit;
+    }
+    *integer = value;
+    return YES;
+}
+
+static double HKModelNumberStrtod(const char *bytes, size_t length) {
+    char buffer[64];
+    size_t capacity = sizeof(buffer);
+    char *text = length < sizeof(buffer) ? buffer : HKModelArenaAllocate(length + 1, &capacity);
+    memcpy(text, bytes, length);
+    text[length] = '\0';
+    double result = strtod_l(text, NULL, NULL);
+    if (text != buffer) {
+        HKModelArenaFree(text, capacity);
+    }
+    return result;
+}
+
+NSUInteger HKModelNumberParse(const char *bytes, NSUInteger length, HKModelNumber *number) {
+    memset(number, 0, sizeof(HKModelNumber));
+    const char *cursor = bytes;
+    const char *end = bytes + length;
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r')) {
+        cursor++;
+    }
+    const char *start = cursor;
+    if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+        number->isNegative = *cursor == '-';
+        cursor++;
+    }
+    
+    // hexadecimal integer (ex. 0x1F)
+    if (end - cursor > 2 && cursor[0] == '0' && (cursor[1] == 'x' || cursor[1] == 'X') && HKIsHexDigit(cursor[2])) {
+        cursor += 2;
+        unsigned long long value = 0;
+        BOOL isOverflow = NO;
+        for (; cursor < end && HKIsHexDigit(*cursor); cursor++) {
+            unsigned int digit = (unsigned int)(HKIsDigit(*cursor) ? *cursor - '0' : (*cursor | 0x20) - 'a' + 10);
+            isOverflow = isOverflow || value > (ULLONG_MAX >> 4);
+            value = (value << 4) | digit;
+        }
+        number->isInteger = !isOverflow;
+        number->integer = isOverflow ? 0 : value;
+        number->real = isOverflow ? HUGE_VAL : (double)value;
+        number->real = number->isNegative ? -number->real : number->real;
+        return (NSUInteger)(cursor - bytes);
+    }
+    
+    HKModelNumberMantissa mantissa = { 0, 0, 0, NO };
+    const char *integerStart = cursor;
+    cursor = HKModelNumberReadDigits(cursor, end, &mantissa, NO);
+    const char *integerEnd = cursor;
+    BOOL hasDigits = integerEnd > integerStart;
+    
+    BOOL isInteger = YES;
+    if (cursor < end && *cursor == '.' && (hasDigits || (cursor + 1 < end && HKIsDigit(cursor[1])))) {
+        isInteger = NO;
+        const char *fractionStart = ++cursor;
+        cursor = HKModelNumberReadDigits(cursor, end, &mantissa, YES);
+        hasDigits = hasDigits || cursor > fractionStart;
+    }
+    if (!hasDigits) {
+        return 0;
+    }
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        const char *exponentCursor = cursor + 1;
+        BOOL isNegativeExponent = NO;
+        if (exponentCursor < end && (*exponentCursor == '-' || *exponentCursor == '+')) {
+            isNegativeExponent = *exponentCursor == '-';
+            exponentCursor++;
+        }
+        if (exponentCursor < end && HKIsDigit(*exponentCursor)) {
+            isInteger = NO;
+            int exponent = 0;
+            for (; exponentCursor < end && HKIsDigit(*exponentCursor); exponentCursor++) {
+                exponent = exponent < 100000 ? exponent * 10 + (*exponentCursor - '0') : exponent;
+            }
+            mantissa.exponent += isNegativeExponent ? -exponent : exponent;
+            cursor = exponentCursor;
+        }
+    }
+    
+    if (isInteger) {
+        // more than 19 digits may still fit (ex. 18446744073709551615)
+        number->isInteger = mantissa.exponent == 0 ? YES : HKModelNumberReadInteger(integerStart, integerEnd, &number->integer);
+        number->integer = mantissa.exponent == 0 ? mantissa.value : number->integer;
+    }
+    if (number->isInteger) {
+        number->real = (double)number->integer;
+    } else if (!mantissa.isTruncated && mantissa.value <= kHKModelNumberExactMantissa && mantissa.exponent >= -22 && mantissa.exponent <= 22) {
+        // exact by one rounding (mantissa and power of 10 are exact)
+        double value = (double)mantissa.value;
+        number->real = mantissa.exponent < 0 ? value / HKModelNumberPowersOf10[-mantissa.exponent] : value * HKModelNumberPowersOf10[mantissa.exponent];
+    } else if (mantissa.value == 0) {
+        number->real = 0.0;
+    } else {
+        number->real = fabs(HKModelNumberStrtod(start, (size_t)(cursor - start)));
+    }
+    number->real = number->isNegative ? -number->real : number->real;
+    return (NSUInteger)(cursor - bytes);
+}
+
+BOOL HKModelNumberParseString(NSString *string, HKModelNumber *number) {
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    const char *bytes = CFStringGetCStringPtr(cfString, kCFStringEncodingASCII);
+    if (bytes) {
+        return HKModelNumberParse(bytes, strlen(bytes), number) > 0;
+    }
+    
+    // non ASCII characters are replaced and terminate number
+    CFIndex length = CFStringGetLength(cfString);
+    char buffer[128];
+    size_t capacity = sizeof(buffer);
+    char *text = (size_t)length <= sizeof(buffer) ? buffer : HKModelArenaAllocate((size_t)length, &capacity);
+    CFIndex usedLength = 0;
+    CFStringGetBytes(cfString, CFRangeMake(0, length), kCFStringEncodingASCII, '?', false, (UInt8 *)text, (CFIndex)capacity, &usedLength);
+    BOOL result = HKModelNumberParse(text, (NSUInteger)usedLength, number) > 0;
+    if (text != buffer) {
+        HKModelArenaFree(text, capacity);
+    }
+    return result;
+}
+
+long long HKModelNumberLongLongValue(const HKModelNumber *number) {
+    if (number->isInteger) {
+        if (number->isNegative) {
+            return number->integer > (unsigned long long)LLONG_MAX + 1 ? LLONG_MIN : (number->integer ? -(long long)(number->integer - 1) - 1 : 0);
+        }
+        return number->integer > LLONG_MAX ? LLONG_MAX : (long long)number->integer;
+    }
+    double real = number->real;
+    if (real != real) {
+        return 0;
+    }
+    return real >= 0x1p63 ? LLONG_MAX : (real <= -0x1p63 ? LLONG_MIN : (long long)real);
+}
+
+unsigned long long HKModelNumberUnsignedLongLongValue(const HKModelNumber *number) {
+    if (number->isInteger) {
+        return number->isNegative ? (unsigned long long)HKModelNumberLongLongValue(number) : number->integer;
+    }
+    double real = number->real;
+    if (real < 0) {
+        return (unsigned long long)HKModelNumberLongLongValue(number);
+    }
+    return real >= 0x1p64 ? ULLONG_MAX : (real == real ? (unsigned long long)real : 0);
+}
+
+NSNumber *HKModelNumberObject(const HKModelNumber *number) {
+    if (!number->isInteger) {
+        return @(number->real);
+    } else if (!number->isNegative && number->integer > LLONG_MAX) {
+        return @(number->integer);
+    }
+    return @(HKModelNumberLongLongValue(number));
+}
+
+void HKModelSlotSetParsedNumber(id model, const HKModelSlot *slot, const HKModelNumber *number) {
+    switch (slot->type) {
+        case HKModelSlotTypeFloat:
+        case HKModelSlotTypeDouble:
+            HKModelSlotSetDouble(model, slot, number->real);
+            break;
+        case HKModelSlotTypeUnsignedChar:
+        case HKModelSlotTypeUnsignedShort:
+        case HKModelSlotTypeUnsignedInt:
+        case HKModelSlotTypeUnsignedLong:
+        case HKModelSlotTypeUnsignedLongLong:
+            HKModelSlotSetUnsignedLongLong(model, slot, HKModelNumberUnsignedLongLongValue(number));
+            break;
+        default:
+            HKModelSlotSetLongLong(model, slot, HKModelNumberLongLongValue(number));
+            break;
+    }
+}
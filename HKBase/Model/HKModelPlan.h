@@ -0,0 +1,365 @@
+//
+//  HKModelPlan.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKProperty.h"
+#import "HKModelNumber.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ value type of property in model plan
+
+ - HKModelSlotTypeUnsupported: can not (de)serialize (pointer, union, bit field, ...)
+ - HKModelSlotTypeObject: object without HKModel conversion (id, NSObject *, ...)
+ - HKModelSlotTypeModel: object converted by +[HKModel modelWithSerializedObject:]
+ - HKModelSlotTypeBool ~ HKModelSlotTypeDouble: number type matching @encode(type)
+ - HKModelSlotTypeStruct: struct (set by NSValue)
+ */
+typedef NS_ENUM(NSInteger, HKModelSlotType) {
+    HKModelSlotTypeUnsupported = 0,
+    HKModelSlotTypeObject,
+    HKModelSlotTypeModel,
+    HKModelSlotTypeBool,
+    HKModelSlotTypeChar,
+    HKModelSlotTypeUnsignedChar,
+    HKModelSlotTypeShort,
+    HKModelSlotTypeUnsignedShort,
+    HKModelSlotTypeInt,
+    HKModelSlotTypeUnsignedInt,
+    HKModelSlotTypeLong,
+    HKModelSlotTypeUnsignedLong,
+    HKModelSlotTypeLongLong,
+    HKModelSlotTypeUnsignedLongLong,
+    HKModelSlotTypeFloat,
+    HKModelSlotTypeDouble,
+    HKModelSlotTypeStruct,
+};
+
+/**
+ kind of property class (HKModelSlotTypeModel only)
+
+ - HKModelSlotClassKindNone: not converted object
+ - HKModelSlotClassKindModel: subclass of HKModel
+ - HKModelSlotClassKindArray: subclass of HKArray
+ - HKModelSlotClassKindEnum: subclass of HKEnum
+ - HKModelSlotClassKindOption: subclass of HKOption
+ - HKModelSlotClassKindString: NSString
+ - HKModelSlotClassKindNumber: NSNumber
+ - HKModelSlotClassKindURL: NSURL
+ - HKModelSlotClassKindData: NSData
+ - HKModelSlotClassKindDate: NSDate
+ - HKModelSlotClassKindOther: other class conforms HKModel (NSDictionary, NSArray, ...)
+ */
+typedef NS_ENUM(NSInteger, HKModelSlotClassKind) {
+    HKModelSlotClassKindNone = 0,
+    HKModelSlotClassKindModel,
+    HKModelSlotClassKindArray,
+    HKModelSlotClassKindEnum,
+    HKModelSlotClassKindOption,
+    HKModelSlotClassKindString,
+    HKModelSlotClassKindNumber,
+    HKModelSlotClassKindURL,
+    HKModelSlotClassKindData,
+    HKModelSlotClassKindDate,
+    HKModelSlotClassKindOther,
+};
+
+/**
+ is slot type number (can deserialize using NSNumber)
+
+ @param type slot type
+ @return result
+ */
+NS_INLINE BOOL HKModelSlotTypeIsNumber(HKModelSlotType type) {
+    return type >= HKModelSlotTypeBool && type <= HKModelSlotTypeDouble;
+}
+
+/**
+ pre-resolved property of model
+ all values are owned by HKModelPlan
+ */
+typedef struct _HKModelSlot {
+    __unsafe_unretained NSString *key;
+    const char *UTF8Key;
+    NSUInteger UTF8KeyLength;
+    
+    __unsafe_unretained HKProperty *property;
+    __unsafe_unretained Class modelClass;
+    __unsafe_unretained Class _Nullable propertyClass;
+    
+    HKModelSlotType type;
+    HKModelSlotClassKind classKind;
+    BOOL isBase64;              // NSData property serialized as Base64 string (HKModel.isBase64Data, HKModel.base64DataKeys)
+    BOOL isTimeIntervalDate;    // NSTimeInterval property decoded from ISO 8601 string (HKModel.timeIntervalDateKeys)
+    HKPropertyAttribute attribute;
+    const char *objCType;
+    NSUInteger size;
+    
+    SEL getter;
+    SEL _Nullable setter;
+    IMP _Nullable getterImplementation;
+    IMP _Nullable setterImplementation;
+    ptrdiff_t offset; // offset of instance variable, -1 if property has no instance variable
+    
+    NSUInteger index;
+} HKModelSlot;
+
+/**
+ Decode plan of model class
+ built once per class (immutable, thread safe)
+ Do not use it directly
+ */
+@interface HKModelPlan : NSObject
+
+/**
+ class of plan
+ */
+@property (nonatomic, unsafe_unretained, readonly) Class modelClass;
+/**
+ ordered slots (subclass properties first, same order as +[NSObject properties])
+ contains non dynamic, non readonly properties
+ */
+@property (nonatomic, readonly) const HKModelSlot *slots;
+/**
+ number of slots
+ */
+@property (nonatomic, readonly) NSUInteger numberOfSlots;
+/**
+ keys of slots
+ */
+@property (nonatomic, readonly) NSArray<NSString *> *allKeys;
+
+/**
+ model class overrides -setSerializedObject:forKey:
+ */
+@property (nonatomic, readonly, getter=isCustomSetSerializedObject) BOOL customSetSerializedObject;
+/**
+ model class overrides -serializedObjectForKey:
+ */
+@property (nonatomic, readonly, getter=isCustomSerializedObjectForKey) BOOL customSerializedObjectForKey;
+/**
+ model class overrides -allKeys
+ */
+@property (nonatomic, readonly, getter=isCustomAllKeys) BOOL customAllKeys;
+/**
+ model should be decoded by +modelWithSerializedObject: (model class overrides it, or HKModel.isLazyMaterialization)
+ */
+@property (nonatomic, readonly, getter=isSerializedObjectRequired) BOOL serializedObjectRequired;
+/**
+ model can be interned by HKModelDecodeContext (HKModel.isImmutable, without lazy materialization and change tracking)
+ */
+@property (nonatomic, readonly, getter=isInternable) BOOL internable;
+
+/**
+ plan of model class (cached)
+
+ @param modelClass subclass of HKModel
+ @return plan
+ */
++ (instancetype)planWithClass:(__unsafe_unretained Class)modelClass;
+
+/**
+ slot of key
+
+ @param key property name
+ @return slot (NULL if key is not in plan)
+ */
+- (nullable const HKModelSlot *)slotForKey:(NSString *)key;
+/**
+ slot of UTF-8 key (ex. key in JSON bytes)
+
+ @param key UTF-8 bytes of property name (not null terminated)
+ @param length length of key
+ @return slot (NULL if key is not in plan)
+ */
+- (nullable const HKModelSlot *)slotForUTF8Key:(const char *)key length:(NSUInteger)length;
+
+/**
+ copy values of all slots from model to other model of plan's class
+ scalar and struct instance variables are copied by memcpy (adjacent ones at once)
+ object instance variables are retained or copied by attribute of property
+ properties without instance variable are copied by -objectForProperty:
+
+ @param source source model
+ @param destination destination model
+ */
+- (void)copyValuesFromModel:(id)source toModel:(id)destination;
+/**
+ share values of all slots from model to other model of plan's class (structural sharing)
+ same as copyValuesFromModel:toModel: but object instance variables are retained even if attribute is copy
+
+ @param source source model
+ @param destination destination model
+ */
+- (void)shareValuesFromModel:(id)source toModel:(id)destination;
+/**
+ reset values of all slots of model to zero (ex. reused model)
+ scalar and struct instance variables are cleared by memset, object instance variables are released
+ object properties without instance variable are set to nil
+
+ @param model model of plan's class
+ */
+- (void)resetValuesOfModel:(id)model;
+
+@end
+
+/**
+ register wrapper of accessor installed on model class (ex. lazy materialization, change tracking)
+ plans created after wrapping resolve wrapped IMP, so conversion with plan does not pass through wrapper
+
+ @param wrapper IMP of wrapper
+ @param implementation wrapped IMP
+ */
+OBJC_EXTERN void HKModelPlanRegisterWrapperImplementation(IMP wrapper, IMP implementation);
+
+#pragma mark - slot access
+/**
+ set serialized object (ex. JSON value) to property of model
+ convert value by slot type and call setter IMP (or write instance variable) without KVC
+
+ @param model model object
+ @param slot slot of property
+ @param serializedObject value in serialize object
+ */
+OBJC_EXTERN void HKModelSlotSetSerializedObject(id model, const HKModelSlot *slot, id _Nullable serializedObject);
+/**
+ set object to property of model (no conversion)
+
+ @param model model object
+ @param slot slot of property (object type)
+ @param object object for set
+ */
+OBJC_EXTERN void HKModelSlotSetObject(id model, const HKModelSlot *slot, id _Nullable object);
+/**
+ set integer to number property of model
+
+ @param model model object
+ @param slot slot of property (number type)
+ @param value integer value (cast to property type)
+ */
+OBJC_EXTERN void HKModelSlotSetLongLong(id model, const HKModelSlot *slot, long long value);
+/**
+ set unsigned integer to number property of model
+
+ @param model model object
+ @param slot slot of property (number type)
+ @param value unsigned integer value (cast to property type)
+ */
+OBJC_EXTERN void HKModelSlotSetUnsignedLongLong(id model, const HKModelSlot *slot, unsigned long long value);
+/**
+ set floating point to number property of model
+
+ @param model model object
+ @param slot slot of property (number type)
+ @param value floating point value (cast to property type)
+ */
+OBJC_EXTERN void HKModelSlotSetDouble(id model, const HKModelSlot *slot, double value);
+/**
+ set parsed number to number property of model in type of slot (defined in HKModelNumber.m)
+ integer slots are set without double conversion
+
+ @param model model object
+ @param slot slot of property (number type)
+ @param number parsed number
+ */
+OBJC_EXTERN void HKModelSlotSetParsedNumber(id model, const HKModelSlot *slot, const HKModelNumber *number);
+/**
+ set number in text to number property of model
+ text which is not number is parsed as ISO 8601 date if slot is isTimeIntervalDate
+
+ @param model model object
+ @param slot slot of property (number type)
+ @param bytes bytes of text (not null terminated)
+ @param length length of bytes
+ */
+OBJC_EXTERN void HKModelSlotSetNumberBytes(id model, const HKModelSlot *slot, const char *bytes, NSUInteger length);
+
+/**
+ object of property (number -> NSNumber, struct -> NSValue)
+
+ @param model model object
+ @param slot slot of property
+ @return object of property
+ */
+OBJC_EXTERN id _Nullable HKModelSlotGetObject(id model, const HKModelSlot *slot);
+/**
+ integer of number property of model (without boxing)
+
+ @param model model object
+ @param slot slot of property (number type)
+ @return integer value (cast from property type)
+ */
+OBJC_EXTERN long long HKModelSlotGetLongLong(id model, const HKModelSlot *slot);
+/**
+ unsigned integer of number property of model (without boxing)
+
+ @param model model object
+ @param slot slot of property (number type)
+ @return unsigned integer value (cast from property type)
+ */
+OBJC_EXTERN unsigned long long HKModelSlotGetUnsignedLongLong(id model, const HKModelSlot *slot);
+/**
+ floating point of number property of model (without boxing)
+
+ @param model model object
+ @param slot slot of property (number type)
+ @return floating point value (cast from property type)
+ */
+OBJC_EXTERN double HKModelSlotGetDouble(id model, const HKModelSlot *slot);
+/**
+ serialized object (ex. JSON value) of property
+
+ @param model model object
+ @param slot slot of property
+ @return serialized object
+ */
+OBJC_EXTERN id _Nullable HKModelSlotGetSerializedObject(id model, const HKModelSlot *slot);
+
+#pragma mark - concurrent
+/**
+ number of chunks for concurrent perform (by active processor count)
+
+ @param count count of elements
+ @return number of chunks
+ */
+OBJC_EXTERN NSUInteger HKModelConcurrentChunkCount(NSUInteger count);
+/**
+ perform block for each chunk of elements concurrently on global queue (dispatch_apply)
+ block is called in autorelease pool
+
+ @param count count of elements
+ @param chunkCount number of chunks (ex. HKModelConcurrentChunkCount)
+ @param block block for chunk (index of chunk and range of elements, range can be empty)
+ */
+OBJC_EXTERN void HKModelPerformConcurrently(NSUInteger count, NSUInteger chunkCount, void (NS_NOESCAPE ^block)(NSUInteger chunk, NSRange range));
+/**
+ transform objects concurrently and add to array in order (nil is dropped)
+
+ @param objects source objects
+ @param result array for add
+ @param transform block for transform object
+ */
+OBJC_EXTERN void HKModelTransformObjectsConcurrently(NSArray *objects, NSMutableArray *result, id _Nullable (NS_NOESCAPE ^transform)(id object));
+
+NS_ASSUME_NONNULL_END
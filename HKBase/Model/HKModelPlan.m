@@ -0,0 +1,881 @@
+//
+//  HKModelPlan.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelPlan.h"
+#import "HKModel.h"
+#import "HKArray.h"
+#import "HKEnum.h"
+#import "HKOption.h"
+#import "HKInstanceVariable.h"
+#import "HKModelDecodeContext.h"
+#import "HKModelNumber.h"
+#import "HKModelDate.h"
+#import "HKModelBase64.h"
+
+#import <objc/runtime.h>
+#import <pthread.h>
+
+static pthread_rwlock_t HKModelPlanLock = PTHREAD_RWLOCK_INITIALIZER;
+static pthread_mutex_t HKModelWrapperLock = PTHREAD_MUTEX_INITIALIZER;
+static CFMutableDictionaryRef HKModelWrapperImplementations = NULL;    // wrapper IMP -> wrapped IMP
+static CFMutableDictionaryRef HKModelPlans = NULL;
+
+static HKModelSlotType HKGetSlotType(const char *objCType) {
+    switch (objCType[0]) {
+        case '@':
+            return HKModelSlotTypeObject;
+        case 'B':
+            return HKModelSlotTypeBool;
+        case 'c':
+            return HKModelSlotTypeChar;
+        case 'C':
+            return HKModelSlotTypeUnsignedChar;
+        case 's':
+            return HKModelSlotTypeShort;
+        case 'S':
+            return HKModelSlotTypeUnsignedShort;
+        case 'i':
+            return HKModelSlotTypeInt;
+        case 'I':
+            return HKModelSlotTypeUnsignedInt;
+        case 'l':
+            return HKModelSlotTypeLong;
+        case 'L':
+            return HKModelSlotTypeUnsignedLong;
+        case 'q':
+            return HKModelSlotTypeLongLong;
+        case 'Q':
+            return HKModelSlotTypeUnsignedLongLong;
+        case 'f':
+            return HKModelSlotTypeFloat;
+        case 'd':
+            return HKModelSlotTypeDouble;
+        case '{':
+            return HKModelSlotTypeStruct;
+        default:
+            return HKModelSlotTypeUnsupported;
+    }
+}
+
+static HKModelSlotClassKind HKGetSlotClassKind(__unsafe_unretained Class propertyClass) {
+    if ([propertyClass isSubclassOfClass:HKModel.class]) {
+        return HKModelSlotClassKindModel;
+    } else if ([propertyClass isSubclassOfClass:HKArray.class]) {
+        return HKModelSlotClassKindArray;
+    } else if ([propertyClass isSubclassOfClass:HKEnum.class]) {
+        return HKModelSlotClassKindEnum;
+    } else if ([propertyClass isSubclassOfClass:HKOption.class]) {
+        return HKModelSlotClassKindOption;
+    } else if ([propertyClass isSubclassOfClass:NSString.class]) {
+        return HKModelSlotClassKindString;
+    } else if ([propertyClass isSubclassOfClass:NSNumber.class]) {
+        return HKModelSlotClassKindNumber;
+    } else if ([propertyClass isSubclassOfClass:NSURL.class]) {
+        return HKModelSlotClassKindURL;
+    } else if ([propertyClass isSubclassOfClass:NSData.class]) {
+        return HKModelSlotClassKindData;
+    } else if ([propertyClass isSubclassOfClass:NSDate.class]) {
+        return HKModelSlotClassKindDate;
+    }
+    return HKModelSlotClassKindOther;
+}
+
+static inline NSUInteger HKHashUTF8Key(const char *key, NSUInteger length) {
+    uint32_t hash = 2166136261u;
+    for (NSUInteger index = 0; index < length; index++) {
+        hash ^= (uint8_t)key[index];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ adjacent scalar instance variables copied at once
+ */
+typedef struct _HKModelCopyRange {
+    ptrdiff_t offset;
+    size_t size;
+} HKModelCopyRange;
+
+static int HKCompareSlotOffset(const void *lhs, const void *rhs) {
+    ptrdiff_t offset = (*(const HKModelSlot * const *)lhs)->offset - (*(const HKModelSlot * const *)rhs)->offset;
+    return offset < 0 ? -1 : (offset > 0 ? 1 : 0);
+}
+
+void HKModelPlanRegisterWrapperImplementation(IMP wrapper, IMP implementation) {
+    pthread_mutex_lock(&HKModelWrapperLock);
+    if (!HKModelWrapperImplementations) {
+        HKModelWrapperImplementations = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL);
+    }
+    CFDictionarySetValue(HKModelWrapperImplementations, (const void *)wrapper, (const void *)implementation);
+    pthread_mutex_unlock(&HKModelWrapperLock);
+}
+
+static IMP HKResolveWrappedImplementation(IMP implementation) {
+    pthread_mutex_lock(&HKModelWrapperLock);
+    const void *wrapped = NULL;
+    while (implementation && HKModelWrapperImplementations && CFDictionaryGetValueIfPresent(HKModelWrapperImplementations, (const void *)implementation, &wrapped)) {
+        implementation = (IMP)wrapped;
+    }
+    pthread_mutex_unlock(&HKModelWrapperLock);
+    return implementation;
+}
+
+static BOOL HKIsOverriddenMethod(__unsafe_unretained Class class, SEL selector) {
+    return [class instanceMethodForSelector:selector] != [HKModel instanceMethodForSelector:selector];
+}
+
+@interface HKModelPlan () {
+    HKModelSlot *_slots;
+    NSArray<HKProperty *> *_properties;
+    NSDictionary<NSString *, NSNumber *> *_indexes;
+    
+    NSInteger *_UTF8KeyTable;
+    NSUInteger _UTF8KeyTableMask;
+    
+    HKModelCopyRange *_copyRanges;
+    NSUInteger _numberOfCopyRanges;
+    const HKModelSlot **_copyObjectSlots;       // object instance variables
+    NSUInteger _numberOfCopyObjectSlots;
+    const HKModelSlot **_copyPropertySlots;     // properties without instance variable, unsupported types
+    NSUInteger _numberOfCopyPropertySlots;
+}
+
+- (instancetype)initWithClass:(__unsafe_unretained Class)modelClass;
+- (void)HK_initializeSlot:(HKModelSlot *)slot withProperty:(HKProperty *)property;
+- (void)HK_initializeUTF8KeyTable;
+- (void)HK_initializeCopyLayout;
+- (void)HK_copyValuesFromModel:(id)source toModel:(id)destination isShared:(BOOL)isShared;
+
+@end
+
+@implementation HKModelPlan
+
++ (instancetype)planWithClass:(__unsafe_unretained Class)modelClass {
+    HKModelPlan *result = nil;
+    
+    pthread_rwlock_rdlock(&HKModelPlanLock);
+    result = HKModelPlans ? (__bridge HKModelPlan *)CFDictionaryGetValue(HKModelPlans, (__bridge const void *)modelClass) : nil;
+    pthread_rwlock_unlock(&HKModelPlanLock);
+    
+    if (!result) {
+        HKModelPlan *plan = [[self alloc] initWithClass:modelClass];
+        
+        pthread_rwlock_wrlock(&HKModelPlanLock);
+        if (!HKModelPlans) {
+            HKModelPlans = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        }
+        result = (__bridge HKModelPlan *)CFDictionaryGetValue(HKModelPlans, (__bridge const void *)modelClass);
+        if (!result) {
+            CFDictionarySetValue(HKModelPlans, (__bridge const void *)modelClass, (__bridge const void *)plan);
+            result = plan;
+        }
+        pthread_rwlock_unlock(&HKModelPlanLock);
+    }
+    
+    return result;
+}
+
+- (instancetype)initWithClass:(__unsafe_unretained Class)modelClass {
+    self = [super init];
+    if (self) {
+        _modelClass = modelClass;
+        
+        NSMutableArray<HKProperty *> *properties = [NSMutableArray array];
+        NSMutableSet<NSString *> *names = [NSMutableSet set];
+        Class class = modelClass;
+        do {
+            for (HKProperty *property in class.properties) {
+                if (!property.dynamic && !property.readOnly && ![names containsObject:property.name]) {
+                    [names addObject:property.name];
+                    [properties addObject:property];
+                }
+            }
+        } while ([(class = class.superclass) isSubclassOfClass:HKModel.class]);
+        
+        _properties = [properties copy];
+        _numberOfSlots = properties.count;
+        _slots = calloc(MAX(_numberOfSlots, 1), sizeof(HKModelSlot));
+        
+        NSMutableArray<NSString *> *allKeys = [NSMutableArray arrayWithCapacity:_numberOfSlots];
+        NSMutableDictionary<NSString *, NSNumber *> *indexes = [NSMutableDictionary dictionaryWithCapacity:_numberOfSlots];
+        for (NSUInteger index = 0; index < _numberOfSlots; index++) {
+            HKModelSlot *slot = &_slots[index];
+            slot->index = index;
+            [self HK_initializeSlot:slot withProperty:_properties[index]];
+            
+            [allKeys addObject:slot->key];
+            indexes[slot->key] = @(index);
+        }
+        _allKeys = [allKeys copy];
+        _indexes = [indexes copy];
+        [self HK_initializeUTF8KeyTable];
+        [self HK_initializeCopyLayout];
+        
+        _customSetSerializedObject = HKIsOverriddenMethod(modelClass, @selector(setSerializedObject:forKey:));
+        _customSerializedObjectForKey = HKIsOverriddenMethod(modelClass, @selector(serializedObjectForKey:));
+        _customAllKeys = HKIsOverriddenMethod(modelClass, @selector(allKeys));
+        _serializedObjectRequired = [modelClass methodForSelector:@selector(modelWithSerializedObject:)] != [HKModel methodForSelector:@selector(modelWithSerializedObject:)] || [modelClass isLazyMaterialization];
+        _internable = [modelClass isImmutable] && ![modelClass isLazyMaterialization] && ![modelClass isChangeTracking];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (NSUInteger index = 0; index < _numberOfSlots; index++) {
+        free((void *)_slots[index].UTF8Key);
+        free((void *)_slots[index].objCType);
+    }
+    free(_slots);
+    free(_UTF8KeyTable);
+    free(_copyRanges);
+    free(_copyObjectSlots);
+    free(_copyPropertySlots);
+}
+
+- (const HKModelSlot *)slotForKey:(NSString *)key {
+    NSNumber *index = _indexes[key];
+    return index ? &_slots[index.unsignedIntegerValue] : NULL;
+}
+
+- (const HKModelSlot *)slotForUTF8Key:(const char *)key length:(NSUInteger)length {
+    NSUInteger position = HKHashUTF8Key(key, length) & _UTF8KeyTableMask;
+    NSInteger index = 0;
+    while ((index = _UTF8KeyTable[position]) >= 0) {
+        const HKModelSlot *slot = &_slots[index];
+        if (slot->UTF8KeyLength == length && memcmp(slot->UTF8Key, key, length) == 0) {
+            return slot;
+        }
+        position = (position + 1) & _UTF8KeyTableMask;
+    }
+    return NULL;
+}
+
+- (void)copyValuesFromModel:(id)source toModel:(id)destination {
+    [self HK_copyValuesFromModel:source toModel:destination isShared:NO];
+}
+
+- (void)shareValuesFromModel:(id)source toModel:(id)destination {
+    [self HK_copyValuesFromModel:source toModel:destination isShared:YES];
+}
+
+- (void)HK_copyValuesFromModel:(id)source toModel:(id)destination isShared:(BOOL)isShared {
+    uint8_t *sourceBytes = (__bridge void *)source;
+    uint8_t *destinationBytes = (__bridge void *)destination;
+    for (NSUInteger index = 0; index < _numberOfCopyRanges; index++) {
+        memcpy(destinationBytes + _copyRanges[index].offset, sourceBytes + _copyRanges[index].offset, _copyRanges[index].size);
+    }
+    
+    for (NSUInteger index = 0; index < _numberOfCopyObjectSlots; index++) {
+        const HKModelSlot *slot = _copyObjectSlots[index];
+        void *sourcePointer = sourceBytes + slot->offset;
+        void *destinationPointer = destinationBytes + slot->offset;
+        if ((slot->attribute & HKPropertyAttributeCopy) == HKPropertyAttributeCopy && !isShared) {
+            *(__strong id *)destinationPointer = [*(__unsafe_unretained id *)sourcePointer copy];
+        } else if ((slot->attribute & (HKPropertyAttributeStrong | HKPropertyAttributeCopy)) != 0) {
+            *(__strong id *)destinationPointer = *(__unsafe_unretained id *)sourcePointer;
+        } else if ((slot->attribute & HKPropertyAttributeWeak) == HKPropertyAttributeWeak) {
+            *(__weak id *)destinationPointer = *(__weak id *)sourcePointer;
+        } else {
+            *(__unsafe_unretained id *)destinationPointer = *(__unsafe_unretained id *)sourcePointer;
+        }
+    }
+    
+    for (NSUInteger index = 0; index < _numberOfCopyPropertySlots; index++) {
+        HKProperty *property = _copyPropertySlots[index]->property;
+        [destination setObject:[source objectForProperty:property] forProperty:property];
+    }
+}
+
+- (void)resetValuesOfModel:(id)model {
+    uint8_t *bytes = (__bridge void *)model;
+    for (NSUInteger index = 0; index < _numberOfCopyRanges; index++) {
+        memset(bytes + _copyRanges[index].offset, 0, _copyRanges[index].size);
+    }
+    
+    for (NSUInteger index = 0; index < _numberOfCopyObjectSlots; index++) {
+        const HKModelSlot *slot = _copyObjectSlots[index];
+        void *pointer = bytes + slot->offset;
+        if ((slot->attribute & HKPropertyAttributeWeak) == HKPropertyAttributeWeak) {
+            *(__weak id *)pointer = nil;
+        } else if ((slot->attribute & (HKPropertyAttributeStrong | HKPropertyAttributeCopy)) != 0) {
+            *(__strong id *)pointer = nil;
+        } else {
+            *(__unsafe_unretained id *)pointer = nil;
+        }
+    }
+    
+    for (NSUInteger index = 0; index < _numberOfCopyPropertySlots; index++) {
+        const HKModelSlot *slot = _copyPropertySlots[index];
+        // scalar properties without instance variable can not be set to nil
+        if (slot->objCType[0] == '@') {
+            [model setObject:nil forProperty:slot->property];
+        }
+    }
+}
+
+#pragma mark - private methods
+
+- (void)HK_initializeSlot:(HKModelSlot *)slot withProperty:(HKProperty *)property {
+    slot->key = property.name;
+    slot->UTF8Key = strdup(property.name.UTF8String);
+    slot->UTF8KeyLength = strlen(slot->UTF8Key);
+    
+    slot->property = property;
+    slot->modelClass = _modelClass;
+    
+    slot->objCType = strdup(property.objCType);
+    slot->type = HKGetSlotType(slot->objCType);
+    slot->attribute = property.attribute;
+    
+    if (slot->type == HKModelSlotTypeObject) {
+        slot->propertyClass = property.propertyClass;
+        if ([slot->propertyClass conformsToProtocol:@protocol(HKModel)]) {
+            slot->type = HKModelSlotTypeModel;
+            slot->classKind = HKGetSlotClassKind(slot->propertyClass);
+            slot->isBase64 = slot->classKind == HKModelSlotClassKindData && ([_modelClass isBase64Data] || [[_modelClass base64DataKeys] containsObject:slot->key]);
+        }
+        slot->size = sizeof(id);
+    } else if (slot->type != HKModelSlotTypeUnsupported) {
+        NSGetSizeAndAlignment(slot->objCType, &slot->size, NULL);
+        slot->isTimeIntervalDate = slot->type == HKModelSlotTypeDouble && [[_modelClass timeIntervalDateKeys] containsObject:slot->key];
+    }
+    
+    slot->getter = property.getter;
+    slot->setter = property.setter;
+    slot->getterImplementation = class_respondsToSelector(_modelClass, slot->getter) ? HKResolveWrappedImplementation(class_getMethodImplementation(_modelClass, slot->getter)) : NULL;
+    slot->setterImplementation = (slot->setter && class_respondsToSelector(_modelClass, slot->setter)) ? HKResolveWrappedImplementation(class_getMethodImplementation(_modelClass, slot->setter)) : NULL;
+    
+    HKInstanceVariable *variable = property.instanceVariable;
+    slot->offset = variable ? variable.offset : -1;
+}
+
+// open addressing table (linear probing) of slot index by hash of UTF-8 key
+- (void)HK_initializeUTF8KeyTable {
+    NSUInteger capacity = 8;
+    while (capacity < _numberOfSlots * 2) {
+        capacity <<= 1;
+    }
+    _UTF8KeyTableMask = capacity - 1;
+    _UTF8KeyTable = malloc(capacity * sizeof(NSInteger));
+    for (NSUInteger position = 0; position < capacity; position++) {
+        _UTF8KeyTable[position] = -1;
+    }
+    
+    for (NSUInteger index = 0; index < _numberOfSlots; index++) {
+        NSUInteger position = HKHashUTF8Key(_slots[index].UTF8Key, _slots[index].UTF8KeyLength) & _UTF8KeyTableMask;
+        while (_UTF8KeyTable[position] >= 0) {
+            position = (position + 1) & _UTF8KeyTableMask;
+        }
+        _UTF8KeyTable[position] = (NSInteger)index;
+    }
+}
+
+// scalar ranges sorted by offset and merged when adjacent, object and other slots
+- (void)HK_initializeCopyLayout {
+    NSUInteger count = MAX(_numberOfSlots, 1);
+    const HKModelSlot **scalarSlots = malloc(count * sizeof(HKModelSlot *));
+    NSUInteger numberOfScalarSlots = 0;
+    _copyObjectSlots = malloc(count * sizeof(HKModelSlot *));
+    _copyPropertySlots = malloc(count * sizeof(HKModelSlot *));
+    
+    for (NSUInteger index = 0; index < _numberOfSlots; index++) {
+        const HKModelSlot *slot = &_slots[index];
+        if (slot->offset < 0 || slot->type == HKModelSlotTypeUnsupported) {
+            _copyPropertySlots[_numberOfCopyPropertySlots++] = slot;
+        } else if (slot->type == HKModelSlotTypeObject || slot->type == HKModelSlotTypeModel) {
+            _copyObjectSlots[_numberOfCopyObjectSlots++] = slot;
+        } else {
+            scalarSlots[numberOfScalarSlots++] = slot;
+        }
+    }
+    
+    qsort(scalarSlots, numberOfScalarSlots, sizeof(HKModelSlot *), HKCompareSlotOffset);
+    _copyRanges = malloc(MAX(numberOfScalarSlots, 1) * sizeof(HKModelCopyRange));
+    for (NSUInteger index = 0; index < numberOfScalarSlots; index++) {
+        HKModelCopyRange *last = _numberOfCopyRanges ? &_copyRanges[_numberOfCopyRanges - 1] : NULL;
+        ptrdiff_t offset = scalarSlots[index]->offset;
+        size_t size = scalarSlots[index]->size;
+        if (last && last->offset + (ptrdiff_t)last->size == offset) {
+            last->size += size;
+        } else if (!last || last->offset + (ptrdiff_t)last->size < offset) {
+            _copyRanges[_numberOfCopyRanges++] = (HKModelCopyRange){ offset, size };
+        }
+    }
+    free(scalarSlots);
+}
+
+@end
+
+#pragma mark - slot access
+
+#define HKSlotPointer(model, slot) ((void *)((uint8_t *)(__bridge void *)(model) + (slot)->offset))
+
+#define HKSlotSetScalar(type, model, slot, value) do { \
+    type scalar = (type)(value); \
+    IMP implementation = HKGetSetterImplementation(model, slot); \
+    if (implementation) { \
+        ((void (*)(id, SEL, type))implementation)(model, (slot)->setter, scalar); \
+    } else if ((slot)->offset >= 0) { \
+        *(type *)HKSlotPointer(model, slot) = scalar; \
+    } \
+} while (0)
+
+#define HKSlotGetScalar(type, model, slot) ({ \
+    type scalar = 0; \
+    IMP implementation = HKGetGetterImplementation(model, slot); \
+    if (implementation) { \
+        scalar = ((type (*)(id, SEL))implementation)(model, (slot)->getter); \
+    } else if ((slot)->offset >= 0) { \
+        scalar = *(type *)HKSlotPointer(model, slot); \
+    } \
+    scalar; \
+})
+
+// IMP in plan is resolved from plan's class, instance of other class (ex. KVO) uses own IMP
+static inline IMP HKGetSetterImplementation(id model, const HKModelSlot *slot) {
+    Class class = object_getClass(model);
+    if (class == slot->modelClass) {
+        return slot->setterImplementation;
+    }
+    return (slot->setter && class_respondsToSelector(class, slot->setter)) ? class_getMethodImplementation(class, slot->setter) : NULL;
+}
+
+static inline IMP HKGetGetterImplementation(id model, const HKModelSlot *slot) {
+    Class class = object_getClass(model);
+    if (class == slot->modelClass) {
+        return slot->getterImplementation;
+    }
+    return class_respondsToSelector(class, slot->getter) ? class_getMethodImplementation(class, slot->getter) : NULL;
+}
+
+static void HKModelSlotSetNumber(id model, const HKModelSlot *slot, NSNumber *number) {
+    switch (slot->type) {
+        case HKModelSlotTypeBool:
+            HKSlotSetScalar(bool, model, slot, number.boolValue);
+            break;
+        case HKModelSlotTypeChar:
+            HKSlotSetScalar(char, model, slot, number.charValue);
+            break;
+        case HKModelSlotTypeUnsignedChar:
+            HKSlotSetScalar(unsigned char, model, slot, number.unsignedCharValue);
+            break;
+        case HKModelSlotTypeShort:
+            HKSlotSetScalar(short, model, slot, number.shortValue);
+            break;
+        case HKModelSlotTypeUnsignedShort:
+            HKSlotSetScalar(unsigned short, model, slot, number.unsignedShortValue);
+            break;
+        case HKModelSlotTypeInt:
+            HKSlotSetScalar(int, model, slot, number.intValue);
+            break;
+        case HKModelSlotTypeUnsignedInt:
+            HKSlotSetScalar(unsigned int, model, slot, number.unsignedIntValue);
+            break;
+        case HKModelSlotTypeLong:
+            HKSlotSetScalar(long, model, slot, number.longValue);
+            break;
+        case HKModelSlotTypeUnsignedLong:
+            HKSlotSetScalar(unsigned long, model, slot, number.unsignedLongValue);
+            break;
+        case HKModelSlotTypeLongLong:
+            HKSlotSetScalar(long long, model, slot, number.longLongValue);
+            break;
+        case HKModelSlotTypeUnsignedLongLong:
+            HKSlotSetScalar(unsigned long long, model, slot, number.unsignedLongLongValue);
+            break;
+        case HKModelSlotTypeFloat:
+            HKSlotSetScalar(float, model, slot, number.floatValue);
+            break;
+        case HKModelSlotTypeDouble:
+            HKSlotSetScalar(double, model, slot, number.doubleValue);
+            break;
+        default:
+            break;
+    }
+}
+
+void HKModelSlotSetNumberBytes(id model, const HKModelSlot *slot, const char *bytes, NSUInteger length) {
+    // integers are exact without double conversion (ex. 64-bit identifier)
+    HKModelNumber number;
+    NSUInteger numberLength = HKModelNumberParse(bytes, length, &number);
+    NSTimeInterval timeInterval = 0;
+    if (slot->isTimeIntervalDate && numberLength < length && HKModelDateParseISO8601(bytes, length, &timeInterval)) {
+        // ISO 8601 date for NSTimeInterval (seconds since 1970), whole number text is number (ex. "20180823")
+        HKModelSlotSetDouble(model, slot, timeInterval);
+    } else {
+        HKModelSlotSetParsedNumber(model, slot, &number);
+    }
+}
+
+static void HKModelSlotSetString(id model, const HKModelSlot *slot, NSString *string) {
+    switch (slot->type) {
+        case HKModelSlotTypeBool:
+        case HKModelSlotTypeChar:
+            HKModelSlotSetLongLong(model, slot, string.boolValue);
+            break;
+        case HKModelSlotTypeDouble:
+            if (slot->isTimeIntervalDate) {
+                const char *bytes = string.UTF8String;
+                HKModelSlotSetNumberBytes(model, slot, bytes, bytes ? strlen(bytes) : 0);
+                break;
+            }
+            // fall through
+        default: {
+            // integers are exact without double conversion (ex. 64-bit identifier)
+            HKModelNumber number;
+            HKModelNumberParseString(string, &number);
+            HKModelSlotSetParsedNumber(model, slot, &number);
+            break;
+        }
+    }
+}
+
+static void HKModelSlotSetValue(id model, const HKModelSlot *slot, NSValue *value) {
+    if (slot->offset >= 0) {
+        const char *objCType = value.objCType;
+        NSUInteger size = 0;
+        if (strcmp(objCType, slot->objCType) != 0) {
+            NSGetSizeAndAlignment(objCType, &size, NULL);
+        }
+        if (size == 0 || size == slot->size) {
+            [value getValue:HKSlotPointer(model, slot)];
+        }
+    }
+}
+
+void HKModelSlotSetObject(id model, const HKModelSlot *slot, id object) {
+    IMP implementation = HKGetSetterImplementation(model, slot);
+    if (implementation) {
+        ((void (*)(id, SEL, id))implementation)(model, slot->setter, object);
+    } else if (slot->offset >= 0) {
+        void *pointer = HKSlotPointer(model, slot);
+        if ((slot->attribute & HKPropertyAttributeCopy) == HKPropertyAttributeCopy) {
+            *(__strong id *)pointer = [object copy];
+        } else if ((slot->attribute & HKPropertyAttributeStrong) == HKPropertyAttributeStrong) {
+            *(__strong id *)pointer = object;
+        } else if ((slot->attribute & HKPropertyAttributeWeak) == HKPropertyAttributeWeak) {
+            *(__weak id *)pointer = object;
+        } else {
+            *(__unsafe_unretained id *)pointer = object;
+        }
+    }
+}
+
+void HKModelSlotSetLongLong(id model, const HKModelSlot *slot, long long value) {
+    switch (slot->type) {
+        case HKModelSlotTypeBool:
+            HKSlotSetScalar(bool, model, slot, value != 0);
+            break;
+        case HKModelSlotTypeChar:
+            HKSlotSetScalar(char, model, slot, value);
+            break;
+        case HKModelSlotTypeUnsignedChar:
+            HKSlotSetScalar(unsigned char, model, slot, value);
+            break;
+        case HKModelSlotTypeShort:
+            HKSlotSetScalar(short, model, slot, value);
+            break;
+        case HKModelSlotTypeUnsignedShort:
+            HKSlotSetScalar(unsigned short, model, slot, value);
+            break;
+        case HKModelSlotTypeInt:
+            HKSlotSetScalar(int, model, slot, value);
+            break;
+        case HKModelSlotTypeUnsignedInt:
+            HKSlotSetScalar(unsigned int, model, slot, value);
+            break;
+        case HKModelSlotTypeLong:
+            HKSlotSetScalar(long, model, slot, value);
+            break;
+        case HKModelSlotTypeUnsignedLong:
+            HKSlotSetScalar(unsigned long, model, slot, value);
+            break;
+        case HKModelSlotTypeLongLong:
+            HKSlotSetScalar(long long, model, slot, value);
+            break;
+        case HKModelSlotTypeUnsignedLongLong:
+            HKSlotSetScalar(unsigned long long, model, slot, value);
+            break;
+        case HKModelSlotTypeFloat:
+            HKSlotSetScalar(float, model, slot, value);
+            break;
+        case HKModelSlotTypeDouble:
+            HKSlotSetScalar(double, model, slot, value);
+            break;
+        default:
+            break;
+    }
+}
+
+void HKModelSlotSetUnsignedLongLong(id model, const HKModelSlot *slot, unsigned long long value) {
+    switch (slot->type) {
+        case HKModelSlotTypeFloat:
+        case HKModelSlotTypeDouble:
+            HKModelSlotSetDouble(model, slot, (double)value);
+            break;
+        case HKModelSlotTypeUnsignedLongLong:
+            HKSlotSetScalar(unsigned long long, model, slot, value);
+            break;
+        default:
+            HKModelSlotSetLongLong(model, slot, (long long)value);
+            break;
+    }
+}
+
+// clamped as HKModelNumberLongLongValue (cast of NaN or out of range double is undefined)
+static inline long long HKClampDoubleToLongLong(double value) {
+    if (value != value) {
+        return 0;
+    }
+    return value >= 0x1p63 ? LLONG_MAX : (value <= -0x1p63 ? LLONG_MIN : (long long)value);
+}
+
+// clamped as HKModelNumberUnsignedLongLongValue (negative value is wrapped as strtoull)
+static inline unsigned long long HKClampDoubleToUnsignedLongLong(double value) {
+    if (value < 0) {
+        return (unsigned long long)HKClampDoubleToLongLong(value);
+    }
+    return value >= 0x1p64 ? ULLONG_MAX : (value == value ? (unsigned long long)value : 0);
+}
+
+void HKModelSlotSetDouble(id model, const HKModelSlot *slot, double value) {
+    switch (slot->type) {
+        case HKModelSlotTypeBool:
+            HKSlotSetScalar(bool, model, slot, value != 0.0);
+            break;
+        case HKModelSlotTypeFloat:
+            HKSlotSetScalar(float, model, slot, value);
+            break;
+        case HKModelSlotTypeDouble:
+            HKSlotSetScalar(double, model, slot, value);
+            break;
+        case HKModelSlotTypeUnsignedLongLong:
+            HKSlotSetScalar(unsigned long long, model, slot, HKClampDoubleToUnsignedLongLong(value));
+            break;
+        default:
+            HKModelSlotSetLongLong(model, slot, HKClampDoubleToLongLong(value));
+            break;
+    }
+}
+
+void HKModelSlotSetSerializedObject(id model, const HKModelSlot *slot, id serializedObject) {
+    if (!serializedObject) {
+        return;
+    }
+    
+    switch (slot->type) {
+        case HKModelSlotTypeUnsupported:
+            break;
+        case HKModelSlotTypeObject:
+            HKModelSlotSetObject(model, slot, serializedObject);
+            break;
+        case HKModelSlotTypeModel:
+            if (slot->isBase64 && [serializedObject isKindOfClass:NSString.class]) {
+                HKModelSlotSetObject(model, slot, HKModelBase64DataWithString(serializedObject));
+                break;
+            }
+            HKModelSlotSetObject(model, slot, [slot->propertyClass modelWithSerializedObject:serializedObject]);
+            break;
+        case HKModelSlotTypeStruct:
+            if ([serializedObject isKindOfClass:NSValue.class]) {
+                HKModelSlotSetValue(model, slot, serializedObject);
+            }
+            break;
+        default:
+            if ([serializedObject isKindOfClass:NSNumber.class]) {
+                HKModelSlotSetNumber(model, slot, serializedObject);
+            } else if ([serializedObject isKindOfClass:NSString.class]) {
+                HKModelSlotSetString(model, slot, serializedObject);
+            }
+            break;
+    }
+}
+
+id HKModelSlotGetObject(id model, const HKModelSlot *slot) {
+    switch (slot->type) {
+        case HKModelSlotTypeObject:
+        case HKModelSlotTypeModel: {
+            IMP implementation = HKGetGetterImplementation(model, slot);
+            if (implementation) {
+                return ((id (*)(id, SEL))implementation)(model, slot->getter);
+            } else if (slot->offset >= 0) {
+                void *pointer = HKSlotPointer(model, slot);
+                return (slot->attribute & HKPropertyAttributeWeak) == HKPropertyAttributeWeak ? *(__weak id *)pointer : *(__unsafe_unretained id *)pointer;
+            }
+            return nil;
+        }
+        case HKModelSlotTypeBool:
+            return @(HKSlotGetScalar(bool, model, slot));
+        case HKModelSlotTypeChar:
+            return @(HKSlotGetScalar(char, model, slot));
+        case HKModelSlotTypeUnsignedChar:
+            return @(HKSlotGetScalar(unsigned char, model, slot));
+        case HKModelSlotTypeShort:
+            return @(HKSlotGetScalar(short, model, slot));
+        case HKModelSlotTypeUnsignedShort:
+            return @(HKSlotGetScalar(unsigned short, model, slot));
+        case HKModelSlotTypeInt:
+            return @(HKSlotGetScalar(int, model, slot));
+        case HKModelSlotTypeUnsignedInt:
+            return @(HKSlotGetScalar(unsigned int, model, slot));
+        case HKModelSlotTypeLong:
+            return @(HKSlotGetScalar(long, model, slot));
+        case HKModelSlotTypeUnsignedLong:
+            return @(HKSlotGetScalar(unsigned long, model, slot));
+        case HKModelSlotTypeLongLong:
+            return @(HKSlotGetScalar(long long, model, slot));
+        case HKModelSlotTypeUnsignedLongLong:
+            return @(HKSlotGetScalar(unsigned long long, model, slot));
+        case HKModelSlotTypeFloat:
+            return @(HKSlotGetScalar(float, model, slot));
+        case HKModelSlotTypeDouble:
+            return @(HKSlotGetScalar(double, model, slot));
+        case HKModelSlotTypeStruct:
+            return slot->offset >= 0 ? [NSValue value:HKSlotPointer(model, slot) withObjCType:slot->objCType] : nil;
+        default:
+            return nil;
+    }
+}
+
+long long HKModelSlotGetLongLong(id model, const HKModelSlot *slot) {
+    switch (slot->type) {
+        case HKModelSlotTypeBool:
+            return HKSlotGetScalar(bool, model, slot);
+        case HKModelSlotTypeChar:
+            return HKSlotGetScalar(char, model, slot);
+        case HKModelSlotTypeUnsignedChar:
+            return HKSlotGetScalar(unsigned char, model, slot);
+        case HKModelSlotTypeShort:
+            return HKSlotGetScalar(short, model, slot);
+        case HKModelSlotTypeUnsignedShort:
+            return HKSlotGetScalar(unsigned short, model, slot);
+        case HKModelSlotTypeInt:
+            return HKSlotGetScalar(int, model, slot);
+        case HKModelSlotTypeUnsignedInt:
+            return HKSlotGetScalar(unsigned int, model, slot);
+        case HKModelSlotTypeLong:
+            return HKSlotGetScalar(long, model, slot);
+        case HKModelSlotTypeUnsignedLong:
+            return (long long)HKSlotGetScalar(unsigned long, model, slot);
+        case HKModelSlotTypeLongLong:
+            return HKSlotGetScalar(long long, model, slot);
+        case HKModelSlotTypeUnsignedLongLong:
+            return (long long)HKSlotGetScalar(unsigned long long, model, slot);
+        case HKModelSlotTypeFloat:
+            return (long long)HKSlotGetScalar(float, model, slot);
+        case HKModelSlotTypeDouble:
+            return (long long)HKSlotGetScalar(double, model, slot);
+        default:
+            return 0;
+    }
+}
+
+unsigned long long HKModelSlotGetUnsignedLongLong(id model, const HKModelSlot *slot) {
+    switch (slot->type) {
+        case HKModelSlotTypeUnsignedLong:
+            return HKSlotGetScalar(unsigned long, model, slot);
+        case HKModelSlotTypeUnsignedLongLong:
+            return HKSlotGetScalar(unsigned long long, model, slot);
+        case HKModelSlotTypeFloat:
+        case HKModelSlotTypeDouble:
+            return (unsigned long long)HKModelSlotGetDouble(model, slot);
+        default:
+            return (unsigned long long)HKModelSlotGetLongLong(model, slot);
+    }
+}
+
+double HKModelSlotGetDouble(id model, const HKModelSlot *slot) {
+    switch (slot->type) {
+        case HKModelSlotTypeFloat:
+            return HKSlotGetScalar(float, model, slot);
+        case HKModelSlotTypeDouble:
+            return HKSlotGetScalar(double, model, slot);
+        case HKModelSlotTypeUnsignedLong:
+        case HKModelSlotTypeUnsignedLongLong:
+            return (double)HKModelSlotGetUnsignedLongLong(model, slot);
+        default:
+            return (double)HKModelSlotGetLongLong(model, slot);
+    }
+}
+
+id HKModelSlotGetSerializedObject(id model, const HKModelSlot *slot) {
+    switch (slot->type) {
+        case HKModelSlotTypeUnsupported:
+        case HKModelSlotTypeStruct:
+            return nil;
+        case HKModelSlotTypeModel: {
+            id object = HKModelSlotGetObject(model, slot);
+            if (slot->isBase64 && [object isKindOfClass:NSData.class]) {
+                return HKModelBase64StringWithData(object);
+            }
+            return ((id<HKModel>)object).serializedObject;
+        }
+        case HKModelSlotTypeObject: {
+            id object = HKModelSlotGetObject(model, slot);
+            return [object conformsToProtocol:@protocol(HKModel)] ? ((id<HKModel>)object).serializedObject : nil;
+        }
+        default:
+            return HKModelSlotGetObject(model, slot);
+    }
+}
+
+#pragma mark - concurrent
+NSUInteger HKModelConcurrentChunkCount(NSUInteger count) {
+    return MAX(MIN(NSProcessInfo.processInfo.activeProcessorCount * 4, count), 1);
+}
+
+void HKModelPerformConcurrently(NSUInteger count, NSUInteger chunkCount, void (NS_NOESCAPE ^block)(NSUInteger chunk, NSRange range)) {
+    qos_class_t qos = qos_class_self();
+    dispatch_queue_t queue = dispatch_get_global_queue(qos == QOS_CLASS_UNSPECIFIED ? QOS_CLASS_DEFAULT : qos, 0);
+    NSUInteger chunkLength = (count + chunkCount - 1) / chunkCount;
+    HKModelDecodeContext *context = HKModelDecodeContext.currentContext;
+    
+    dispatch_apply(chunkCount, queue, ^(size_t chunk) {
+        NSUInteger location = MIN(chunk * chunkLength, count);
+        @autoreleasepool {
+            NSRange range = NSMakeRange(location, MIN(chunkLength, count - location));
+            context ? [context performBlock:^{ block(chunk, range); }] : block(chunk, range);
+        }
+    });
+}
+
+void HKModelTransformObjectsConcurrently(NSArray *objects, NSMutableArray *result, id (NS_NOESCAPE ^transform)(id object)) {
+    NSUInteger count = objects.count;
+    __unsafe_unretained id *values = (__unsafe_unretained id *)malloc(count * sizeof(id));
+    __strong id *transformed = (__strong id *)calloc(count, sizeof(id));
+    [objects getObjects:values range:NSMakeRange(0, count)];
+    
+    HKModelPerformConcurrently(count, HKModelConcurrentChunkCount(count), ^(NSUInteger chunk, NSRange range) {
+        for (NSUInteger index = range.location; index < NSMaxRange(range); index++) {
+            transformed[index] = transform(values[index]);
+        }
+    });
+    
+    for (NSUInteger index = 0; index < count; index++) {
+        transformed[index] ? [result addObject:transformed[index]] : nil;
+        transformed[index] = nil;
+    }
+    free(transformed);
+    free(values);
+}
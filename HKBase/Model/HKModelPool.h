@@ -0,0 +1,92 @@
+//
+//  HKModelPool.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ pool of reusable models of one class
+ recycled models are reset by HKModel.prepareForReuse (instance variables are cleared by cached layout of class)
+ and returned by next dequeue instead of allocating new model (thread safe)
+ recycled models should not be referenced by others (ex. interned model of HKModelDecodeContext)
+ */
+@interface HKModelPool<ObjectType : HKModel *> : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+/**
+ pool
+
+ @param modelClass class of models
+ @param capacity maximum number of models kept in pool
+ @return pool
+ */
++ (instancetype)poolWithModelClass:(Class)modelClass capacity:(NSUInteger)capacity;
+
+/**
+ class of models
+ */
+@property (nonatomic, unsafe_unretained, readonly) Class modelClass;
+/**
+ maximum number of models kept in pool
+ */
+@property (nonatomic, readonly) NSUInteger capacity;
+/**
+ number of models kept in pool
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ recycled model (new model if pool is empty)
+
+ @return model with nil or zero properties
+ */
+- (ObjectType)dequeueModel;
+/**
+ recycled model decoded from serialized object (as +[HKModel modelWithSerializedObject:], not interned)
+
+ @param serializedObject serialized object (ex. JSON Object)
+ @return model (nil if serializedObject is nil)
+ */
+- (nullable ObjectType)modelWithSerializedObject:(nullable id)serializedObject;
+/**
+ reset model and keep it for reuse (dropped if pool is full or class is different)
+
+ @param model model not used any more
+ */
+- (void)recycleModel:(ObjectType)model;
+/**
+ reset models and keep them for reuse
+
+ @param models models not used any more
+ */
+- (void)recycleModels:(NSArray<ObjectType> *)models;
+/**
+ release all models kept in pool
+ */
+- (void)removeAllModels;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,117 @@
+//
+//  HKModelPool.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelPool.h"
+#import "HKModelPlan.h"
+#import <pthread.h>
+#import <objc/runtime.h>
+
+@interface HKModel (HKModelPoolPrivate)
+
+- (void)HK_setValuesWithSerializedObject:(id)serializedObject plan:(HKModelPlan *)plan;
+
+@end
+
+@interface HKModelPool () {
+    pthread_mutex_t _lock;
+    NSMutableArray<HKModel *> *_models;
+}
+
+- (instancetype)HK_initWithModelClass:(Class)modelClass capacity:(NSUInteger)capacity;
+
+@end
+
+@implementation HKModelPool
+
++ (instancetype)poolWithModelClass:(Class)modelClass capacity:(NSUInteger)capacity {
+    return [[self alloc] HK_initWithModelClass:modelClass capacity:capacity];
+}
+
+- (instancetype)HK_initWithModelClass:(Class)modelClass capacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        NSAssert([modelClass isSubclassOfClass:HKModel.class], @"model class should be subclass of HKModel");
+        _modelClass = modelClass;
+        _capacity = capacity;
+        _models = [NSMutableArray arrayWithCapacity:MIN(capacity, 1024)];
+        pthread_mutex_init(&_lock, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (NSUInteger)count {
+    pthread_mutex_lock(&_lock);
+    NSUInteger result = _models.count;
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+- (HKModel *)dequeueModel {
+    pthread_mutex_lock(&_lock);
+    HKModel *result = _models.lastObject;
+    if (result) {
+        [_models removeLastObject];
+    }
+    pthread_mutex_unlock(&_lock);
+    return result ?: [[self.modelClass alloc] init];
+}
+
+- (HKModel *)modelWithSerializedObject:(id)serializedObject {
+    if (!serializedObject) {
+        return nil;
+    }
+    HKModel *result = [self dequeueModel];
+    [result HK_setValuesWithSerializedObject:serializedObject plan:[HKModelPlan planWithClass:self.modelClass]];
+    return result;
+}
+
+- (void)recycleModel:(HKModel *)model {
+    if (object_getClass(model) != self.modelClass) {
+        return;
+    }
+    [model prepareForReuse];
+    
+    pthread_mutex_lock(&_lock);
+    if (_models.count < _capacity) {
+        [_models addObject:model];
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)recycleModels:(NSArray<HKModel *> *)models {
+    for (HKModel *model in models) {
+        [self recycleModel:model];
+    }
+}
+
+- (void)removeAllModels {
+    pthread_mutex_lock(&_lock);
+    [_models removeAllObjects];
+    pthread_mutex_unlock(&_lock);
+}
+
+@end
@@ -0,0 +1,156 @@
+//
+//  HKModelQuery.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ kind of index
+
+ - HKModelIndexTypeHash: equality index (value -> indexes)
+ - HKModelIndexTypeRange: sorted index (equality and range, nil values are excluded)
+ */
+typedef NS_ENUM(NSInteger, HKModelIndexType) {
+    HKModelIndexTypeHash = 0,
+    HKModelIndexTypeRange,
+};
+
+/**
+ secondary index on property of models (snapshot of array)
+ build again after array is changed, query ignores index if models of array are different from snapshot (compared by identity)
+ */
+@interface HKModelIndex<ObjectType : HKModel *> : NSObject
+
+/**
+ build index
+
+ @param models models (kind of modelClass, ex. HKArray(HKCard))
+ @param modelClass class of models
+ @param key property name
+ @param type kind of index
+ @return index (nil if key is not property of modelClass)
+ */
++ (nullable instancetype)indexWithModels:(NSArray<ObjectType> *)models modelClass:(Class)modelClass key:(NSString *)key type:(HKModelIndexType)type;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ indexed models (copy of array)
+ */
+@property (nonatomic, readonly) NSArray<ObjectType> *models;
+/**
+ property name
+ */
+@property (nonatomic, readonly) NSString *key;
+/**
+ kind of index
+ */
+@property (nonatomic, readonly) HKModelIndexType type;
+
+/**
+ indexes of models which property is equal to value
+
+ @param value value (NSNumber for number property, nil for nil property)
+ @return indexes in models
+ */
+- (NSIndexSet *)indexesOfValue:(nullable id)value;
+/**
+ indexes of models which property is in range (HKModelIndexTypeRange only, empty for hash index)
+
+ @param lowerValue lower bound (nil is unbounded)
+ @param includesLower lower bound is included
+ @param upperValue upper bound (nil is unbounded)
+ @param includesUpper upper bound is included
+ @return indexes in models
+ */
+- (NSIndexSet *)indexesOfValuesFrom:(nullable id)lowerValue inclusive:(BOOL)includesLower to:(nullable id)upperValue inclusive:(BOOL)includesUpper;
+
+@end
+
+/**
+ predicate compiled against HKModelPlan (immutable, reusable)
+ comparison of property and constant (==, !=, <, <=, >, >=, IN, BETWEEN) with AND, OR, NOT
+ reads property by slot without KVC, other predicates are evaluated by NSPredicate
+ 
+ HKModelQuery *query = [HKModelQuery queryWithPredicate:[NSPredicate predicateWithFormat:@"brand == %@", HKBrand.Master] modelClass:HKCard.class];
+ NSArray<HKCard *> *masterCards = [query filteredArray:cards];
+ */
+@interface HKModelQuery<ObjectType : HKModel *> : NSObject
+
+/**
+ compile predicate
+
+ @param predicate predicate
+ @param modelClass class of models
+ @return query
+ */
++ (instancetype)queryWithPredicate:(NSPredicate *)predicate modelClass:(Class)modelClass;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ source predicate
+ */
+@property (nonatomic, readonly) NSPredicate *predicate;
+/**
+ class of models
+ */
+@property (nonatomic, unsafe_unretained, readonly) Class modelClass;
+
+/**
+ evaluate query
+
+ @param model model
+ @return YES if matched
+ */
+- (BOOL)evaluateWithModel:(ObjectType)model;
+/**
+ indexes of matched models
+ indexes are used for comparisons of indexed key (only if index is built on same array)
+
+ @param models models
+ @param indexes indexes built on models (nil if not indexed)
+ @return indexes in models
+ */
+- (NSIndexSet *)indexesInArray:(NSArray<ObjectType> *)models usingIndexes:(nullable NSArray<HKModelIndex *> *)indexes;
+/**
+ matched models
+
+ @param models models
+ @return matched models
+ */
+- (NSArray<ObjectType> *)filteredArray:(NSArray<ObjectType> *)models;
+/**
+ matched models using indexes
+
+ @param models models
+ @param indexes indexes built on models (nil if not indexed)
+ @return matched models
+ */
+- (NSArray<ObjectType> *)filteredArray:(NSArray<ObjectType> *)models usingIndexes:(nullable NSArray<HKModelIndex *> *)indexes;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,540 @@
+//
+//  HKModelQuery.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelQuery.h"
+#import "HKModelPlan.h"
+#import "HKModelLazyStorage.h"
+
+// property value of model (object properties of lazy model are converted first)
+static id HKQueryGetObject(id model, const HKModelSlot *slot) {
+    HKModelLazyStorage *lazyStorage = HKModelGetLazyStorage(model);
+    lazyStorage ? [lazyStorage materializeSlot:slot ofModel:model] : nil;
+    return HKModelSlotGetObject(model, slot);
+}
+
+#pragma mark - index
+@interface HKModelIndex () {
+    const HKModelSlot *_slot;
+    NSUInteger _count;
+    
+    NSDictionary<id, NSIndexSet *> *_indexesByValue;    // hash index, nil value is NSNull
+    
+    NSArray *_sortedValues;     // range index
+    NSUInteger *_order;         // index in models of sorted value
+}
+
+- (instancetype)HK_initWithModels:(NSArray *)models slot:(const HKModelSlot *)slot type:(HKModelIndexType)type;
+- (BOOL)HK_isValidForModels:(NSArray *)models;
+- (NSUInteger)HK_positionOfValue:(id)value inclusive:(BOOL)isInclusive isUpper:(BOOL)isUpper;
+
+@end
+
+@implementation HKModelIndex
+
++ (instancetype)indexWithModels:(NSArray *)models modelClass:(Class)modelClass key:(NSString *)key type:(HKModelIndexType)type {
+    const HKModelSlot *slot = [[HKModelPlan planWithClass:modelClass] slotForKey:key];
+    return slot ? [[self alloc] HK_initWithModels:models slot:slot type:type] : nil;
+}
+
+- (instancetype)HK_initWithModels:(NSArray *)models slot:(const HKModelSlot *)slot type:(HKModelIndexType)type {
+    self = [super init];
+    if (self) {
+        _models = [models copy];
+        _key = slot->key;
+        _type = type;
+        _slot = slot;
+        _count = models.count;
+        
+        if (type == HKModelIndexTypeHash) {
+            NSMutableDictionary<id, NSMutableIndexSet *> *indexesByValue = [NSMutableDictionary dictionary];
+            [models enumerateObjectsUsingBlock:^(id model, NSUInteger index, BOOL *stop) {
+                id value = HKQueryGetObject(model, slot) ?: NSNull.null;
+                NSMutableIndexSet *indexes = indexesByValue[value];
+                if (!indexes) {
+                    indexes = [NSMutableIndexSet indexSet];
+                    indexesByValue[value] = indexes;
+                }
+                [indexes addIndex:index];
+            }];
+            _indexesByValue = [indexesByValue copy];
+        } else {
+            NSMutableArray *values = [NSMutableArray arrayWithCapacity:_count];
+            NSMutableArray<NSNumber *> *positions = [NSMutableArray arrayWithCapacity:_count];
+            [models enumerateObjectsUsingBlock:^(id model, NSUInteger index, BOOL *stop) {
+                id value = HKQueryGetObject(model, slot);
+                if (value) {
+                    [values addObject:value];
+                    [positions addObject:@(index)];
+                }
+            }];
+            
+            NSUInteger numberOfValues = values.count;
+            NSUInteger *order = malloc(MAX(numberOfValues, 1) * sizeof(NSUInteger));
+            for (NSUInteger index = 0; index < numberOfValues; index++) {
+                order[index] = index;
+            }
+            // stable sort of value positions, then replace with index in models
+            qsort_b(order, numberOfValues, sizeof(NSUInteger), ^int(const void *lhs, const void *rhs) {
+                NSUInteger left = *(const NSUInteger *)lhs;
+                NSUInteger right = *(const NSUInteger *)rhs;
+                NSComparisonResult result = [values[left] compare:values[right]];
+                return result != NSOrderedSame ? (int)result : (left < right ? -1 : (left > right ? 1 : 0));
+            });
+            NSMutableArray *sortedValues = [NSMutableArray arrayWithCapacity:numberOfValues];
+            for (NSUInteger index = 0; index < numberOfValues; index++) {
+                [sortedValues addObject:values[order[index]]];
+                order[index] = positions[order[index]].unsignedIntegerValue;
+            }
+            _sortedValues = [sortedValues copy];
+            _order = order;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_order);
+}
+
+// array mutated in place (same object) is detected by comparing models with snapshot
+- (BOOL)HK_isValidForModels:(NSArray *)models {
+    if (models.count != _count) {
+        return NO;
+    }
+    NSUInteger index = 0;
+    for (id model in models) {
+        if (model != _models[index++]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (NSIndexSet *)indexesOfValue:(id)value {
+    if (_type == HKModelIndexTypeHash) {
+        return _indexesByValue[value ?: NSNull.null] ?: [NSIndexSet indexSet];
+    }
+    return value ? [self indexesOfValuesFrom:value inclusive:YES to:value inclusive:YES] : [NSIndexSet indexSet];
+}
+
+- (NSIndexSet *)indexesOfValuesFrom:(id)lowerValue inclusive:(BOOL)includesLower to:(id)upperValue inclusive:(BOOL)includesUpper {
+    NSMutableIndexSet *result = [NSMutableIndexSet indexSet];
+    if (_type != HKModelIndexTypeRange) {
+        return result;
+    }
+    
+    NSUInteger location = lowerValue ? [self HK_positionOfValue:lowerValue inclusive:includesLower isUpper:NO] : 0;
+    NSUInteger end = upperValue ? [self HK_positionOfValue:upperValue inclusive:includesUpper isUpper:YES] : _sortedValues.count;
+    for (NSUInteger position = location; position < end; position++) {
+        [result addIndex:_order[position]];
+    }
+    return result;
+}
+
+// first position of sorted value after bound (binary search)
+- (NSUInteger)HK_positionOfValue:(id)value inclusive:(BOOL)isInclusive isUpper:(BOOL)isUpper {
+    // lower bound: first value >= (or >) bound, upper bound: first value > (or >=) bound
+    BOOL isAfterEqual = isUpper ? isInclusive : !isInclusive;
+    NSUInteger low = 0;
+    NSUInteger high = _sortedValues.count;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        NSComparisonResult result = [_sortedValues[middle] compare:value];
+        if (result == NSOrderedAscending || (result == NSOrderedSame && isAfterEqual)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+@end
+
+#pragma mark - compiled predicate
+typedef NS_ENUM(NSInteger, HKQueryNodeKind) {
+    HKQueryNodeKindComparison = 0,
+    HKQueryNodeKindAnd,
+    HKQueryNodeKindOr,
+    HKQueryNodeKindNot,
+    HKQueryNodeKindPredicate,   // not compiled, evaluated by NSPredicate
+};
+
+@interface HKQueryNode : NSObject {
+    @package
+    HKQueryNodeKind _kind;
+    NSArray<HKQueryNode *> *_children;
+    NSPredicate *_predicate;
+    
+    const HKModelSlot *_slot;
+    NSPredicateOperatorType _operatorType;
+    id _value;                  // constant (lower bound of BETWEEN)
+    id _upperValue;             // upper bound of BETWEEN
+    NSSet *_values;             // constants of IN
+    
+    BOOL _isNumber;             // number property compared without boxing
+    BOOL _isReal;
+    BOOL _isUnsigned;           // unsigned property and non negative integral constant
+    long long _integer;
+    double _real;
+    unsigned long long _unsignedInteger;
+    long long _upperInteger;
+    double _upperReal;
+    unsigned long long _upperUnsignedInteger;
+}
+
+@end
+
+@implementation HKQueryNode
+@end
+
+static NSPredicateOperatorType HKQueryReversedOperatorType(NSPredicateOperatorType operatorType) {
+    switch (operatorType) {
+        case NSLessThanPredicateOperatorType:               return NSGreaterThanPredicateOperatorType;
+        case NSLessThanOrEqualToPredicateOperatorType:      return NSGreaterThanOrEqualToPredicateOperatorType;
+        case NSGreaterThanPredicateOperatorType:            return NSLessThanPredicateOperatorType;
+        case NSGreaterThanOrEqualToPredicateOperatorType:   return NSLessThanOrEqualToPredicateOperatorType;
+        default:                                            return operatorType;
+    }
+}
+
+static BOOL HKQueryIsIntegral(NSNumber *number) {
+    const char *objCType = number.objCType;
+    return objCType[0] != 'f' && objCType[0] != 'd';
+}
+
+static HKQueryNode *HKQueryCompile(NSPredicate *predicate, HKModelPlan *plan) {
+    HKQueryNode *node = [[HKQueryNode alloc] init];
+    node->_kind = HKQueryNodeKindPredicate;
+    node->_predicate = predicate;
+    
+    if ([predicate isKindOfClass:NSCompoundPredicate.class]) {
+        NSCompoundPredicate *compoundPredicate = (NSCompoundPredicate *)predicate;
+        NSMutableArray<HKQueryNode *> *children = [NSMutableArray arrayWithCapacity:compoundPredicate.subpredicates.count];
+        for (NSPredicate *subpredicate in compoundPredicate.subpredicates) {
+            [children addObject:HKQueryCompile(subpredicate, plan)];
+        }
+        switch (compoundPredicate.compoundPredicateType) {
+            case NSAndPredicateType:
+                node->_kind = HKQueryNodeKindAnd;
+                break;
+            case NSOrPredicateType:
+                node->_kind = HKQueryNodeKindOr;
+                break;
+            case NSNotPredicateType:
+                node->_kind = children.count == 1 ? HKQueryNodeKindNot : HKQueryNodeKindPredicate;
+                break;
+        }
+        node->_children = children;
+        return node;
+    } else if (![predicate isKindOfClass:NSComparisonPredicate.class]) {
+        return node;
+    }
+    
+    // property (key path of one key) and constant without modifier and option
+    NSComparisonPredicate *comparisonPredicate = (NSComparisonPredicate *)predicate;
+    if (comparisonPredicate.comparisonPredicateModifier != NSDirectPredicateModifier || comparisonPredicate.options != 0) {
+        return node;
+    }
+    NSExpression *keyExpression = comparisonPredicate.leftExpression;
+    NSExpression *valueExpression = comparisonPredicate.rightExpression;
+    NSPredicateOperatorType operatorType = comparisonPredicate.predicateOperatorType;
+    if (keyExpression.expressionType != NSKeyPathExpressionType) {
+        NSExpression *expression = keyExpression;
+        keyExpression = valueExpression;
+        valueExpression = expression;
+        operatorType = HKQueryReversedOperatorType(operatorType);
+        if (operatorType == NSInPredicateOperatorType || operatorType == NSBetweenPredicateOperatorType) {
+            return node;
+        }
+    }
+    if (keyExpression.expressionType != NSKeyPathExpressionType || valueExpression.expressionType != NSConstantValueExpressionType) {
+        return node;
+    }
+    const HKModelSlot *slot = [plan slotForKey:keyExpression.keyPath];
+    if (!slot || slot->type == HKModelSlotTypeUnsupported || slot->type == HKModelSlotTypeStruct) {
+        return node;
+    }
+    
+    id value = valueExpression.constantValue;
+    switch (operatorType) {
+        case NSEqualToPredicateOperatorType:
+        case NSNotEqualToPredicateOperatorType:
+        case NSLessThanPredicateOperatorType:
+        case NSLessThanOrEqualToPredicateOperatorType:
+        case NSGreaterThanPredicateOperatorType:
+        case NSGreaterThanOrEqualToPredicateOperatorType:
+            node->_value = value;
+            break;
+        case NSInPredicateOperatorType: {
+            if (![value conformsToProtocol:@protocol(NSFastEnumeration)] || [value isKindOfClass:NSString.class]) {
+                return node;
+            }
+            NSMutableSet *values = [NSMutableSet set];
+            for (id element in ([value isKindOfClass:NSDictionary.class] ? [value allValues] : value)) {
+                [values addObject:element];
+            }
+            node->_values = values;
+            break;
+        }
+        case NSBetweenPredicateOperatorType:
+            if (![value isKindOfClass:NSArray.class] || [value count] != 2) {
+                return node;
+            }
+            node->_value = [value[0] isKindOfClass:NSExpression.class] ? [value[0] constantValue] : value[0];
+            node->_upperValue = [value[1] isKindOfClass:NSExpression.class] ? [value[1] constantValue] : value[1];
+            break;
+        default:
+            return node;
+    }
+    
+    node->_kind = HKQueryNodeKindComparison;
+    node->_slot = slot;
+    node->_operatorType = operatorType;
+    
+    // number property and number constant are compared without boxing
+    if (HKModelSlotTypeIsNumber(slot->type) && operatorType != NSInPredicateOperatorType && [node->_value isKindOfClass:NSNumber.class] &&
+        (operatorType != NSBetweenPredicateOperatorType || [node->_upperValue isKindOfClass:NSNumber.class])) {
+        BOOL isIntegral = HKQueryIsIntegral(node->_value) && (!node->_upperValue || HKQueryIsIntegral(node->_upperValue));
+        BOOL isNonNegative = [node->_value compare:@0] != NSOrderedAscending && (!node->_upperValue || [node->_upperValue compare:@0] != NSOrderedAscending);
+        BOOL isUnsignedSlot = slot->type == HKModelSlotTypeUnsignedLong || slot->type == HKModelSlotTypeUnsignedLongLong;
+        node->_isNumber = YES;
+        // 64-bit unsigned values are compared as unsigned long long (not exact in double)
+        node->_isUnsigned = isUnsignedSlot && isIntegral && isNonNegative;
+        node->_isReal = !node->_isUnsigned && (slot->type == HKModelSlotTypeFloat || slot->type == HKModelSlotTypeDouble || isUnsignedSlot || !isIntegral);
+        node->_integer = [node->_value longLongValue];
+        node->_real = [node->_value doubleValue];
+        node->_unsignedInteger = [node->_value unsignedLongLongValue];
+        node->_upperInteger = [node->_upperValue longLongValue];
+        node->_upperReal = [node->_upperValue doubleValue];
+        node->_upperUnsignedInteger = [node->_upperValue unsignedLongLongValue];
+    }
+    return node;
+}
+
+#define HKQueryCompare(lhs, rhs) ((lhs) < (rhs) ? NSOrderedAscending : ((lhs) > (rhs) ? NSOrderedDescending : NSOrderedSame))
+
+static BOOL HKQueryMatchesOrder(NSPredicateOperatorType operatorType, NSComparisonResult order) {
+    switch (operatorType) {
+        case NSEqualToPredicateOperatorType:                return order == NSOrderedSame;
+        case NSNotEqualToPredicateOperatorType:             return order != NSOrderedSame;
+        case NSLessThanPredicateOperatorType:               return order == NSOrderedAscending;
+        case NSLessThanOrEqualToPredicateOperatorType:      return order != NSOrderedDescending;
+        case NSGreaterThanPredicateOperatorType:            return order == NSOrderedDescending;
+        case NSGreaterThanOrEqualToPredicateOperatorType:   return order != NSOrderedAscending;
+        default:                                            return NO;
+    }
+}
+
+static BOOL HKQueryEvaluate(HKQueryNode *node, id model) {
+    switch (node->_kind) {
+        case HKQueryNodeKindAnd:
+            for (HKQueryNode *child in node->_children) {
+                if (!HKQueryEvaluate(child, model)) {
+                    return NO;
+                }
+            }
+            return YES;
+        case HKQueryNodeKindOr:
+            for (HKQueryNode *child in node->_children) {
+                if (HKQueryEvaluate(child, model)) {
+                    return YES;
+                }
+            }
+            return NO;
+        case HKQueryNodeKindNot:
+            return !HKQueryEvaluate(node->_children.firstObject, model);
+        case HKQueryNodeKindPredicate:
+            return [node->_predicate evaluateWithObject:model];
+        case HKQueryNodeKindComparison:
+            break;
+    }
+    
+    const HKModelSlot *slot = node->_slot;
+    NSPredicateOperatorType operatorType = node->_operatorType;
+    if (node->_isNumber) {
+        if (node->_isUnsigned) {
+            unsigned long long value = HKModelSlotGetUnsignedLongLong(model, slot);
+            if (operatorType == NSBetweenPredicateOperatorType) {
+                return value >= node->_unsignedInteger && value <= node->_upperUnsignedInteger;
+            }
+            return HKQueryMatchesOrder(operatorType, HKQueryCompare(value, node->_unsignedInteger));
+        } else if (node->_isReal) {
+            double value = HKModelSlotGetDouble(model, slot);
+            if (operatorType == NSBetweenPredicateOperatorType) {
+                return value >= node->_real && value <= node->_upperReal;
+            }
+            return HKQueryMatchesOrder(operatorType, HKQueryCompare(value, node->_real));
+        } else {
+            long long value = HKModelSlotGetLongLong(model, slot);
+            if (operatorType == NSBetweenPredicateOperatorType) {
+                return value >= node->_integer && value <= node->_upperInteger;
+            }
+            return HKQueryMatchesOrder(operatorType, HKQueryCompare(value, node->_integer));
+        }
+    }
+    
+    id value = HKQueryGetObject(model, slot);
+    switch (operatorType) {
+        case NSEqualToPredicateOperatorType:
+            return value == node->_value || [value isEqual:node->_value];
+        case NSNotEqualToPredicateOperatorType:
+            return !(value == node->_value || [value isEqual:node->_value]);
+        case NSInPredicateOperatorType:
+            return [node->_values containsObject:value ?: NSNull.null];
+        case NSBetweenPredicateOperatorType:
+            return value && node->_value && node->_upperValue && [value compare:node->_value] != NSOrderedAscending && [value compare:node->_upperValue] != NSOrderedDescending;
+        default:
+            return value && node->_value && HKQueryMatchesOrder(operatorType, [value compare:node->_value]);
+    }
+}
+
+// candidate indexes by secondary index (nil if node can not use index)
+static NSIndexSet *HKQueryCandidates(HKQueryNode *node, NSDictionary<NSString *, NSArray<HKModelIndex *> *> *indexesByKey) {
+    switch (node->_kind) {
+        case HKQueryNodeKindAnd: {
+            NSMutableIndexSet *result = nil;
+            for (HKQueryNode *child in node->_children) {
+                NSIndexSet *candidates = HKQueryCandidates(child, indexesByKey);
+                if (!candidates) {
+                    continue;
+                } else if (!result) {
+                    result = [candidates mutableCopy];
+                } else {
+                    [result removeIndexes:[result indexesPassingTest:^BOOL(NSUInteger index, BOOL *stop) {
+                        return ![candidates containsIndex:index];
+                    }]];
+                }
+            }
+            return result;
+        }
+        case HKQueryNodeKindOr: {
+            NSMutableIndexSet *result = [NSMutableIndexSet indexSet];
+            for (HKQueryNode *child in node->_children) {
+                NSIndexSet *candidates = HKQueryCandidates(child, indexesByKey);
+                if (!candidates) {
+                    return nil;
+                }
+                [result addIndexes:candidates];
+            }
+            return result;
+        }
+        case HKQueryNodeKindNot:
+        case HKQueryNodeKindPredicate:
+            return nil;
+        case HKQueryNodeKindComparison:
+            break;
+    }
+    
+    HKModelIndex *hashIndex = nil;
+    HKModelIndex *rangeIndex = nil;
+    for (HKModelIndex *index in indexesByKey[node->_slot->key]) {
+        index.type == HKModelIndexTypeHash ? (hashIndex = hashIndex ?: index) : (rangeIndex = rangeIndex ?: index);
+    }
+    HKModelIndex *equalityIndex = hashIndex ?: rangeIndex;
+    switch (node->_operatorType) {
+        case NSEqualToPredicateOperatorType:
+            return [equalityIndex indexesOfValue:node->_value];
+        case NSInPredicateOperatorType: {
+            if (!equalityIndex) {
+                return nil;
+            }
+            NSMutableIndexSet *result = [NSMutableIndexSet indexSet];
+            for (id value in node->_values) {
+                [result addIndexes:[equalityIndex indexesOfValue:value == NSNull.null ? nil : value]];
+            }
+            return result;
+        }
+        case NSLessThanPredicateOperatorType:
+        case NSLessThanOrEqualToPredicateOperatorType:
+            return node->_value ? [rangeIndex indexesOfValuesFrom:nil inclusive:NO to:node->_value inclusive:node->_operatorType == NSLessThanOrEqualToPredicateOperatorType] : nil;
+        case NSGreaterThanPredicateOperatorType:
+        case NSGreaterThanOrEqualToPredicateOperatorType:
+            return node->_value ? [rangeIndex indexesOfValuesFrom:node->_value inclusive:node->_operatorType == NSGreaterThanOrEqualToPredicateOperatorType to:nil inclusive:NO] : nil;
+        case NSBetweenPredicateOperatorType:
+            return node->_value && node->_upperValue ? [rangeIndex indexesOfValuesFrom:node->_value inclusive:YES to:node->_upperValue inclusive:YES] : nil;
+        default:
+            return nil;
+    }
+}
+
+#pragma mark - query
+@interface HKModelQuery () {
+    HKQueryNode *_root;
+}
+
+- (instancetype)HK_initWithPredicate:(NSPredicate *)predicate modelClass:(Class)modelClass;
+
+@end
+
+@implementation HKModelQuery
+
++ (instancetype)queryWithPredicate:(NSPredicate *)predicate modelClass:(Class)modelClass {
+    return [[self alloc] HK_initWithPredicate:predicate modelClass:modelClass];
+}
+
+- (instancetype)HK_initWithPredicate:(NSPredicate *)predicate modelClass:(Class)modelClass {
+    self = [super init];
+    if (self) {
+        _predicate = [predicate copy];
+        _modelClass = modelClass;
+        _root = HKQueryCompile(_predicate, [HKModelPlan planWithClass:modelClass]);
+    }
+    return self;
+}
+
+- (BOOL)evaluateWithModel:(id)model {
+    return HKQueryEvaluate(_root, model);
+}
+
+- (NSIndexSet *)indexesInArray:(NSArray *)models usingIndexes:(NSArray<HKModelIndex *> *)indexes {
+    NSMutableDictionary<NSString *, NSMutableArray<HKModelIndex *> *> *indexesByKey = [NSMutableDictionary dictionaryWithCapacity:indexes.count];
+    for (HKModelIndex *index in indexes) {
+        if ([index HK_isValidForModels:models]) {
+            NSMutableArray<HKModelIndex *> *keyIndexes = indexesByKey[index.key] ?: (indexesByKey[index.key] = [NSMutableArray array]);
+            [keyIndexes addObject:index];
+        }
+    }
+    
+    // candidates of index are evaluated again for other conditions
+    HKQueryNode *root = _root;
+    NSIndexSet *candidates = indexesByKey.count ? HKQueryCandidates(root, indexesByKey) : nil;
+    if (candidates) {
+        return [candidates indexesPassingTest:^BOOL(NSUInteger index, BOOL *stop) {
+            return HKQueryEvaluate(root, models[index]);
+        }];
+    }
+    return [models indexesOfObjectsPassingTest:^BOOL(id model, NSUInteger index, BOOL *stop) {
+        return HKQueryEvaluate(root, model);
+    }];
+}
+
+- (NSArray *)filteredArray:(NSArray *)models {
+    return [self filteredArray:models usingIndexes:nil];
+}
+
+- (NSArray *)filteredArray:(NSArray *)models usingIndexes:(NSArray<HKModelIndex *> *)indexes {
+    return [models objectsAtIndexes:[self indexesInArray:models usingIndexes:indexes]];
+}
+
+@end
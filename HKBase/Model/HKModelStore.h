@@ -0,0 +1,78 @@
+//
+//  HKModelStore.h
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "HKModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ read only store of models in file (memory mapped)
+ models are archived by HKModelArchiver with one shared schema, and decoded by index on access
+ strings and data of decoded models refer to mapped file without copy
+ */
+@interface HKModelStore<ObjectType : HKModel *> : NSObject
+
+/**
+ write models to file (replaced atomically)
+
+ @param models models for store
+ @param path file path
+ @param error error (in NSPOSIXErrorDomain)
+ @return YES if succeeded
+ */
++ (BOOL)writeModels:(NSArray<ObjectType> *)models toFile:(NSString *)path error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ open store by mapping file
+
+ @param path file path written by +writeModels:toFile:error:
+ @param modelClass class of models (used when archived class does not exist)
+ @param error error (in NSPOSIXErrorDomain or HKModelArchiveErrorDomain)
+ @return store
+ */
++ (nullable instancetype)storeWithContentsOfFile:(NSString *)path modelClass:(Class)modelClass error:(NSError * _Nullable * _Nullable)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ class of models
+ */
+@property (nonatomic, unsafe_unretained, readonly) Class modelClass;
+/**
+ number of models
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ decode model at index (new instance for each call)
+
+ @param index index of model
+ @return model, nil if record is invalid
+ */
+- (nullable ObjectType)modelAtIndex:(NSUInteger)index;
+- (nullable ObjectType)objectAtIndexedSubscript:(NSUInteger)index;
+
+@end
+
+NS_ASSUME_NONNULL_END
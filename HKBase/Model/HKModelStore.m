@@ -0,0 +1,222 @@
+//
+//  HKModelStore.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "HKModelStore.h"
+#import "HKModelArchiver.h"
+
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+
+static const uint8_t kHKModelStoreMagic[4] = { 'H', 'K', 'M', 'S' };
+static const uint32_t kHKModelStoreVersion = 1;
+static const NSUInteger kHKModelStoreFlushLength = 1024 * 1024;
+
+/**
+ header of store file (little endian)
+ records are followed by schema of HKModelArchiver and offsets of records (count + 1)
+ */
+typedef struct _HKModelStoreHeader {
+    uint8_t magic[4];
+    uint32_t version;
+    uint64_t count;
+    uint64_t schemaOffset;
+    uint64_t indexOffset;
+} HKModelStoreHeader;
+
+@interface HKModelStore () {
+    NSData *_mappedData;
+    uint64_t _schemaOffset;     // end of records
+    const uint8_t *_index;
+    HKModelUnarchiver *_unarchiver;
+}
+
+- (instancetype)HK_initWithMappedData:(NSData *)mappedData modelClass:(Class)modelClass error:(NSError **)error;
+
+@end
+
+static BOOL HKModelStoreWrite(int fd, const void *bytes, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, bytes, length);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        } else if (written <= 0) {
+            return NO;
+        }
+        bytes = (const uint8_t *)bytes + written;
+        length -= (size_t)written;
+    }
+    return YES;
+}
+
+static NSError *HKModelStorePOSIXError(void) {
+    return [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+}
+
+static NSError *HKModelStoreInvalidError(void) {
+    return [NSError errorWithDomain:HKModelArchiveErrorDomain code:HKModelArchiveErrorInvalidHeader userInfo:@{ NSLocalizedDescriptionKey : @"invalid model store" }];
+}
+
+@implementation HKModelStore
+
++ (BOOL)writeModels:(NSArray *)models toFile:(NSString *)path error:(NSError * _Nullable __autoreleasing *)error {
+    NSString *temporaryPath = [path stringByAppendingFormat:@".%@", NSUUID.UUID.UUIDString];
+    int fd = open(temporaryPath.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        error ? *error = HKModelStorePOSIXError() : nil;
+        return NO;
+    }
+    
+    HKModelStoreHeader header = { { 0 } };
+    uint64_t *offsets = malloc((models.count + 1) * sizeof(uint64_t));
+    uint64_t flushedLength = sizeof(header);
+    BOOL isSucceeded = lseek(fd, sizeof(header), SEEK_SET) >= 0;
+    
+    HKModelArchiver *archiver = [[HKModelArchiver alloc] init];
+    offsets[0] = CFSwapInt64HostToLittle(flushedLength);
+    for (NSUInteger index = 0; index < models.count && isSucceeded; index++) {
+        @autoreleasepool {
+            [archiver encodeObject:models[index]];
+            offsets[index + 1] = CFSwapInt64HostToLittle(flushedLength + archiver.encodedLength);
+            if (archiver.encodedLength >= kHKModelStoreFlushLength || index + 1 == models.count) {
+                NSData *encodedData = archiver.encodedData;
+                isSucceeded = HKModelStoreWrite(fd, encodedData.bytes, encodedData.length);
+                flushedLength += encodedData.length;
+                [archiver resetEncodedData];
+            }
+        }
+    }
+    
+    NSData *schemaData = archiver.schemaData;
+    header.count = CFSwapInt64HostToLittle(models.count);
+    header.schemaOffset = CFSwapInt64HostToLittle(flushedLength);
+    header.indexOffset = CFSwapInt64HostToLittle(flushedLength + schemaData.length);
+    memcpy(header.magic, kHKModelStoreMagic, sizeof(header.magic));
+    header.version = CFSwapInt32HostToLittle(kHKModelStoreVersion);
+    
+    isSucceeded = isSucceeded && HKModelStoreWrite(fd, schemaData.bytes, schemaData.length);
+    isSucceeded = isSucceeded && HKModelStoreWrite(fd, offsets, (models.count + 1) * sizeof(uint64_t));
+    isSucceeded = isSucceeded && pwrite(fd, &header, sizeof(header), 0) == sizeof(header);
+    isSucceeded = isSucceeded && fsync(fd) == 0;
+    NSError *result = isSucceeded ? nil : HKModelStorePOSIXError();
+    free(offsets);
+    close(fd);
+    
+    if (isSucceeded && rename(temporaryPath.fileSystemRepresentation, path.fileSystemRepresentation) != 0) {
+        result = HKModelStorePOSIXError();
+        isSucceeded = NO;
+    }
+    if (!isSucceeded) {
+        unlink(temporaryPath.fileSystemRepresentation);
+        error ? *error = result : nil;
+    }
+    return isSucceeded;
+}
+
++ (instancetype)storeWithContentsOfFile:(NSString *)path modelClass:(Class)modelClass error:(NSError * _Nullable __autoreleasing *)error {
+    int fd = open(path.fileSystemRepresentation, O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0) {
+        error ? *error = HKModelStorePOSIXError() : nil;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return nil;
+    } else if ((uint64_t)status.st_size < sizeof(HKModelStoreHeader)) {
+        error ? *error = HKModelStoreInvalidError() : nil;
+        close(fd);
+        return nil;
+    }
+    
+    size_t length = (size_t)status.st_size;
+    void *bytes = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    NSError *mapError = bytes == MAP_FAILED ? HKModelStorePOSIXError() : nil;
+    close(fd);
+    if (mapError) {
+        error ? *error = mapError : nil;
+        return nil;
+    }
+    
+    // mapping is unmapped when store and all no-copy strings and data are released
+    NSData *mappedData = [[NSData alloc] initWithBytesNoCopy:bytes length:length deallocator:^(void *bytes, NSUInteger length) {
+        munmap(bytes, length);
+    }];
+    return [[self alloc] HK_initWithMappedData:mappedData modelClass:modelClass error:error];
+}
+
+- (id)modelAtIndex:(NSUInteger)index {
+    if (index >= _count) {
+        return nil;
+    }
+    
+    uint64_t offsets[2];
+    memcpy(offsets, _index + index * sizeof(uint64_t), sizeof(offsets));
+    uint64_t start = CFSwapInt64LittleToHost(offsets[0]);
+    uint64_t end = CFSwapInt64LittleToHost(offsets[1]);
+    if (start < sizeof(HKModelStoreHeader) || start > end || end > _schemaOffset) {
+        return nil;
+    }
+    
+    const uint8_t *bytes = _mappedData.bytes;
+    id result = [_unarchiver decodeObjectOfClass:_modelClass bytes:bytes + start length:(NSUInteger)(end - start) error:NULL];
+    return [result isKindOfClass:_modelClass] ? result : nil;
+}
+
+- (id)objectAtIndexedSubscript:(NSUInteger)index {
+    return [self modelAtIndex:index];
+}
+
+#pragma mark - private methods
+- (instancetype)HK_initWithMappedData:(NSData *)mappedData modelClass:(Class)modelClass error:(NSError **)error {
+    self = [super init];
+    if (self) {
+        HKModelStoreHeader header;
+        memcpy(&header, mappedData.bytes, sizeof(header));
+        uint64_t count = CFSwapInt64LittleToHost(header.count);
+        uint64_t schemaOffset = CFSwapInt64LittleToHost(header.schemaOffset);
+        uint64_t indexOffset = CFSwapInt64LittleToHost(header.indexOffset);
+        uint64_t length = mappedData.length;
+        
+        if (memcmp(header.magic, kHKModelStoreMagic, sizeof(header.magic)) != 0 || CFSwapInt32LittleToHost(header.version) != kHKModelStoreVersion ||
+            schemaOffset < sizeof(header) || schemaOffset > indexOffset || indexOffset > length || count >= (length - indexOffset) / sizeof(uint64_t)) {
+            error ? *error = HKModelStoreInvalidError() : nil;
+            return nil;
+        }
+        
+        const uint8_t *bytes = mappedData.bytes;
+        _unarchiver = [[HKModelUnarchiver alloc] initWithSchemaBytes:bytes + schemaOffset length:(NSUInteger)(indexOffset - schemaOffset) error:error];
+        if (!_unarchiver) {
+            return nil;
+        }
+        _unarchiver.referencedData = mappedData;
+        _mappedData = mappedData;
+        _modelClass = modelClass;
+        _count = (NSUInteger)count;
+        _schemaOffset = schemaOffset;
+        _index = bytes + indexOffset;
+    }
+    return self;
+}
+
+@end
@@ -23,6 +23,7 @@
 
 #import <Foundation/Foundation.h>
 #import "HKModel.h"
+#import "HKMacro.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -52,7 +53,7 @@ OBJC_EXTERN NSString *const kHKOptionEmptyStringValue;
 
 /**
  Option set Object Storage
- Do not use it immediacy
+ Do not use it directly
  */
 @property (class, nonatomic, readonly) __kindof HKOptionStorage *currentStorage;
 /**
@@ -167,6 +168,7 @@ OBJC_EXTERN NSString *const kHKOptionEmptyStringValue;
  */
 #define HKOptionDeclare(className, ...) \
 \
+HK_MACRO_ASSERT_COUNT(__VA_ARGS__) \
 @class className; \
 typedef className *className ## Ptr; \
 @interface className (className ## ClassProperty) \
@@ -190,9 +192,11 @@ typedef className *className ## Ptr; \
 @end \
 \
 @implementation className (className ## ClassProperty) \
-@dynamic __VA_ARGS__; \
-+ (void)load { \
-    [self.currentStorage registerOptionArguments:@#__VA_ARGS__]; \
+HK_MACRO_FOR_EACH(HKOptionClassAccessorImplementation, className, __VA_ARGS__) \
++ (const char *const *)HK_optionNamesWithCount:(NSUInteger *)count { \
+    static const char *const names[] = { HK_MACRO_FOR_EACH(HKOptionNameString, className, __VA_ARGS__) }; \
+    *count = sizeof(names) / sizeof(names[0]); \
+    return names; \
 } \
 + (__kindof HKOptionStorage *)currentStorage { \
     static className ## OptionStorage *currentStorage = nil; \
@@ -204,7 +208,7 @@ typedef className *className ## Ptr; \
 } \
 @end \
 @implementation className (className ## InstanceProperty) \
-@dynamic __VA_ARGS__; \
+HK_MACRO_FOR_EACH(HKOptionInstanceAccessorImplementation, className, __VA_ARGS__) \
 @end \
 \
 @implementation className ## OptionStorage \
@@ -225,14 +229,9 @@ typedef className *className ## Ptr; \
 #define HKOptionRegisterValues(className, ...) \
 \
 @implementation className (className ## Values) \
-+ (void)load { \
-    const NSInteger arguments[] = { __VA_ARGS__ }; \
-    const NSInteger numberOfArguments = sizeof(arguments) / sizeof(arguments[0]); \
-    NSMutableArray<NSNumber *> *values = [NSMutableArray arrayWithCapacity:numberOfArguments]; \
-    for (NSInteger index = 0; index < numberOfArguments; index++) { \
-        [values addObject:@(arguments[index])]; \
-    } \
-    [self.currentStorage registerValues:values]; \
++ (void)HK_optionValuesUsingBlock:(void (NS_NOESCAPE ^)(const NSInteger *values, NSUInteger count))block { \
+    const NSInteger values[] = { __VA_ARGS__ }; \
+    block(values, sizeof(values) / sizeof(values[0])); \
 } \
 @end
 
@@ -248,11 +247,49 @@ typedef className *className ## Ptr; \
 #define HKOptionRegisterStringValues(className, ...) \
 \
 @implementation className (className ## StringValues) \
-+ (void)load { \
-    [self.currentStorage registerStringValues:@[__VA_ARGS__]]; \
++ (NSArray<NSString *> *)HK_optionStringValues { \
+    return @[__VA_ARGS__]; \
 } \
 @end
 
+/**
+ class property of Option set in HKOptionImplementation(...)
+ Do not use it directly
+ */
+#define HKOptionClassAccessorImplementation(className, index, name) \
++ (className *)name { \
+    return [[self.currentStorage optionAtIndex:index] copy]; \
+}
+
+/**
+ instance property of Option set in HKOptionImplementation(...)
+ Do not use it directly
+ */
+#define HKOptionInstanceAccessorImplementation(className, index, name) \
+- (className *)name { \
+    return [self orWithOption:[self.class.currentStorage optionAtIndex:index]]; \
+}
+
+/**
+ name of Option set in HKOptionImplementation(...)
+ Do not use it directly
+ */
+#define HKOptionNameString(className, index, name) #name,
+
+/**
+ static tables of Option set class generated by HKOptionImplementation(...) and HKOptionRegister...(...)
+ storage reads them on first use (no +load)
+ Do not use it directly
+ */
+@protocol HKOptionStaticTable
+
+@optional
++ (const char *_Nonnull const *_Nonnull)HK_optionNamesWithCount:(NSUInteger *)count;
++ (void)HK_optionValuesUsingBlock:(void (NS_NOESCAPE ^)(const NSInteger *values, NSUInteger count))block;
++ (NSArray<NSString *> *)HK_optionStringValues;
+
+@end
+
 @interface HKOption (Unavailable)
 
 - (instancetype)init NS_UNAVAILABLE;
@@ -261,7 +298,7 @@ typedef className *className ## Ptr; \
 
 /**
  Option set Storage
- Do not use it immediacy
+ Do not use it directly
  */
 @interface HKOptionStorage : NSObject
 
@@ -274,6 +311,7 @@ typedef className *className ## Ptr; \
 - (void)registerValues:(NSArray<NSNumber *> *)values;
 - (void)registerStringValues:(NSArray<NSString *> *)stringValues;
 
+- (__kindof HKOption *)optionAtIndex:(NSUInteger)index;
 - (nullable __kindof HKOption *)optionForKey:(NSString *)key;
 - (nullable __kindof HKOption *)optionForValue:(NSInteger)value;
 - (nullable __kindof HKOption *)optionForStringValue:(NSString *)stringValue;
@@ -26,12 +26,17 @@
 #import "HKProperty.h"
 #import "HKMethod.h"
 
+#import <objc/runtime.h>
+
 NSString *const kHKOptionEmptyStringValue = @"Empty";
 
+static const NSUInteger kHKOptionHashMultiplier = (NSUInteger)0x9E3779B97F4A7C15ULL;
+
 @interface HKOption () {
     @package
     NSInteger _value;
     NSString *_stringValue;
+    NSUInteger _classSeed;      // hash of class name (HKOptionStorage.classSeed)
 }
 
 + (void)HK_initializeClassPropertyWithName:(NSString *)name;
@@ -40,7 +45,8 @@ NSString *const kHKOptionEmptyStringValue = @"Empty";
 @end
 
 @interface HKOptionStorage () {
-    NSMutableDictionary<NSString *, __kindof HKOption *> *_allOptions;
+    NSArray<__kindof HKOption *> *_allOptions;         // options of keys by index (immutable after registration)
+    NSDictionary<NSString *, NSNumber *> *_indexes;     // index by key
     
     NSArray<NSString *> *_allKeys;
     NSArray<NSNumber *> *_allValues;
@@ -50,8 +56,10 @@ NSString *const kHKOptionEmptyStringValue = @"Empty";
 }
 
 @property (nonatomic, readonly) __kindof HKOption *Empty;
+@property (nonatomic, readonly) NSUInteger classSeed;
 
-- (__kindof HKOption *)HK_makeOptionForKey:(NSString *)key;
+- (void)HK_registerStaticTables;
+- (void)HK_materializeOptions;
 - (NSArray<HKOption *> *)HK_optionsForValue:(NSInteger)value;
 - (NSString *)HK_stringValueForValue:(NSInteger)value;
 
@@ -117,9 +125,10 @@ NSString *const kHKOptionEmptyStringValue = @"Empty";
 - (instancetype)initWithCoder:(NSCoder *)decoder {
     self = [super init];
     if (self) {
-        NSInteger value = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(value))];
-        __kindof HKOption *base = [self.class.currentStorage optionForValue:value];
-        [self HK_initializeByBase:base];
+        HKOptionStorage *storage = self.class.currentStorage;
+        _value = [decoder decodeIntegerForKey:NSStringFromSelector(@selector(value))];
+        _stringValue = [storage HK_stringValueForValue:_value];
+        _classSeed = storage.classSeed;
     }
     return self;
 }
@@ -139,6 +148,7 @@ NSString *const kHKOptionEmptyStringValue = @"Empty";
     HKOption *result = [[self.class alloc] init];
     result->_value = _value;
     result->_stringValue = _stringValue;
+    result->_classSeed = _classSeed;
     [result HK_initializeByBase:self];
     return result;
 }
@@ -148,11 +158,11 @@ NSString *const kHKOptionEmptyStringValue = @"Empty";
 @dynamic Reverse;
 
 - (NSUInteger)hash {
-    return NSStringFromClass(self.class).hash + _value;
+    return _classSeed ^ ((NSUInteger)_value * kHKOptionHashMultiplier);
 }
 
 - (BOOL)isEqual:(__kindof HKOption *)object {
-    return self.hash == object.hash;
+    return self == object || (object && object_getClass(object) == object_getClass(self) && _value == ((HKOption *)object)->_value);
 }
 
 - (__kindof HKOption *)Reverse {
@@ -162,6 +172,7 @@ NSString *const kHKOptionEmptyStringValue = @"Empty";
     
     result->_value = value;
     result->_stringValue = stringValue;
+    result->_classSeed = _classSeed;
     
     return result;
 }
@@ -169,7 +180,8 @@ NSString *const kHKOptionEmptyStringValue = @"Empty";
 #pragma mark - public methods
 
 - (NSComparisonResult)compare:(__kindof HKOption *)other {
-    return [@(_value) compare:@(other.value)];
+    NSInteger otherValue = other ? ((HKOption *)other)->_value : 0;
+    return _value < otherValue ? NSOrderedAscending : (_value > otherValue ? NSOrderedDescending : NSOrderedSame);
 }
 
 - (__kindof HKOption *)orWithOption:(__kindof HKOption *)option {
@@ -244,31 +256,42 @@ static NSArray<NSString *> *HKGetComponents(NSString *string) {
 
 @dynamic sharedStorage;
 
+// static tables of HKOptionImplementation(...) are registered once by currentStorage (first use of option class)
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _classSeed = NSStringFromClass(self.optionClass).hash;
+        [self HK_registerStaticTables];
+    }
+    return self;
+}
+
+// options are materialized and changed only in registration, then read without lock
 - (void)registerOptionArguments:(NSString *)arguments {
     _allKeys = [HKGetComponents(arguments) copy];
     for (NSString *key in _allKeys) {
         [self.optionClass HK_initializeClassPropertyWithName:key];
     }
+    [self HK_materializeOptions];
 }
 
 - (void)registerValues:(NSArray<NSNumber *> *)values {
     _allValues = [values copy];
+    [self HK_materializeOptions];
 }
 
 - (void)registerStringValues:(NSArray<NSString *> *)stringValues {
     _allStringValues = [stringValues copy];
+    [self HK_materializeOptions];
+}
+
+- (__kindof HKOption *)optionAtIndex:(NSUInteger)index {
+    return _allOptions[index];
 }
 
 - (nullable __kindof HKOption *)optionForKey:(NSString *)key {
-    if (!_allOptions) {
-        _allOptions = [NSMutableDictionary dictionaryWithCapacity:_allKeys.count];
-    }
-    __kindof HKOption *result = _allOptions[key];
-    if (!result) {
-        result = [self HK_makeOptionForKey:key];
-        _allOptions[key] = result;
-    }
-    return [result copy];
+    NSNumber *index = _indexes[key];
+    return index ? [_allOptions[index.unsignedIntegerValue] copy] : nil;
 }
 
 - (nullable __kindof HKOption *)optionForValue:(NSInteger)value {
@@ -284,9 +307,9 @@ static NSArray<NSString *> *HKGetComponents(NSString *string) {
     __kindof HKOption *result = nil;
     NSArray<NSString *> *components = [stringValue componentsSeparatedByString:@"."];
     NSArray<NSString *> *allStringValues = _allStringValues ?: _allKeys;
-    for (NSInteger index = 0; index < allStringValues.count; index++) {
+    for (NSInteger index = 0; index < allStringValues.count && index < _allOptions.count; index++) {
         if ([components containsObject:allStringValues[index]]) {
-            HKOption *option = [self optionForKey:_allKeys[index]];
+            HKOption *option = _allOptions[index];
             result = result ? [result orWithOption:option] : option;
         }
     }
@@ -304,36 +327,75 @@ static NSArray<NSString *> *HKGetComponents(NSString *string) {
 }
 
 - (NSArray<__kindof HKOption *> *)allOptions {
-    NSMutableArray<__kindof HKOption *> *result = [NSMutableArray arrayWithCapacity:_allKeys.count];
-    for (NSString *key in _allKeys) {
-        [result addObject:[self optionForKey:key]];
-    }
-    return result;
+    return [[NSArray alloc] initWithArray:_allOptions ?: @[] copyItems:YES];
 }
 
 - (__kindof HKOption *)Empty {
-    if (!_emptyOption) {
-        _emptyOption = [[self.optionClass alloc] init];
-        _emptyOption->_stringValue = kHKOptionEmptyStringValue;
-    }
     return _emptyOption;
 }
 
 #pragma mark - private methods
 
-- (nullable __kindof HKOption *)HK_makeOptionForKey:(NSString *)key {
-    NSInteger index = [_allKeys indexOfObject:key];
+- (void)HK_registerStaticTables {
+    Class optionClass = self.optionClass;
+    NSUInteger count = 0;
+    if (![optionClass respondsToSelector:@selector(HK_optionNamesWithCount:)]) {
+        [self HK_materializeOptions];
+        return;
+    }
     
-    __kindof HKOption *result = [[self.optionClass alloc] init];
-    result->_value = _allValues ? _allValues[index].integerValue : 1 << index;
-    result->_stringValue = _allStringValues ? [_allStringValues[index] copy] : [key copy];
-    return result;
+    const char *const *names = [(Class<HKOptionStaticTable>)optionClass HK_optionNamesWithCount:&count];
+    NSMutableArray<NSString *> *keys = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [keys addObject:@(names[index])];
+    }
+    _allKeys = [keys copy];
+    
+    if ([optionClass respondsToSelector:@selector(HK_optionValuesUsingBlock:)]) {
+        __block NSArray<NSNumber *> *allValues = nil;
+        [(Class<HKOptionStaticTable>)optionClass HK_optionValuesUsingBlock:^(const NSInteger *values, NSUInteger numberOfValues) {
+            NSMutableArray<NSNumber *> *numbers = [NSMutableArray arrayWithCapacity:numberOfValues];
+            for (NSUInteger index = 0; index < numberOfValues; index++) {
+                [numbers addObject:@(values[index])];
+            }
+            allValues = [numbers copy];
+        }];
+        _allValues = allValues;
+    }
+    if ([optionClass respondsToSelector:@selector(HK_optionStringValues)]) {
+        _allStringValues = [[(Class<HKOptionStaticTable>)optionClass HK_optionStringValues] copy];
+    }
+    
+    [self HK_materializeOptions];
+}
+
+// options of keys and empty option (registration order of keys, values and string values is not fixed)
+- (void)HK_materializeOptions {
+    NSMutableArray<__kindof HKOption *> *allOptions = [NSMutableArray arrayWithCapacity:_allKeys.count];
+    NSMutableDictionary<NSString *, NSNumber *> *indexes = [NSMutableDictionary dictionaryWithCapacity:_allKeys.count];
+    for (NSUInteger index = 0; index < _allKeys.count; index++) {
+        __kindof HKOption *result = [[self.optionClass alloc] init];
+        result->_value = _allValues && index < _allValues.count ? _allValues[index].integerValue : 1 << index;
+        result->_stringValue = _allStringValues && index < _allStringValues.count ? [_allStringValues[index] copy] : [_allKeys[index] copy];
+        result->_classSeed = _classSeed;
+        [allOptions addObject:result];
+        indexes[_allKeys[index]] = @(index);
+    }
+    _allOptions = [allOptions copy];
+    _indexes = [indexes copy];
+    
+    if (!_emptyOption) {
+        _emptyOption = [[self.optionClass alloc] init];
+        _emptyOption->_stringValue = kHKOptionEmptyStringValue;
+        _emptyOption->_classSeed = _classSeed;
+    }
 }
 
 - (NSArray<HKOption *> *)HK_optionsForValue:(NSInteger)value {
     NSMutableArray<__kindof HKOption *> *result = [NSMutableArray arrayWithCapacity:_allKeys.count];
     if (value) {
-        for (HKOption *option in self.allOptions) {
+        // shared options are read only (allOptions copies them for callers)
+        for (HKOption *option in _allOptions) {
             if ((value & option.value) == option.value) {
                 [result addObject:option];
             }
@@ -343,7 +405,14 @@ static NSArray<NSString *> *HKGetComponents(NSString *string) {
 }
 
 - (NSString *)HK_stringValueForValue:(NSInteger)value {
-    NSArray<NSString *> *result = [[self HK_optionsForValue:value] valueForKeyPath:@"stringValue"];
+    NSArray<HKOption *> *options = [self HK_optionsForValue:value];
+    if (options.count == 1) {
+        return options.firstObject.stringValue;
+    }
+    NSMutableArray<NSString *> *result = [NSMutableArray arrayWithCapacity:options.count];
+    for (HKOption *option in options) {
+        [result addObject:option.stringValue];
+    }
     return [result componentsJoinedByString:@"."];
 }
 
@@ -26,3 +26,17 @@
 #import "HKArray.h"
 #import "HKEnum.h"
 #import "HKOption.h"
+#import "HKModel+JSON.h"
+#import "HKModelArchiver.h"
+#import "HKModelStore.h"
+#import "HKModelDecodeContext.h"
+#import "HKModelColumns.h"
+#import "HKModelQuery.h"
+#import "HKJSONStreamDecoder.h"
+#import "HKModelPool.h"
+#import "HKModelDecodeSession.h"
+#import "HKModelNumber.h"
+#import "HKModelDate.h"
+#import "HKModelBase64.h"
+#import "HKEnumSwitch.h"
+#import "HKMacro.h"
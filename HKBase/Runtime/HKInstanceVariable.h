@@ -39,6 +39,10 @@ NS_ASSUME_NONNULL_BEGIN
  instance variable's objCType
  */
 @property (nonatomic, readonly) const char *objCType;
+/**
+ instance variable's offset in object (cf. ivar_getOffset)
+ */
+@property (nonatomic, readonly) ptrdiff_t offset;
 
 /**
  class's instance variable of name
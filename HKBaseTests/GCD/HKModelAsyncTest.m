@@ -0,0 +1,61 @@
+//
+//  HKModelAsyncTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKModelAsyncTest : XCTestCase
+
+@end
+
+@implementation HKModelAsyncTest
+
+- (void)testDecodeCardsAsync {
+    HKDispatchSemaphore *semaphore = [HKDispatchSemaphore semaphoreWithValue:0];
+    HKDispatchQueue *queue = [HKDispatchQueue queueWithName:nil];
+    HKDispatchQueue *completionQueue = [HKDispatchQueue queueWithName:nil];
+    
+    __block HKCardResponse *response = nil;
+    NSProgress *progress = [HKCardResponse decodeJSONDataAsync:HKCardResponse.fixtureJSONData onQueue:queue completionQueue:completionQueue completion:^(HKCardResponse *model, NSError *error) {
+        response = model;
+        [semaphore signal];
+    }];
+    [semaphore waitWithTimeout:5.0];
+    XCTAssertTrue(response.header.success, @"asynchronous decoding failed");
+    XCTAssertEqual(progress.fractionCompleted, 1.0, @"progress is not completed");
+    
+    __block NSError *cancelledError = nil;
+    [queue suspendDispatchQueue];
+    NSProgress *cancelledProgress = [HKCardResponse decodeAsync:HKCardResponse.fixtureJSON onQueue:queue completionQueue:completionQueue completion:^(HKCardResponse *model, NSError *error) {
+        cancelledError = error;
+        [semaphore signal];
+    }];
+    [cancelledProgress cancel];
+    [queue resumeDispatchQueue];
+    [semaphore waitWithTimeout:5.0];
+    XCTAssertEqual(cancelledError.code, NSUserCancelledError, @"cancelled decoding is not stopped");
+}
+
+@end
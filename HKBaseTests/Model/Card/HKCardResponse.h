@@ -32,4 +32,13 @@
 @property (nonatomic, strong) HKResponseHeader *header;
 @property (nonatomic, strong) HKArray(HKCard) *cards;
 
+/**
+ Cards.json in test bundle (loaded once)
+ */
+@property (class, nonatomic, readonly) NSData *fixtureJSONData;
+/**
+ serialized object of Cards.json
+ */
+@property (class, nonatomic, readonly) NSDictionary *fixtureJSON;
+
 @end
@@ -27,4 +27,23 @@
 
 @implementation HKCardResponse
 
++ (NSData *)fixtureJSONData {
+    static NSData *JSONData = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *path = [[NSBundle bundleForClass:HKCardResponse.class] pathForResource:@"Cards" ofType:@"json"];
+        JSONData = [NSData dataWithContentsOfFile:path];
+    });
+    return JSONData;
+}
+
++ (NSDictionary *)fixtureJSON {
+    static NSDictionary *JSON = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        JSON = [NSJSONSerialization JSONObjectWithData:self.fixtureJSONData options:(NSJSONReadingOptions)0 error:NULL];
+    });
+    return JSON;
+}
+
 @end
@@ -27,8 +27,70 @@
 #import <HKBase/HKBase.h>
 #import "HKCardResponse.h"
 
+@interface HKLazyCardResponse : HKCardResponse
+@end
+
+@implementation HKLazyCardResponse
+
++ (BOOL)isLazyMaterialization {
+    return YES;
+}
+
+@end
+
+@interface HKCustomCardResponse : HKCardResponse
+@property (nonatomic, readonly, getter=isCustomDecoded) BOOL customDecoded;
+@end
+
+@implementation HKCustomCardResponse {
+    BOOL _customDecoded;
+}
+
++ (instancetype)modelWithSerializedObject:(id)serializedObject {
+    HKCustomCardResponse *result = [super modelWithSerializedObject:serializedObject];
+    result->_customDecoded = YES;
+    return result;
+}
+
+- (BOOL)isCustomDecoded {
+    return _customDecoded;
+}
+
+@end
+
+@interface HKNestedCardResponse : HKModel
+@property (nonatomic, strong) HKLazyCardResponse *lazyResponse;
+@property (nonatomic, strong) HKCustomCardResponse *customResponse;
+@end
+
+@implementation HKNestedCardResponse
+@end
+
+@interface HKTrackingCardResponse : HKCardResponse
+@end
+
+@implementation HKTrackingCardResponse
+
++ (BOOL)isChangeTracking {
+    return YES;
+}
+
+@end
+
+@interface HKImmutableCard : HKCard
+@end
+
+@implementation HKImmutableCard
+
++ (BOOL)isImmutable {
+    return YES;
+}
+
+@end
+
 @interface HKCardTest : XCTestCase
 
+@property (nonatomic, strong) NSData *JSONData;
 @property (nonatomic, strong) NSDictionary *JSON;
 @property (nonatomic, strong) NSError *error;
 
@@ -44,11 +106,13 @@
     NSData *JSONData = [NSData dataWithContentsOfFile:path];
     NSDictionary *serializedObject = [NSJSONSerialization JSONObjectWithData:JSONData options:(NSJSONReadingOptions)0 error:&error];
     
+    self.JSONData = JSONData;
     self.JSON = serializedObject;
     self.error = error;
 }
 
 - (void)tearDown {
+    self.JSONData = nil;
     self.JSON = nil;
     self.error = nil;
     [super tearDown];
@@ -66,4 +130,116 @@
     XCTAssertTrue(masterCards.count == 2, @"filter master card count failed, master card count(%zd)", masterCards.count);
 }
 
+- (void)testCardsFromJSONData {
+    NSError *error = nil;
+    HKCardResponse *response = [HKCardResponse modelWithJSONData:self.JSONData error:&error];
+    XCTAssertNil(error, @"JSON decode fail: %@", error.localizedDescription);
+    
+    NSArray<HKCard *> *cards = response.header.success ? response.cards : nil;
+    XCTAssertTrue(cards.count == [self.JSON[@"cards"] count], @"cards count failed -> card count(%zd)", cards.count);
+    XCTAssertEqualObjects(response.serializedObject, [HKCardResponse modelWithSerializedObject:self.JSON].serializedObject, @"JSON decode is different from serialized object");
+    
+    const char *invalidJSON = "{\"cards\": [1, 2";
+    XCTAssertNil([HKCardResponse modelWithJSONBytes:invalidJSON length:strlen(invalidJSON) error:&error]);
+    XCTAssertEqual(error.code, HKJSONErrorUnexpectedEnd, @"invalid JSON error code failed -> %zd", error.code);
+}
+
+- (void)testCardsToJSONData {
+    HKCardResponse *response = [HKCardResponse modelWithSerializedObject:self.JSON];
+    NSData *JSONData = response.JSONData;
+    XCTAssertNotNil(JSONData, @"JSON encode fail");
+    
+    NSError *error = nil;
+    id serializedObject = [NSJSONSerialization JSONObjectWithData:JSONData options:(NSJSONReadingOptions)0 error:&error];
+    XCTAssertNil(error, @"encoded JSON is invalid: %@", error.localizedDescription);
+    XCTAssertEqualObjects(serializedObject, response.serializedObject, @"JSON encode is different from serialized object");
+    XCTAssertEqualObjects([HKCardResponse modelWithJSONData:JSONData error:NULL].JSONData, JSONData, @"JSON encode is not stable");
+}
+
+- (void)testCardsConcurrently {
+    NSUInteger threshold = HKArray.concurrentThreshold;
+    
+    HKArray.concurrentThreshold = 0;
+    HKCardResponse *serialResponse = [HKCardResponse modelWithSerializedObject:self.JSON];
+    id serialSerializedObject = serialResponse.serializedObject;
+    NSData *serialJSONData = serialResponse.JSONData;
+    
+    HKArray.concurrentThreshold = 1;
+    HKCardResponse *concurrentResponse = [HKCardResponse modelWithSerializedObject:self.JSON];
+    XCTAssertEqualObjects([concurrentResponse.cards valueForKey:@"number"], [serialResponse.cards valueForKey:@"number"], @"concurrent decode order failed");
+    XCTAssertEqualObjects(concurrentResponse.serializedObject, serialSerializedObject, @"concurrent encode failed");
+    XCTAssertEqualObjects(concurrentResponse.JSONData, serialJSONData, @"concurrent JSON encode failed");
+    
+    HKArray.concurrentThreshold = threshold;
+}
+
+- (void)testCardsLazily {
+    HKLazyCardResponse *response = [HKLazyCardResponse modelWithSerializedObject:self.JSON];
+    XCTAssertTrue(response.cards.count == [self.JSON[@"cards"] count], @"lazy cards count failed -> card count(%zd)", response.cards.count);
+    XCTAssertEqualObjects(response.serializedObject, [HKCardResponse modelWithSerializedObject:self.JSON].serializedObject, @"lazy materialization is different from serialized object");
+    
+    HKLazyCardResponse *modifiedResponse = [HKLazyCardResponse modelWithSerializedObject:self.JSON];
+    modifiedResponse.cards = nil;
+    [modifiedResponse materialize];
+    XCTAssertNil(modifiedResponse.cards, @"lazy materialization overwrites value set before access");
+    XCTAssertTrue(modifiedResponse.header.success, @"lazy materialization of header failed");
+}
+
+- (void)testCardsJSONNestedDecoding {
+    NSData *JSONData = [NSJSONSerialization dataWithJSONObject:@{ @"lazyResponse" : self.JSON, @"customResponse" : self.JSON } options:(NSJSONWritingOptions)0 error:NULL];
+    HKNestedCardResponse *response = [HKNestedCardResponse modelWithJSONData:JSONData error:NULL];
+    XCTAssertTrue(response.customResponse.isCustomDecoded, @"JSON decode skips +modelWithSerializedObject: override");
+    XCTAssertTrue(response.customResponse.cards.count == [self.JSON[@"cards"] count], @"custom cards count failed -> card count(%zd)", response.customResponse.cards.count);
+    XCTAssertTrue(response.lazyResponse.cards.count == [self.JSON[@"cards"] count], @"lazy cards count failed -> card count(%zd)", response.lazyResponse.cards.count);
+    XCTAssertEqualObjects(response.lazyResponse.serializedObject, [HKCardResponse modelWithSerializedObject:self.JSON].serializedObject, @"lazy JSON decode is different from serialized object");
+}
+
+- (void)testCardsCopy {
+    HKCardResponse *response = [HKCardResponse modelWithSerializedObject:self.JSON];
+    HKCardResponse *copiedResponse = [response copy];
+    XCTAssertEqualObjects(copiedResponse.serializedObject, response.serializedObject, @"copied response is different");
+    XCTAssertEqual(copiedResponse.cards, response.cards, @"strong property is not retained in copy");
+    
+    HKCardResponse *decodedResponse = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:response]];
+    XCTAssertEqualObjects(decodedResponse.serializedObject, response.serializedObject, @"decoded response is different");
+}
+
+- (void)testCardsChanges {
+    HKTrackingCardResponse *response = [HKTrackingCardResponse modelWithSerializedObject:self.JSON];
+    XCTAssertEqual(response.changedKeys.count, 0, @"decoded properties are recorded as changes");
+    XCTAssertNil(response.serializedDelta, @"delta of unchanged model is not nil");
+    
+    response.cards = nil;
+    XCTAssertEqualObjects(response.changedKeys, @[@"cards"], @"changed keys failed -> %@", response.changedKeys);
+    XCTAssertEqualObjects(response.serializedDelta, @{@"cards": NSNull.null}, @"delta failed -> %@", response.serializedDelta);
+    
+    HKTrackingCardResponse *patchedResponse = [HKTrackingCardResponse modelWithSerializedObject:self.JSON];
+    [patchedResponse applySerializedPatch:response.serializedDelta];
+    XCTAssertNil(patchedResponse.cards, @"patch is not applied");
+    XCTAssertTrue(patchedResponse.header.success, @"patch changes other property");
+    XCTAssertEqual(patchedResponse.changedKeys.count, 0, @"patched properties are recorded as changes");
+    
+    [response resetChanges];
+    XCTAssertEqual(response.changedKeys.count, 0, @"reset changes failed");
+}
+
+- (void)testCardsSnapshot {
+    HKImmutableCard *card = [HKImmutableCard modelWithSerializedObject:self.JSON[@"cards"][0]];
+    XCTAssertEqual([card copy], card, @"copy of immutable model is not shared");
+    HKImmutableCard *renamedCard = [card copyWithChanges:^(HKImmutableCard *model) {
+        model.name = @"renamed";
+    }];
+    XCTAssertEqualObjects(renamedCard.name, @"renamed", @"change of copy failed");
+    XCTAssertEqualObjects(card.name, [self.JSON[@"cards"][0] objectForKey:@"name"], @"original model is changed");
+    XCTAssertEqual(renamedCard.number, card.number, @"unchanged value is not shared");
+    XCTAssertThrows(card.name = @"changed", @"change of shared immutable model is not asserted");
+    
+    HKCardResponse *response = [HKCardResponse modelWithSerializedObject:self.JSON];
+    HKCardResponse *nextResponse = [response copyWithChanges:^(HKCardResponse *model) {
+        model.header = [HKResponseHeader modelWithSerializedObject:self.JSON[@"header"]];
+    }];
+    XCTAssertEqual(nextResponse.cards, response.cards, @"unchanged array is not shared");
+    XCTAssertNotEqual(nextResponse.header, response.header, @"changed model is shared");
+}
+
 @end
@@ -0,0 +1,71 @@
+//
+//  HKEnumSwitchTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKEnumSwitchTest : XCTestCase
+
+@end
+
+@implementation HKEnumSwitchTest
+
+- (void)testSwitchBrand {
+    NSString *(^international)(void) = ^NSString *{ return @"international"; };
+    HKEnumSwitch<HKBrand *, NSString *> *regionSwitch = [HKEnumSwitch switchWithEnumClass:HKBrand.class cases:@{ HKBrand.Visa : international, HKBrand.Master : international, HKBrand.UnionPay : ^NSString *{ return @"china"; } } defaultHandler:^NSString *{ return @"other"; }];
+    XCTAssertEqualObjects([regionSwitch resultForEnum:HKBrand.Master], @"international", @"case of switch failed");
+    XCTAssertEqualObjects([regionSwitch resultForEnum:HKBrand.UnionPay], @"china", @"case of switch failed");
+    XCTAssertEqualObjects([regionSwitch resultForEnum:HKBrand.JCB], @"other", @"default of switch failed");
+    XCTAssertEqualObjects([regionSwitch resultForEnum:nil], @"other", @"nil of switch failed");
+    NSArray *missingEnums = @[HKBrand.Amex, HKBrand.JCB];
+    XCTAssertEqualObjects(regionSwitch.missingEnums, missingEnums, @"missing cases of switch failed");
+    XCTAssertEqual(HKBrand.JCB.ordinal, 3, @"ordinal of enum failed");
+}
+
+
+- (void)testSwitchMissingCases {
+    NSString *(^international)(void) = ^NSString *{ return @"international"; };
+    XCTAssertThrows([HKEnumSwitch switchWithEnumClass:HKBrand.class cases:@{ HKBrand.Visa : international, HKBrand.Master : international } defaultHandler:nil], @"missing cases without default should assert");
+    XCTAssertNoThrow([HKEnumSwitch switchWithEnumClass:HKBrand.class cases:@{ HKBrand.Visa : international } defaultHandler:^NSString *{ return @"other"; }], @"missing cases with default should pass");
+}
+
+- (void)testSwitchEnumCase {
+    NSString *region = nil;
+    switch (HKBrand.JCB.enumCase) {
+        case HKBrandCaseVisa:
+        case HKBrandCaseMaster:
+        case HKBrandCaseAmex:
+        case HKBrandCaseJCB:
+            region = @"international";
+            break;
+        case HKBrandCaseUnionPay:
+            region = @"china";
+            break;
+    }
+    XCTAssertEqualObjects(region, @"international", @"case of enum failed");
+    XCTAssertEqual(HKBrand.UnionPay.enumCase, HKBrandCaseUnionPay, @"case of enum failed");
+}
+
+@end
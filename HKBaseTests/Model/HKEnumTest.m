@@ -0,0 +1,62 @@
+//
+//  HKEnumTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKEnumTest : XCTestCase
+
+@end
+
+@implementation HKEnumTest
+
+- (void)testEnumLookup {
+    XCTAssertEqualObjects([HKBrand enumWithValue:40004], HKBrand.Amex, @"dense value lookup failed");
+    XCTAssertNil([HKBrand enumWithValue:40003], @"missing dense value failed");
+    XCTAssertNil([HKBrand enumWithValue:NSIntegerMin], @"out of range value failed");
+    XCTAssertEqualObjects([HKResultCode enumWithValue:404], HKResultCode.NotFound, @"sparse value lookup failed");
+    XCTAssertNil([HKResultCode enumWithValue:1], @"missing sparse value failed");
+    XCTAssertEqualObjects([HKBrand enumWithStringValue:@"American Express"], HKBrand.Amex, @"string value lookup failed");
+    XCTAssertEqualObjects([HKResultCode enumWithStringValue:@"Forbidden"], HKResultCode.Forbidden, @"key lookup failed");
+    XCTAssertNil([HKBrand enumWithStringValue:@"Amex"], @"missing string value failed");
+}
+
+- (void)testEnumCanonical {
+    XCTAssertTrue(HKBrand.Amex.copy == HKBrand.Amex, @"copy of enum is not canonical");
+    XCTAssertTrue([HKBrand enumWithValue:40002] == HKBrand.Master, @"enum of value is not canonical");
+    XCTAssertTrue(HKBrand.allEnums == HKBrand.allEnums, @"all enums are not materialized once");
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:HKBrand.JCB];
+    XCTAssertTrue([NSKeyedUnarchiver unarchiveObjectWithData:data] == HKBrand.JCB, @"decoded enum is not canonical");
+    
+    __block NSUInteger numberOfMismatches = 0;
+    dispatch_apply(64, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^(size_t iteration) {
+        if ([HKBrand enumWithStringValue:@"UnionPay"] != HKBrand.UnionPay) {
+            __sync_fetch_and_add(&numberOfMismatches, 1);
+        }
+    });
+    XCTAssertEqual(numberOfMismatches, 0, @"concurrent lookup failed");
+}
+
+@end
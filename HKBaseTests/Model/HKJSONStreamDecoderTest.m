@@ -0,0 +1,75 @@
+//
+//  HKJSONStreamDecoderTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKJSONStreamDecoderTest : XCTestCase
+
+@end
+
+@implementation HKJSONStreamDecoderTest
+
+- (void)testStreamCards {
+    HKCardResponse *response = [HKCardResponse modelWithSerializedObject:HKCardResponse.fixtureJSON];
+    NSMutableData *linesData = [NSMutableData data];
+    for (HKCard *card in response.cards) {
+        [linesData appendData:card.JSONData];
+        [linesData appendBytes:"\n" length:1];
+    }
+    NSMutableArray<HKCard *> *lineCards = [NSMutableArray array];
+    HKJSONStreamDecoder<HKCard *> *linesDecoder = [[HKJSONStreamDecoder alloc] initWithModelClass:HKCard.class format:HKJSONStreamFormatAutomatic batchCount:2 handler:^(NSArray<HKCard *> *models, BOOL *stop) {
+        XCTAssertTrue(models.count <= 2, @"batch is larger than batch count");
+        [lineCards addObjectsFromArray:models];
+    }];
+    NSError *error = nil;
+    XCTAssertTrue([linesDecoder decodeInputStream:[NSInputStream inputStreamWithData:linesData] error:&error], @"NDJSON stream decoding failed -> %@", error);
+    XCTAssertEqualObjects([lineCards valueForKey:@"serializedObject"], [response.cards valueForKey:@"serializedObject"], @"NDJSON stream models are different");
+    
+    // top level array in small chunks
+    NSData *arrayData = [NSJSONSerialization dataWithJSONObject:HKCardResponse.fixtureJSON[@"cards"] options:NSJSONWritingPrettyPrinted error:NULL];
+    HKJSONStreamDecoder<HKCard *> *arrayDecoder = [[HKJSONStreamDecoder alloc] initWithModelClass:HKCard.class format:HKJSONStreamFormatArray batchCount:3 handler:nil];
+    for (NSUInteger offset = 0; offset < arrayData.length; offset += 7) {
+        NSData *chunk = [arrayData subdataWithRange:NSMakeRange(offset, MIN(7, arrayData.length - offset))];
+        XCTAssertTrue([arrayDecoder appendData:chunk error:&error], @"array stream decoding failed -> %@", error);
+    }
+    XCTAssertTrue([arrayDecoder finishWithError:&error], @"array stream is not finished -> %@", error);
+    XCTAssertEqual(arrayDecoder.numberOfModels, response.cards.count, @"array stream count failed");
+    
+    HKJSONStreamDecoder<HKCard *> *enumeratorDecoder = [[HKJSONStreamDecoder alloc] initWithModelClass:HKCard.class format:HKJSONStreamFormatAutomatic batchCount:1 handler:nil];
+    NSUInteger numberOfBatches = 0;
+    for (NSArray<HKCard *> *batch in [enumeratorDecoder batchEnumeratorWithInputStream:[NSInputStream inputStreamWithData:arrayData]]) {
+        XCTAssertEqualObjects(batch.firstObject.serializedObject, response.cards[numberOfBatches].serializedObject, @"enumerated model is different at index(%zd)", numberOfBatches);
+        numberOfBatches++;
+    }
+    XCTAssertEqual(numberOfBatches, response.cards.count, @"batch enumerator count failed");
+    
+    HKJSONStreamDecoder<HKCard *> *truncatedDecoder = [[HKJSONStreamDecoder alloc] initWithModelClass:HKCard.class format:HKJSONStreamFormatArray batchCount:0 handler:^(NSArray<HKCard *> *models, BOOL *stop) {}];
+    [truncatedDecoder appendData:[arrayData subdataWithRange:NSMakeRange(0, arrayData.length - 2)] error:NULL];
+    XCTAssertFalse([truncatedDecoder finishWithError:&error], @"truncated array is finished");
+    XCTAssertEqual(error.code, HKJSONErrorUnexpectedEnd, @"truncated array error failed");
+}
+
+@end
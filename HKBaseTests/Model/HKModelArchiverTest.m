@@ -0,0 +1,108 @@
+//
+//  HKModelArchiverTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+// previous version of HKArchiveNewCard (extra and response are removed, note and level are added)
+@interface HKArchiveOldCard : HKModel
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, strong) NSDictionary *extra;
+@property (nonatomic, strong) HKCardResponse *response;
+@property (nonatomic) NSInteger number;
+@end
+
+@implementation HKArchiveOldCard
+@end
+
+@interface HKArchiveNewCard : HKModel
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic) NSInteger number;
+@property (nonatomic, copy) NSString *note;
+@property (nonatomic) NSInteger level;
+@end
+
+@implementation HKArchiveNewCard
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _note = @"default";
+        _level = 7;
+    }
+    return self;
+}
+
+@end
+
+@interface HKModelArchiverTest : XCTestCase
+
+@end
+
+@implementation HKModelArchiverTest
+
+- (void)testArchiveCards {
+    HKCardResponse *response = [HKCardResponse modelWithSerializedObject:HKCardResponse.fixtureJSON];
+    NSData *archivedData = response.archivedData;
+    XCTAssertTrue(archivedData.length < HKCardResponse.fixtureJSONData.length, @"archive is larger than JSON -> archive(%zd), JSON(%zd)", archivedData.length, HKCardResponse.fixtureJSONData.length);
+    
+    NSError *error = nil;
+    HKCardResponse *unarchivedResponse = [HKCardResponse modelWithArchivedData:archivedData error:&error];
+    XCTAssertNil(error, @"unarchive failed -> %@", error);
+    XCTAssertEqualObjects(unarchivedResponse.serializedObject, response.serializedObject, @"unarchived response is different from archived response");
+    
+    XCTAssertNil([HKCardResponse modelWithArchivedData:[archivedData subdataWithRange:NSMakeRange(0, archivedData.length / 2)] error:&error], @"truncated archive is unarchived");
+    XCTAssertEqual(error.code, HKModelArchiveErrorUnexpectedEnd, @"error of truncated archive -> %@", error);
+}
+
+- (void)testArchiveExtraField {
+    HKArchiveOldCard *oldCard = [[HKArchiveOldCard alloc] init];
+    oldCard.name = @"card";
+    oldCard.extra = @{ @"key" : @[@1, @"value"] };
+    oldCard.response = [HKCardResponse modelWithSerializedObject:HKCardResponse.fixtureJSON];
+    oldCard.number = 42;
+    
+    NSError *error = nil;
+    HKArchiveNewCard *newCard = [HKArchiveNewCard modelWithArchivedData:oldCard.archivedData error:&error];
+    XCTAssertNil(error, @"unarchive with extra field failed -> %@", error);
+    XCTAssertEqualObjects(newCard.name, @"card", @"known field before extra field failed");
+    XCTAssertEqual(newCard.number, 42, @"known field after extra field failed");
+}
+
+- (void)testArchiveMissingField {
+    HKArchiveOldCard *oldCard = [[HKArchiveOldCard alloc] init];
+    oldCard.name = @"card";
+    oldCard.number = 42;
+    
+    NSError *error = nil;
+    HKArchiveNewCard *newCard = [HKArchiveNewCard modelWithArchivedData:oldCard.archivedData error:&error];
+    XCTAssertNil(error, @"unarchive with missing field failed -> %@", error);
+    XCTAssertEqualObjects(newCard.name, @"card", @"known field failed");
+    XCTAssertEqual(newCard.number, 42, @"known field failed");
+    XCTAssertEqualObjects(newCard.note, @"default", @"missing field is not default");
+    XCTAssertEqual(newCard.level, 7, @"missing field is not default");
+}
+
+@end
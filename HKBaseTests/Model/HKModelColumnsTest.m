@@ -0,0 +1,49 @@
+//
+//  HKModelColumnsTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKModelColumnsTest : XCTestCase
+
+@end
+
+@implementation HKModelColumnsTest
+
+- (void)testColumnsOfCards {
+    HKCardResponse *response = [HKCardResponse modelWithSerializedObject:HKCardResponse.fixtureJSON];
+    HKModelColumns<HKCard *> *columns = [HKModelColumns columnsWithSerializedObject:HKCardResponse.fixtureJSON[@"cards"] modelClass:HKCard.class];
+    XCTAssertEqual(columns.count, response.cards.count, @"columns count failed");
+    XCTAssertEqual([columns[@"brand"] countOfObject:HKBrand.Master], 2, @"master card count of columns failed");
+    XCTAssertEqual(columns[@"brand"].type, HKModelColumnTypeCode, @"enum property is not stored as code");
+    [response.cards enumerateObjectsUsingBlock:^(HKCard *card, NSUInteger index, BOOL *stop) {
+        XCTAssertEqualObjects(columns[index].serializedObject, card.serializedObject, @"row model is different at index(%zd)", index);
+    }];
+    
+    HKModelColumns<HKCard *> *convertedColumns = [HKModelColumns columnsWithModels:response.cards modelClass:HKCard.class];
+    XCTAssertEqualObjects([convertedColumns[@"name"] indexesOfObject:response.cards.lastObject.name], [NSIndexSet indexSetWithIndex:response.cards.count - 1], @"string column scan failed");
+}
+
+@end
@@ -0,0 +1,67 @@
+//
+//  HKModelDecodeContextTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKInternedCard : HKCard
+@end
+
+@implementation HKInternedCard
+
++ (BOOL)isImmutable {
+    return YES;
+}
+
+@end
+
+@interface HKModelDecodeContextTest : XCTestCase
+
+@end
+
+@implementation HKModelDecodeContextTest
+
+- (void)testInternCards {
+    HKModelDecodeContext *context = [[HKModelDecodeContext alloc] init];
+    __block HKCardResponse *response = nil;
+    __block HKCardResponse *otherResponse = nil;
+    __block HKInternedCard *card = nil;
+    __block HKInternedCard *otherCard = nil;
+    [context performBlock:^{
+        response = [HKCardResponse modelWithSerializedObject:HKCardResponse.fixtureJSON];
+        otherResponse = [HKCardResponse modelWithJSONData:HKCardResponse.fixtureJSONData error:nil];
+        card = [HKInternedCard modelWithSerializedObject:HKCardResponse.fixtureJSON[@"cards"][0]];
+        otherCard = [HKInternedCard modelWithSerializedObject:[HKCardResponse.fixtureJSON[@"cards"][0] mutableCopy]];
+    }];
+    XCTAssertNil(HKModelDecodeContext.currentContext, @"context is not restored after block");
+    XCTAssertEqual(response.cards.firstObject.name, otherResponse.cards.firstObject.name, @"string is not interned");
+    XCTAssertEqual(card, otherCard, @"immutable model is not interned");
+    XCTAssertEqualObjects(card.serializedObject, response.cards.firstObject.serializedObject, @"interned model is different");
+    
+    [context removeAllObjects];
+    XCTAssertEqual(context.count, 0, @"remove interned values failed");
+}
+
+@end
@@ -0,0 +1,51 @@
+//
+//  HKModelDecodeSessionTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKModelDecodeSessionTest : XCTestCase
+
+@end
+
+@implementation HKModelDecodeSessionTest
+
+- (void)testDecodeCardsInSession {
+    // escaped string uses string buffer of reader
+    NSData *escapedData = [@"{\"name\":\"\\u0048yundai\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    HKModelDecodeSession *session = [[HKModelDecodeSession alloc] init];
+    __block HKCard *card = nil;
+    for (NSUInteger index = 0; index < 2; index++) {
+        [session performBlock:^{
+            XCTAssertEqual(HKModelDecodeSession.currentSession, session, @"current session failed");
+            card = [HKCard modelWithJSONData:escapedData error:NULL];
+        }];
+    }
+    XCTAssertEqualObjects(card.name, @"Hyundai", @"decoding in session failed");
+    XCTAssertEqual(session.numberOfBuffers, 1, @"string buffer is not returned to arena");
+    XCTAssertNil(HKModelDecodeSession.currentSession, @"session is not restored");
+}
+
+@end
@@ -0,0 +1,53 @@
+//
+//  HKModelPoolTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKModelPoolTest : XCTestCase
+
+@end
+
+@implementation HKModelPoolTest
+
+- (void)testPoolCards {
+    NSArray *serializedCards = HKCardResponse.fixtureJSON[@"cards"];
+    HKModelPool<HKCard *> *pool = [HKModelPool poolWithModelClass:HKCard.class capacity:serializedCards.count];
+    NSMutableArray<HKCard *> *cards = [NSMutableArray array];
+    for (id serializedCard in serializedCards) {
+        [cards addObject:[pool modelWithSerializedObject:serializedCard]];
+    }
+    NSArray<HKCard *> *decodedCards = [cards copy];
+    [pool recycleModels:cards];
+    [cards removeAllObjects];
+    XCTAssertEqual(pool.count, serializedCards.count, @"recycled models are not kept");
+    XCTAssertNil(decodedCards.firstObject.name, @"recycled model is not reset");
+    
+    HKCard *reusedCard = [pool modelWithSerializedObject:serializedCards.firstObject];
+    XCTAssertTrue([decodedCards indexOfObjectIdenticalTo:reusedCard] != NSNotFound, @"model is not reused");
+    XCTAssertEqualObjects(reusedCard.serializedObject, [HKCard modelWithSerializedObject:serializedCards.firstObject].serializedObject, @"reused model is different");
+}
+
+@end
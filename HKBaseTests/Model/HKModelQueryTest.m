@@ -0,0 +1,85 @@
+//
+//  HKModelQueryTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKQueryAccount : HKModel
+@property (nonatomic) unsigned long long identifier;
+@end
+
+@implementation HKQueryAccount
+@end
+
+@interface HKModelQueryTest : XCTestCase
+
+@end
+
+@implementation HKModelQueryTest
+
+- (void)testQueryCards {
+    HKCardResponse *response = [HKCardResponse modelWithSerializedObject:HKCardResponse.fixtureJSON];
+    NSArray<HKCard *> *cards = response.cards;
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"brand == %@", HKBrand.Master];
+    HKModelQuery<HKCard *> *query = [HKModelQuery queryWithPredicate:predicate modelClass:HKCard.class];
+    XCTAssertEqualObjects([query filteredArray:cards], [cards filteredArrayUsingPredicate:predicate], @"compiled query is different from predicate");
+    
+    HKModelIndex *brandIndex = [HKModelIndex indexWithModels:cards modelClass:HKCard.class key:@"brand" type:HKModelIndexTypeHash];
+    HKModelIndex *nameIndex = [HKModelIndex indexWithModels:cards modelClass:HKCard.class key:@"name" type:HKModelIndexTypeRange];
+    XCTAssertEqual([query filteredArray:cards usingIndexes:@[brandIndex]].count, 2, @"master card count with hash index failed");
+    
+    NSPredicate *rangePredicate = [NSPredicate predicateWithFormat:@"name >= %@ AND name < %@ AND brand != nil", @"H", @"T"];
+    HKModelQuery<HKCard *> *rangeQuery = [HKModelQuery queryWithPredicate:rangePredicate modelClass:HKCard.class];
+    XCTAssertEqualObjects([rangeQuery filteredArray:cards usingIndexes:@[brandIndex, nameIndex]], [cards filteredArrayUsingPredicate:rangePredicate], @"query with range index is different from predicate");
+}
+
+- (void)testQueryIndexMutatedArray {
+    HKCardResponse *response = [HKCardResponse modelWithSerializedObject:HKCardResponse.fixtureJSON];
+    NSMutableArray<HKCard *> *cards = [response.cards mutableCopy];
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"brand == %@", HKBrand.Master];
+    HKModelQuery<HKCard *> *query = [HKModelQuery queryWithPredicate:predicate modelClass:HKCard.class];
+    HKModelIndex *brandIndex = [HKModelIndex indexWithModels:cards modelClass:HKCard.class key:@"brand" type:HKModelIndexTypeHash];
+    
+    // same array and count, different models
+    [cards replaceObjectAtIndex:0 withObject:[HKCard modelWithSerializedObject:@{ @"name" : @"replaced", @"brand" : HKBrand.Master.serializedObject }]];
+    XCTAssertEqualObjects([query filteredArray:cards usingIndexes:@[brandIndex]], [cards filteredArrayUsingPredicate:predicate], @"index of mutated array is used");
+}
+
+- (void)testQueryUnsignedLongLong {
+    unsigned long long large = 18446744073709551000ULL;
+    HKQueryAccount *lowerAccount = [[HKQueryAccount alloc] init];
+    lowerAccount.identifier = large;
+    HKQueryAccount *upperAccount = [[HKQueryAccount alloc] init];
+    upperAccount.identifier = large + 1;
+    NSArray<HKQueryAccount *> *accounts = @[lowerAccount, upperAccount];
+    
+    // both identifiers are same in double
+    HKModelQuery<HKQueryAccount *> *query = [HKModelQuery queryWithPredicate:[NSPredicate predicateWithFormat:@"identifier == %@", @(large + 1)] modelClass:HKQueryAccount.class];
+    XCTAssertEqualObjects([query filteredArray:accounts], @[upperAccount], @"unsigned long long is compared as double");
+    HKModelQuery<HKQueryAccount *> *negativeQuery = [HKModelQuery queryWithPredicate:[NSPredicate predicateWithFormat:@"identifier > %@", @(-1)] modelClass:HKQueryAccount.class];
+    XCTAssertEqual([negativeQuery filteredArray:accounts].count, 2, @"negative constant of unsigned property failed");
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  HKModelStoreTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import <HKBase/HKBase.h>
+#import "HKCardResponse.h"
+
+@interface HKModelStoreTest : XCTestCase
+
+@end
+
+@implementation HKModelStoreTest
+
+- (void)testStoreCards {
+    HKCardResponse *response = [HKCardResponse modelWithSerializedObject:HKCardResponse.fixtureJSON];
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"HKCardTest.store"];
+    NSError *error = nil;
+    XCTAssertTrue([HKModelStore writeModels:response.cards toFile:path error:&error], @"store write failed -> %@", error);
+    
+    HKModelStore<HKCard *> *store = [HKModelStore storeWithContentsOfFile:path modelClass:HKCard.class error:&error];
+    XCTAssertNotNil(store, @"store open failed -> %@", error);
+    XCTAssertEqual(store.count, response.cards.count, @"store count failed");
+    [response.cards enumerateObjectsUsingBlock:^(HKCard *card, NSUInteger index, BOOL *stop) {
+        XCTAssertEqualObjects(store[index].serializedObject, card.serializedObject, @"stored card is different at index(%zd)", index);
+    }];
+    XCTAssertNil(store[store.count], @"store returns model out of bounds");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+@end
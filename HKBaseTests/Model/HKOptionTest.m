@@ -0,0 +1,59 @@
+//
+//  HKOptionTest.m
+//
+//  Copyright © 2018 Hansen Kim ( https://hansenkim.blogspot.com )
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the “Software”), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//  of the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies
+//  or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+//  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+//  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+//  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#import <XCTest/XCTest.h>
+#import "HKPlaceResponse.h"
+
+@interface HKOptionTest : XCTestCase
+
+@end
+
+@implementation HKOptionTest
+
+- (void)testOptionEquality {
+    HKDirection *northEast = [HKDirection.North orWithOption:HKDirection.East];
+    HKDirection *eastNorth = [HKDirection.East orWithOption:HKDirection.North];
+    XCTAssertEqualObjects(northEast, eastNorth, @"equal options failed");
+    XCTAssertEqual(northEast.hash, eastNorth.hash, @"hash of equal options failed");
+    XCTAssertNotEqualObjects(HKDirection.North, HKDirection.South, @"different options failed");
+    XCTAssertEqual([HKDirection.North compare:HKDirection.South], NSOrderedAscending, @"compare of options failed");
+    XCTAssertEqual([HKDirection.South compare:HKDirection.North], NSOrderedDescending, @"compare of options failed");
+    
+    NSSet *directions = [NSSet setWithObjects:northEast, HKDirection.North, nil];
+    XCTAssertTrue([directions containsObject:eastNorth], @"option as set member failed");
+    XCTAssertFalse([directions containsObject:HKDirection.East], @"missing option in set failed");
+    XCTAssertNotEqualObjects((id)[HKDirection.East andWithOption:HKDirection.West], (id)HKResultCode.Success, @"option is equal to enum of same value");
+}
+
+- (void)testOptionStaticRegistration {
+    NSArray<HKDirection *> *allOptions = HKDirection.allOptions;
+    XCTAssertEqual(allOptions.count, 4, @"options of static table failed");
+    XCTAssertEqual(HKDirection.North.value, 0x10, @"value of static table failed");
+    XCTAssertEqualObjects(HKDirection.South.stringValue, @"S", @"string value of static table failed");
+    XCTAssertEqualObjects(HKDirection.North, allOptions[2], @"class accessor failed");
+    XCTAssertEqual(HKDirection.North.East.value, 0x11, @"instance accessor failed");
+    XCTAssertEqualObjects([HKDirection optionWithStringValue:@"N"], HKDirection.North, @"option for string value failed");
+}
+
+@end
@@ -26,10 +26,43 @@
 #import <XCTest/XCTest.h>
 #import "HKPlaceResponse.h"
 
+@interface HKPlaceVisit : HKModel
+
+@property (nonatomic, strong) NSDate *date;
+@property (nonatomic) NSTimeInterval timestamp;
+@property (nonatomic) double duration;
+
+@end
+
+@implementation HKPlaceVisit
+
++ (NSSet<NSString *> *)timeIntervalDateKeys {
+    return [NSSet setWithObject:@"timestamp"];
+}
+
+@end
+
+@interface HKPlacePhoto : HKModel
+
+@property (nonatomic, copy) NSData *thumbnail;
+@property (nonatomic, copy) NSData *memo;
+
+@end
+
+@implementation HKPlacePhoto
+
++ (NSSet<NSString *> *)base64DataKeys {
+    return [NSSet setWithObject:@"thumbnail"];
+}
+
+@end
+
 @interface HKPlaceTest : XCTestCase
 
 @property (nonatomic, strong) NSDictionary *JSON;
 @property (nonatomic, strong) NSError *error;
+@property (nonatomic) HKDateFormat serializedDateFormat;
+@property (nonatomic, strong) NSTimeZone *serializedTimeZone;
 
 @end
 
@@ -45,9 +78,17 @@
     
     self.JSON = serializedObject;
     self.error = error;
+    
+    // date settings are global
+    self.serializedDateFormat = NSDate.serializedDateFormat;
+    self.serializedTimeZone = NSDate.serializedTimeZone;
+    NSDate.serializedDateFormat = HKDateFormatISO8601;
+    NSDate.serializedTimeZone = nil;
 }
 
 - (void)tearDown {
+    NSDate.serializedDateFormat = self.serializedDateFormat;
+    NSDate.serializedTimeZone = self.serializedTimeZone;
     self.JSON = nil;
     self.error = nil;
     [super tearDown];
@@ -65,4 +106,71 @@
     XCTAssertTrue(placesOfNorth.count == 2, @"filter places direction north count failed -> places count(%zd)", placesOfNorth.count);
 }
 
+- (void)testPlacesStringNumbers {
+    // 64-bit value is not representable in double
+    NSDictionary *serializedPlace = @{ @"name" : @"Far", @"direction" : @"N", @"distance" : @"18446744073709551615" };
+    HKPlace *place = [HKPlace modelWithSerializedObject:serializedPlace];
+    XCTAssertEqual(place.distance, (NSUInteger)ULONG_MAX, @"string number is not exact -> distance(%zu)", place.distance);
+    
+    NSData *JSONData = [@"{\"name\":\"Far\",\"distance\":\"9007199254740993\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    HKPlace *JSONPlace = [HKPlace modelWithJSONData:JSONData error:NULL];
+    XCTAssertEqual(JSONPlace.distance, (NSUInteger)9007199254740993ULL, @"string number of JSON is not exact -> distance(%zu)", JSONPlace.distance);
+    
+    XCTAssertEqual([NSNumber modelWithSerializedObject:@"9007199254740993"].longLongValue, 9007199254740993LL, @"number of string is converted to double");
+    XCTAssertEqual([NSNumber modelWithSerializedObject:@"0.1"].doubleValue, 0.1, @"real number of string failed");
+    XCTAssertEqual(@"12345678901234567890".unsignedLongLongValue, 12345678901234567890ULL, @"unsigned long long value of string failed");
+    XCTAssertEqual(@"017".unsignedLongLongValue, 15ULL, @"octal unsigned long long value of string failed");
+    XCTAssertEqual(@"0x1F".unsignedLongLongValue, 31ULL, @"hexadecimal unsigned long long value of string failed");
+}
+
+- (void)testPlaceVisitDates {
+    NSTimeInterval timeInterval = 1535027696.789;
+    HKPlaceVisit *visit = [HKPlaceVisit modelWithSerializedObject:@{ @"date" : @"2018-08-23T21:34:56.789+09:00", @"timestamp" : @"2018-08-23T12:34:56.789Z" }];
+    XCTAssertEqualWithAccuracy(visit.date.timeIntervalSince1970, timeInterval, 0.0001, @"ISO 8601 date failed");
+    XCTAssertEqualWithAccuracy(visit.timestamp, timeInterval, 0.0001, @"ISO 8601 time interval failed");
+    XCTAssertEqualObjects(visit.serializedObject[@"date"], @"2018-08-23T12:34:56.789Z", @"ISO 8601 serialization failed");
+    
+    NSData *JSONData = [@"{\"date\":1535027696,\"timestamp\":\"20180823T123456Z\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    HKPlaceVisit *JSONVisit = [HKPlaceVisit modelWithJSONData:JSONData error:NULL];
+    XCTAssertEqual(JSONVisit.date.timeIntervalSince1970, 1535027696.0, @"epoch date of JSON failed");
+    XCTAssertEqual(JSONVisit.timestamp, 1535027696.0, @"ISO 8601 time interval of JSON failed");
+    XCTAssertEqualObjects([HKPlaceVisit modelWithJSONData:JSONVisit.JSONData error:NULL].date, JSONVisit.date, @"date JSON round trip failed");
+    
+    NSData *numberJSONData = [@"{\"timestamp\":\"20180823\",\"duration\":\"2018-08-23\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    HKPlaceVisit *numberVisit = [HKPlaceVisit modelWithJSONData:numberJSONData error:NULL];
+    XCTAssertEqual(numberVisit.timestamp, 20180823.0, @"number string of time interval is parsed as date");
+    XCTAssertEqual(numberVisit.duration, 2018.0, @"date string of double without timeIntervalDateKeys is parsed as date");
+    XCTAssertEqual([HKPlaceVisit modelWithSerializedObject:@{ @"duration" : @"20180823" }].duration, 20180823.0, @"number string of double failed");
+    
+    NSData *invalidJSONData = [@"{\"date\":\"12abc\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertNil([HKPlaceVisit modelWithJSONData:invalidJSONData error:NULL].date, @"partial number string of JSON is parsed as date");
+    XCTAssertNil([HKPlaceVisit modelWithSerializedObject:@{ @"date" : @"12abc" }].date, @"partial number string is parsed as date");
+    XCTAssertEqual([HKPlaceVisit modelWithSerializedObject:@{ @"date" : @"1535027696" }].date.timeIntervalSince1970, 1535027696.0, @"epoch string failed");
+    
+    NSDate.serializedTimeZone = [NSTimeZone timeZoneForSecondsFromGMT:9 * 3600];
+    XCTAssertEqualObjects(JSONVisit.date.serializedObject, @"2018-08-23T21:34:56+09:00", @"ISO 8601 with time zone failed");
+    NSDate.serializedTimeZone = nil;
+    NSDate.serializedDateFormat = HKDateFormatEpochMilliseconds;
+    XCTAssertEqualObjects(JSONVisit.date.serializedObject, @1535027696000LL, @"epoch milliseconds failed");
+}
+
+- (void)testPlacePhotoBase64 {
+    HKPlacePhoto *photo = [HKPlacePhoto modelWithSerializedObject:@{ @"thumbnail" : @"SGVsbG8sIFdvcmxkIQ==", @"memo" : @"memo" }];
+    XCTAssertEqualObjects(photo.thumbnail, [@"Hello, World!" dataUsingEncoding:NSUTF8StringEncoding], @"Base64 decoding failed");
+    XCTAssertEqualObjects(photo.memo, [@"memo" dataUsingEncoding:NSUTF8StringEncoding], @"UTF-8 data failed");
+    XCTAssertEqualObjects(photo.serializedObject[@"thumbnail"], @"SGVsbG8sIFdvcmxkIQ==", @"Base64 encoding failed");
+    XCTAssertNil([HKPlacePhoto modelWithSerializedObject:@{ @"thumbnail" : @"SGVs*G8=" }].thumbnail, @"invalid Base64 failed");
+    
+    NSMutableData *data = [NSMutableData dataWithLength:3 * 1024 * 1024 + 1];
+    arc4random_buf(data.mutableBytes, data.length);
+    NSString *base64 = [data base64EncodedStringWithOptions:(NSDataBase64EncodingOptions)0];
+    XCTAssertEqualObjects(HKModelBase64StringWithData(data), base64, @"large Base64 encoding failed");
+    XCTAssertEqualObjects(HKModelBase64DataWithString([data base64EncodedStringWithOptions:NSDataBase64Encoding76CharacterLineLength]), data, @"Base64 with line breaks failed");
+    
+    photo.thumbnail = data;
+    HKPlacePhoto *JSONPhoto = [HKPlacePhoto modelWithJSONData:photo.JSONData error:NULL];
+    XCTAssertEqualObjects(JSONPhoto.thumbnail, data, @"Base64 JSON round trip failed");
+    XCTAssertEqualObjects(JSONPhoto.memo, photo.memo, @"UTF-8 JSON round trip failed");
+}
+
 @end